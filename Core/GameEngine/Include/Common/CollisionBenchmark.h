@@ -0,0 +1,57 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+class Object;
+class ThingTemplate;
+
+// TheSuperHackers @feature Offline stress benchmark of the collision detection of the partition manager.
+//
+// Loads a map headless and packs -collisionBenchUnits neutral infantry units into a blob in the middle of the
+// map, so that their bounding circles overlap heavily. For -collisionBenchFrames frames every unit takes a
+// small random step inside the blob and PartitionManager::update is timed. Reports the latency distribution of
+// the updates and the pairs of units that were tested for and found in a collision per frame. Then times the
+// closest object query of every unit one by one against one batched query, and fails if their results differ.
+class CollisionBenchmark
+{
+public:
+
+	// Runs the benchmark on the map and returns the exit code of the process.
+	static int run(const AsciiString& mapName);
+
+private:
+
+	typedef std::vector<Object*> UnitList;
+
+	CollisionBenchmark();
+
+	static const ThingTemplate* findUnitTemplate();
+	void createUnits(const ThingTemplate* tmpl, Int count, UnitList& units);
+	void moveUnits(const UnitList& units);
+	Int compareClosestQueries(const UnitList& units, Int numFrames, UnsignedInt64& sequentialTicks, UnsignedInt64& batchTicks);
+	void getRandomPositionInBlob(Coord3D& pos);
+
+	Real getRandomReal(Real lo, Real hi);
+
+	UnsignedInt m_random;							///< xorshift state of the unit positions
+	UnsignedInt64 m_ticksPerSecond;
+	Coord3D m_blobCenter;
+	Real m_blobRadius;
+	Real m_stepRadius;								///< the most a unit moves per frame
+};
@@ -45,6 +45,36 @@
 #define RETAIL_COMPATIBLE_PATHFINDING_ALLOCATION (1)
 #endif
 
+// This is here to easily toggle between the retail pathfind queue and the prioritized queue, see Pathfinder::processPathfindQueue.
+// The prioritized queue computes the paths of player commands first, which is not CRC compatible.
+#ifndef RETAIL_COMPATIBLE_PATHFIND_QUEUE
+#define RETAIL_COMPATIBLE_PATHFIND_QUEUE (RETAIL_COMPATIBLE_CRC)
+#endif
+
+// This is here to easily toggle between one hierarchical path per path request and hierarchical paths shared by requests to the same area,
+// see Pathfinder::findPath. Units that join the corridor of another unit can take a different path, which is not CRC compatible.
+#ifndef RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+#define RETAIL_COMPATIBLE_PATHFIND_CORRIDORS (RETAIL_COMPATIBLE_CRC)
+#endif
+
+// This is here to easily toggle between recalculating the pathfind zones of the whole map and of the changed zone blocks only,
+// see PathfindZoneManager::calculateDirtyZones. The changed blocks are numbered differently, which is not CRC compatible.
+#ifndef RETAIL_COMPATIBLE_PATHFIND_ZONES
+#define RETAIL_COMPATIBLE_PATHFIND_ZONES (RETAIL_COMPATIBLE_CRC)
+#endif
+
+// This is here to easily toggle between a path search per unit and flow fields shared by large groups moving to the same area,
+// see Pathfinder::getFlowField. The flow fields are enabled with FlowFieldMinGroupSize in AIData.ini and are not CRC compatible.
+#ifndef RETAIL_COMPATIBLE_FLOW_FIELDS
+#define RETAIL_COMPATIBLE_FLOW_FIELDS (RETAIL_COMPATIBLE_CRC)
+#endif
+
+// This is here to easily toggle between testing every pair of objects in a partition cell and skipping the pairs whose bounding circles
+// are apart, see PartitionContactList::processContactList. The skipped pairs are tested again once a collision moves anything, so this is CRC compatible.
+#ifndef RETAIL_COMPATIBLE_COLLISION_BROADPHASE
+#define RETAIL_COMPATIBLE_COLLISION_BROADPHASE (0)
+#endif
+
 // This is essentially synonymous for RETAIL_COMPATIBLE_CRC. There is a lot wrong with AIGroup, such as use-after-free, double-free, leaks,
 // but we cannot touch it much without breaking retail compatibility. Do not shy away from using massive hacks when fixing issues with AIGroup,
 // but put them behind this macro.
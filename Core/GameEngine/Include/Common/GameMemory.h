@@ -302,10 +302,15 @@ private:
 	Int								m_overflowAllocationCount;	///< number of blocks to be allocated in any subsequent blob(s)
 	Int								m_usedBlocksInPool;					///< total number of blocks in use in the pool.
 	Int								m_totalBlocksInPool;				///< total number of blocks in all blobs of this pool (used or not).
-	Int								m_peakUsedBlocksInPool;			///< high-water mark of m_usedBlocksInPool
+	Int								m_liveBlocksInPool;					///< number of blocks handed out, without the free blocks in the thread caches
+	Int								m_peakUsedBlocksInPool;			///< high-water mark of m_liveBlocksInPool
+	Int								m_sessionPeakUsedBlocks;		///< high-water mark of m_liveBlocksInPool that neither reset() nor resetPeakBlockCount() restart
+	Int								m_overflowBlobCount;				///< number of overflow blobs created since the pool was created
 	MemoryPoolBlob		*m_firstBlob;								///< head of linked list: first blob for this pool.
 	MemoryPoolBlob		*m_lastBlob;								///< tail of linked list: last blob for this pool. (needed for efficiency)
 	MemoryPoolBlob		*m_firstBlobWithFreeBlocks;	///< first blob in this pool that has at least one unallocated block.
+	Int								m_threadCacheIndex;					///< slot of this pool in the thread caches, or -1 if its blocks are not cached
+	Int								m_threadCacheSize;					///< max number of free blocks a thread cache keeps for this pool
 
 private:
 	/// create a new blob with the given number of blocks.
@@ -314,12 +319,25 @@ private:
 	/// destroy a blob.
 	Int freeBlob(MemoryPoolBlob *blob);
 
+	/// take a free block from the blobs. the caller must hold TheMemoryPoolCriticalSection.
+	MemoryPoolSingleBlock *allocateSingleBlockFromBlobs(DECLARE_LITERALSTRING_ARG1);
+
 public:
 
 	// 'public' funcs that are really only for use by MemoryPoolFactory
 	MemoryPool *getNextPoolInList();					///< return next pool in linked list
 	void addToList(MemoryPool **pHead);				///< add this pool to head of the linked list
 	void removeFromList(MemoryPool **pHead);	///< remove this pool from the linked list
+	void accumulateSessionUsage(Int peakBlockCount, Int overflowBlobCount);	///< merge the usage recorded by an earlier session
+
+	// 'public' funcs that are really only for use by the thread caches. the caller must hold TheMemoryPoolCriticalSection
+	// for all but the getters.
+	Int getThreadCacheIndex();		///< return the slot of this pool in the thread caches, or -1 if its blocks are not cached
+	Int getThreadCacheSize();			///< return the max number of free blocks a thread cache keeps for this pool
+	void fillThreadCache(MemoryPoolSingleBlock *&firstBlock, Int &count, Int maxCount);		///< move free blocks from the blobs to the head of the list
+	void drainThreadCache(MemoryPoolSingleBlock *&firstBlock, Int &count, Int drainCount);	///< move blocks from the head of the list back to their blobs
+	void freeSingleBlockToBlobs(MemoryPoolSingleBlock *block);
+
 	#ifdef MEMORYPOOL_DEBUG
 		static void debugPoolInfoReport( MemoryPool *pool, FILE *fp = nullptr );	///< dump a report about this pool to the logfile
 		const char *debugGetBlockTagString(void *pBlock);		///< return the tagstring for the given block (assumed to belong to this pool)
@@ -360,18 +378,30 @@ public:
 	/// return the number of free (available) blocks in this pool.
 	Int getFreeBlockCount();
 
-	/// return the number of blocks in use in this pool.
+	/// return the number of blocks in use in this pool. free blocks in the thread caches count as used.
 	Int getUsedBlockCount();
 
 	/// return the total number of blocks in this pool. [ == getFreeBlockCount() + getUsedBlockCount() ]
 	Int getTotalBlockCount();
 
-	/// return the high-water mark for getUsedBlockCount()
+	/// return the high-water mark for the number of blocks handed out. free blocks in the thread caches don't count.
 	Int getPeakBlockCount();
 
+	/// restart the high-water mark at the current number of blocks handed out
+	void resetPeakBlockCount();
+
 	/// return the initial allocation count for this pool
 	Int getInitialBlockCount();
 
+	/// return the overflow allocation count for this pool. 0 if the pool may not grow.
+	Int getOverflowBlockCount();
+
+	/// return the high-water mark for the number of blocks handed out since the pool was created
+	Int getSessionPeakBlockCount();
+
+	/// return the number of overflow blobs created since the pool was created
+	Int getOverflowBlobCount();
+
 	Int countBlobsInPool();
 
 	/// if this pool has any empty blobs, return them to the system.
@@ -547,6 +577,20 @@ public:
 
 	void memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead = nullptr );
 
+	/// return the sum of the high-water marks of all pools in bytes. this includes the subpools of all dmas.
+	Int getPeakPoolBytes();
+
+	/// restart the high-water marks of all pools at their current usage.
+	void resetPeakPoolBytes();
+
+	/**
+		write the initial pool sizes that the usage of this session suggests to the given file,
+		in the format of MemoryPools.ini. the usage recorded in an existing file is merged in,
+		so that the file covers several sessions or replay batches. call this once, at the end
+		of the session. return false on failure.
+	*/
+	Bool writePoolSizes(const char *filename);
+
 	#ifdef MEMORYPOOL_DEBUG
 
 		/// perform internal consistency checking
@@ -780,7 +824,13 @@ inline Int MemoryPool::getFreeBlockCount() { return getTotalBlockCount() - getUs
 inline Int MemoryPool::getUsedBlockCount() { return m_usedBlocksInPool; }
 inline Int MemoryPool::getTotalBlockCount() { return m_totalBlocksInPool; }
 inline Int MemoryPool::getPeakBlockCount() { return m_peakUsedBlocksInPool; }
+inline void MemoryPool::resetPeakBlockCount() { m_peakUsedBlocksInPool = m_liveBlocksInPool; }
 inline Int MemoryPool::getInitialBlockCount() { return m_initialAllocationCount; }
+inline Int MemoryPool::getOverflowBlockCount() { return m_overflowAllocationCount; }
+inline Int MemoryPool::getSessionPeakBlockCount() { return m_sessionPeakUsedBlocks; }
+inline Int MemoryPool::getOverflowBlobCount() { return m_overflowBlobCount; }
+inline Int MemoryPool::getThreadCacheIndex() { return m_threadCacheIndex; }
+inline Int MemoryPool::getThreadCacheSize() { return m_threadCacheSize; }
 
 // ----------------------------------------------------------------------------
 inline DynamicMemoryAllocator *DynamicMemoryAllocator::getNextDmaInList() { return m_nextDmaInFactory; }
@@ -66,6 +66,10 @@ public:
 
 	void memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead = nullptr );
 
+	Int getPeakPoolBytes() { return 0; }
+	void resetPeakPoolBytes() {}
+	Bool writePoolSizes(const char *filename) { return FALSE; }
+
 #ifdef MEMORYPOOL_DEBUG
 
 	void debugMemoryReport(Int flags, Int startCheckpoint, Int endCheckpoint, FILE *fp = nullptr );
@@ -0,0 +1,105 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+class Object;
+class Path;
+
+// TheSuperHackers @feature Offline benchmark of the pathfinder.
+//
+// Loads a map headless, times Pathfinder::classifyMap and runs a seeded set of findPath, findClosestPath,
+// findAttackPath and isLinePassable queries for one unit of every locomotor type. Every locomotor type and
+// query reports its latency distribution, the pathfind cells it examined and a checksum of the resulting
+// paths. With -pathfindBenchResults the results are written to a CSV file, and with -pathfindBenchBaseline
+// they are compared against such a file of an earlier run. The comparison fails if a query finds other paths,
+// or if its mean latency regressed by more than -replayBenchTolerance percent.
+class PathfindBenchmark
+{
+public:
+
+	enum QueryType
+	{
+		QUERY_FIND_PATH,
+		QUERY_FIND_CLOSEST_PATH,
+		QUERY_FIND_ATTACK_PATH,
+		QUERY_IS_LINE_PASSABLE,
+
+		QUERY_COUNT
+	};
+
+	struct Result
+	{
+		Result();
+
+		AsciiString unitName;			///< thing template of the unit that ran the queries
+		Int surfaces;							///< LocomotorSurfaceTypeMask of the unit
+		Int query;								///< QueryType
+		UnsignedInt queries;
+		UnsignedInt found;				///< queries that returned a path, or a passable line
+		Real meanMicros;
+		Real p50Micros;
+		Real p90Micros;
+		Real p99Micros;
+		Real maxMicros;
+		UnsignedInt meanCells;		///< pathfind cells examined per query
+		UnsignedInt maxCells;
+		UnsignedInt checksum;			///< checksum of the resulting paths
+	};
+	typedef std::vector<Result> ResultList;
+
+	// Runs the benchmark on the map and returns the exit code of the process.
+	static int run(const AsciiString& mapName);
+
+	static void printResults(const ResultList& results);
+	static Bool writeResults(const AsciiString& filename, const ResultList& results);
+	static Bool readResults(const AsciiString& filename, ResultList& results);
+
+	// Prints the results next to the baseline. Returns false if any query found other paths or regressed by more than the tolerance.
+	static Bool compareWithBaseline(const ResultList& results, const ResultList& baseline, Real tolerancePercent);
+
+	// Starts a single player game on the map, like -file does. Also used by the other offline benchmarks.
+	static Bool loadMap(const AsciiString& mapName);
+
+private:
+
+	struct Unit
+	{
+		Object* obj;
+		Int surfaces;
+		Bool isCrusher;
+		Int radius;								///< path radius in cells
+	};
+	typedef std::vector<Unit> UnitList;
+
+	PathfindBenchmark(UnsignedInt seed);
+
+	void createUnits(UnitList& units);
+	void runQueries(const Unit& unit, ResultList& results);
+
+	UnsignedInt getRandomValue(UnsignedInt count);
+	void getRandomPosition(Coord3D& pos, const Unit* validFor);
+	static void addToChecksum(UnsignedInt& checksum, Int value);
+	static void addPathToChecksum(UnsignedInt& checksum, Path* path);
+	void finishResult(Result& result, std::vector<UnsignedInt64>& ticks, UnsignedInt64 totalCells) const;
+
+	static const Result* findResult(const ResultList& results, const Result& result);
+
+	UnsignedInt m_random;							///< xorshift state of the query positions
+	UnsignedInt64 m_ticksPerSecond;
+};
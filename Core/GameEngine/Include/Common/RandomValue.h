@@ -36,4 +36,12 @@ extern void InitGameLogicRandom( UnsignedInt seed ); ///< Set the GameLogic seed
 extern UnsignedInt GetGameLogicRandomSeed( void );   ///< Get the seed (used for replays)
 extern UnsignedInt GetGameLogicRandomSeedCRC( void );///< Get the seed (used for CRCs)
 
+struct GameLogicRandomState
+{
+	UnsignedInt seed[6];
+	UnsignedInt baseSeed;
+};
+extern void GetGameLogicRandomState( GameLogicRandomState *state );       ///< Get the full logic random state (used for replay checkpoints)
+extern void SetGameLogicRandomState( const GameLogicRandomState *state ); ///< Set the full logic random state (used for replay checkpoints)
+
 //--------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,73 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// TheSuperHackers @feature Performance results of simulated replays.
+//
+// Every simulated replay prints one result line with its logic frames per second, the mean and 99th percentile
+// time of GameLogic::UPDATE, the peak memory pool usage and the final logic CRC. Worker processes print the same
+// line, so the results of -jobs are complete as well. With -replayBench the results of all replays are written
+// to a CSV file, and with -replayBenchBaseline they are compared against such a file of an earlier run. The
+// comparison fails if a replay ends with another CRC, runs slower or uses more memory than the tolerance allows.
+class ReplayBenchmark
+{
+public:
+
+	struct Result
+	{
+		Result();
+		Real getFramesPerSecond() const;
+
+		AsciiString filename;
+		UnsignedInt frames;
+		UnsignedInt wallMillis;
+		Real meanUpdateMicros;		///< mean time of GameLogic::UPDATE
+		Real p99UpdateMicros;			///< 99th percentile time of GameLogic::UPDATE
+		UnsignedInt peakPoolKB;		///< sum of the high-water marks of all memory pools
+		UnsignedInt crc;					///< logic CRC after the last frame
+		UnsignedInt exitCode;
+	};
+	typedef std::vector<Result> ResultList;
+
+	ReplayBenchmark();
+
+	// Measures a replay that is simulated in this process.
+	void beginReplay();
+	void beginUpdate();
+	void endUpdate();
+	void endReplay(Result& result) const;
+
+	static void printResult(const Result& result);
+	static Bool parseResult(const AsciiString& output, Result& result);
+	static void printSummary(const ResultList& results);
+
+	static Bool writeResults(const AsciiString& filename, const ResultList& results);
+	static Bool readResults(const AsciiString& filename, ResultList& results);
+
+	// Prints the results next to the baseline. Returns false if any replay regressed by more than the tolerance.
+	static Bool compareWithBaseline(const ResultList& results, const ResultList& baseline, Real tolerancePercent);
+
+private:
+
+	static const Result* findResult(const ResultList& results, const AsciiString& filename);
+
+	std::vector<UnsignedInt64> m_updateTicks;	///< duration of every GameLogic::UPDATE
+	UnsignedInt64 m_updateStartTicks;
+	UnsignedInt64 m_ticksPerSecond;
+};
@@ -0,0 +1,78 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// TheSuperHackers @feature Narrows down a replay CRC mismatch to the first diverging object and module.
+//
+// When a simulated replay mismatches, the replay is rewound to the last in-memory checkpoint before the last
+// matching CRC and simulated again frame by frame. The report lists the logic CRC of every frame between the
+// last matching and the mismatching CRC, followed by the CRCs of every save game block, object and module on
+// the last frame. A CRC of the replay is only recorded every few frames, so the report of a single build
+// cannot tell which frame diverged first. Simulating the same replay with another build and the report as
+// reference finds the first diverging frame. The reference run writes its own report that ends on that frame.
+// Running the first build again with that report as reference names the first diverging object and module.
+class ReplayCRCReport
+{
+public:
+
+	struct Entry
+	{
+		Int depth;
+		UnsignedInt crc;
+		UnsignedInt size;
+		AsciiString path;			///< labels of the enclosing snapshots separated by " / "
+	};
+	typedef std::vector<Entry> EntryList;
+
+	ReplayCRCReport();
+
+	// Rewinds the replay that just mismatched and writes the report for the frames before the mismatch. Starts the
+	// replay over when the checkpoint run does not match the replay's CRCs. Returns false if the replay could not
+	// be simulated again up to the mismatch.
+	static Bool writeForMismatch(const AsciiString& replayFilename, UnsignedInt mismatchFrame, const AsciiString& reportFilename);
+
+	// Simulates the replay that was just started over the frames of the reference report, writes its own
+	// report and prints the first difference. Returns false if a difference was found or the reference is invalid.
+	static Bool writeForReference(const AsciiString& replayFilename, const AsciiString& referenceFilename, const AsciiString& reportFilename);
+
+private:
+
+	Bool simulateFrames(UnsignedInt lastFrame, const ReplayCRCReport* reference);
+	void collectDetails();
+
+	Bool write(const AsciiString& filename) const;
+	Bool read(const AsciiString& filename);
+
+	Bool hasFrameCRC(UnsignedInt frame) const;
+	UnsignedInt getFrameCRC(UnsignedInt frame) const;
+	const Entry* findEntry(const AsciiString& path) const;
+
+	static Bool isObjectEntry(const Entry& entry);
+	static Bool divergesFrom(const Entry& entry, const ReplayCRCReport& reference, UnsignedInt* referenceCRC);
+
+	void printFirstDifference(const ReplayCRCReport& reference) const;
+
+private:
+
+	AsciiString m_replayFilename;
+	UnsignedInt m_firstFrame;
+	std::vector<UnsignedInt> m_frameCRCs;	///< logic CRC of every frame starting with m_firstFrame
+	UnsignedInt m_detailFrame;
+	EntryList m_entries;									///< CRCs of blocks, objects and modules on m_detailFrame
+};
@@ -0,0 +1,126 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// TheSuperHackers @performance Reads replay files from a read-only memory mapping.
+//
+// The replay file is mapped once and every field is decoded straight from the mapped bytes, instead of
+// reading each field of each command with a separate call into the file system. Windows maps the file
+// with CreateFileMapping, other platforms with mmap. Files that cannot be mapped, for example empty files
+// or files in archives, are read into memory in one go instead.
+class ReplayFileReader
+{
+public:
+
+	ReplayFileReader();
+	~ReplayFileReader();
+
+	Bool open(const AsciiString& filepath);
+	void close();
+	Bool isOpen() const { return m_data != nullptr; }
+
+	Int size() const { return m_size; }
+	Int position() const { return m_position; }
+	Bool isEnd() const { return m_position >= m_size; }
+	Bool seek(Int position);		///< Returns false and keeps the position if position is not within the file.
+	Bool skip(Int bytes);
+
+	// Reads all bytes or none. Returns false if the file ends before.
+	Bool read(void* buffer, Int bytes);
+	template <typename Type> Bool read(Type& value) { return read(&value, sizeof(Type)); }
+
+	AsciiString readAsciiString();			///< Reads a 0-terminated string. Longer strings than the recorder writes are cut.
+	UnicodeString readUnicodeString();	///< Reads a 0-terminated string. Longer strings than the recorder writes are cut.
+
+	UnsignedInt computeCRC(Int offset, Int bytes) const;
+
+private:
+
+	ReplayFileReader(const ReplayFileReader&);
+	ReplayFileReader& operator=(const ReplayFileReader&);
+
+	const UnsignedByte* m_data;
+	Int m_size;
+	Int m_position;
+#ifdef _WIN32
+	HANDLE m_fileHandle;
+	HANDLE m_mappingHandle;
+#else
+	Bool m_isMapped;
+#endif
+	char* m_fileData;						///< owns the data if the file is not mapped
+};
+
+// TheSuperHackers @performance Index of the commands in a replay file.
+//
+// The index lists the frame, type, player and byte offset of every command in the order of the file, so
+// analysis, command statistics and seeking can jump directly to a frame without decoding the commands
+// before it. Building the index only decodes the command headers and skips the arguments by their size.
+// The index can be stored next to the replay in a sidecar file, which is ignored once the replay changes.
+class ReplayFrameIndex
+{
+public:
+
+	struct Command
+	{
+		UnsignedInt frame;
+		Int offset;						///< of the frame number that starts the command
+		Int type;							///< GameMessage::Type
+		Int playerIndex;
+	};
+	typedef std::vector<Command> CommandList;
+
+	struct CommandStats
+	{
+		Int type;
+		UnsignedInt count;
+		UnsignedInt firstFrame;
+		UnsignedInt lastFrame;
+	};
+	typedef std::vector<CommandStats> CommandStatsList;
+
+	ReplayFrameIndex();
+
+	// Indexes the commands from commandsOffset to the end of the file. Returns false if the file is truncated
+	// or corrupt, but keeps the commands that were indexed up to there.
+	Bool build(ReplayFileReader& reader, Int commandsOffset);
+	void clear();
+
+	Bool isValid() const { return m_commandsOffset != 0; }
+	Int getCommandsOffset() const { return m_commandsOffset; }
+	const CommandList& getCommands() const { return m_commands; }
+
+	// Returns the offset of the first command on or after frame, or the end of the file if there is none.
+	Int getOffsetForFrame(UnsignedInt frame) const;
+	UnsignedInt getLastCommandFrame() const;
+
+	void getCommandStats(CommandStatsList& stats) const;		///< sorted by command type
+
+	static AsciiString getSidecarFilename(const AsciiString& replayFilepath);
+	Bool writeSidecar(const AsciiString& filename) const;
+	// Returns false if the sidecar is missing or does not belong to the contents of the replay.
+	Bool readSidecar(const AsciiString& filename, const ReplayFileReader& reader, Int commandsOffset);
+
+private:
+
+	CommandList m_commands;
+	Int m_commandsOffset;
+	Int m_fileSize;
+	UnsignedInt m_headerCRC;			///< of the replay header, to detect a sidecar of another replay
+};
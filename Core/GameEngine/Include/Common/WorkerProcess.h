@@ -18,6 +18,10 @@
 
 #pragma once
 
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+
 // Helper class that allows you to start a worker process and retrieve its exit code
 // and console output as a string.
 // It also makes sure that the started process is killed in case our process exits in any way.
@@ -26,7 +30,8 @@ class WorkerProcess
 public:
 	WorkerProcess();
 
-	bool startProcess(UnicodeString command);
+	// The first argument is the path of the executable.
+	bool startProcess(const std::vector<UnicodeString>& args);
 
 	void update();
 
@@ -35,22 +40,32 @@ public:
 	// returns true iff the process exited.
 	bool isDone() const;
 
-	DWORD getExitCode() const;
+	UnsignedInt getExitCode() const;
 	AsciiString getStdOutput() const;
 
 	// Terminate Process if it's running
 	void kill();
 
+	// TheSuperHackers @performance Blocks until any of the running processes has new output
+	// or exited, or until the timeout elapsed. On Windows this falls back to a plain sleep.
+	static void waitForActivity(const std::vector<WorkerProcess>& processes, UnsignedInt timeoutMillis);
+
 private:
 	// returns true if all output has been received
 	// returns false if the worker is still running
 	bool fetchStdOutput();
 
 private:
+#ifdef _WIN32
 	HANDLE m_processHandle;
 	HANDLE m_readHandle;
 	HANDLE m_jobHandle;
+#else
+	// TheSuperHackers @feature POSIX backend using fork/exec and a non-blocking pipe.
+	pid_t m_processId;
+	int m_readFd;
+#endif
 	AsciiString m_stdOutput;
-	DWORD m_exitcode;
+	UnsignedInt m_exitcode;
 	bool m_isDone;
 };
@@ -31,10 +31,13 @@
 // TheSuperHackers @info helmutbuhler 04/09/2025
 //         The baseclass Xfer has 3 implementations:
 //          - XferLoad: Load gamestate
+//            - XferLoadMemory: This derives from XferLoad and reads the gamestate from a memory buffer
 //          - XferSave: Save gamestate
+//            - XferSaveMemory: This derives from XferSave and writes the gamestate to a memory buffer
 //          - XferCRC: Calculate gamestate CRC
 //            - XferDeepCRC: This derives from XferCRC and also writes the gamestate data relevant
 //              to crc calculation to a file (only used in developer builds)
+//            - XferSnapshotCRC: This derives from XferCRC and calculates a crc per snapshot for crc mismatch reports
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
@@ -102,6 +105,7 @@ enum XferOptions CPP_11(: UnsignedInt)
 {
 	XO_NONE										= 0x00000000,
 	XO_NO_POST_PROCESSING			= 0x00000001,
+	XO_REPLAY_CHECKPOINT			= 0x00000002,	///< TheSuperHackers @bugfix also xfer the state a save game recomputes on load
 
 	XO_ALL										= 0xFFFFFFFF
 };
@@ -0,0 +1,87 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: XferMemory.h /////////////////////////////////////////////////////////////////////////////
+// Desc:   Xfer implementations that save to and load from a memory buffer instead of a file
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
+#include "Common/XferLoad.h"
+#include "Common/XferSave.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+typedef std::vector<UnsignedByte> XferBuffer;
+
+//-------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature Writes the xfer stream into a memory buffer. The data layout is
+	* identical to XferSave, which allows to keep game state snapshots in RAM. */
+//-------------------------------------------------------------------------------------------------
+class XferSaveMemory : public XferSave
+{
+
+public:
+
+	XferSaveMemory( XferBuffer *buffer );
+	virtual ~XferSaveMemory( void );
+
+	// Xfer methods
+	virtual void open( AsciiString identifier );		///< start writing to the buffer, clears the buffer
+	virtual void close( void );											///< stop writing to the buffer
+	virtual Int beginBlock( void );									///< write placeholder block size
+	virtual void endBlock( void );									///< backup to last begin block and write size
+	virtual void skip( Int dataSize );							///< skipping during a write is a no-op
+
+protected:
+
+	virtual void xferImplementation( void *data, Int dataSize );		///< the xfer implementation
+
+	XferBuffer *m_buffer;																	///< buffer we write into
+	std::vector<size_t> m_blockPositions;									///< stack of begin block positions
+	Bool m_isOpen;
+
+};
+
+//-------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature Reads an xfer stream written by XferSaveMemory. */
+//-------------------------------------------------------------------------------------------------
+class XferLoadMemory : public XferLoad
+{
+
+public:
+
+	XferLoadMemory( const XferBuffer *buffer );
+	virtual ~XferLoadMemory( void );
+
+	// Xfer methods
+	virtual void open( AsciiString identifier );				///< start reading from the start of the buffer
+	virtual void close( void );													///< stop reading from the buffer
+	virtual Int beginBlock( void );											///< read placeholder block size
+	virtual void endBlock( void );											///< reading an end block is a no-op
+	virtual void skip( Int dataSize );									///< skip forward dataSize bytes in the buffer
+
+protected:
+
+	virtual void xferImplementation( void *data, Int dataSize );		///< the xfer implementation
+
+	const XferBuffer *m_buffer;														///< buffer we read from
+	size_t m_readPosition;																///< current read position in the buffer
+	Bool m_isOpen;
+
+};
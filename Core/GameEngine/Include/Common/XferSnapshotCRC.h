@@ -0,0 +1,80 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: XferSnapshotCRC.h ////////////////////////////////////////////////////////////////////////
+// Desc:   Xfer CRC implementation that also calculates a CRC for each nested snapshot
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
+#include "Common/XferCRC.h"
+
+//-------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature Runs the save path of each snapshot like XferDeepCRC and calculates
+	* a separate CRC for every snapshot up to a maximum nesting depth. The snapshot is labeled with
+	* the label set before xfering it, or else with the last string that was xfered before it,
+	* which is the block name for save game blocks and the module tag for object modules.
+	* This allows to find the first diverging snapshot when comparing two game states. */
+//-------------------------------------------------------------------------------------------------
+class XferSnapshotCRC : public XferCRC
+{
+
+public:
+
+	struct Entry
+	{
+		Int depth;						///< nesting depth, 0 for top level snapshots
+		AsciiString label;		///< name of the snapshot
+		UnsignedInt crc;			///< CRC of all data xfered by this snapshot
+		UnsignedInt size;			///< number of bytes xfered by this snapshot
+	};
+	typedef std::vector<Entry> EntryList;
+
+	XferSnapshotCRC( Int maxDepth );
+	virtual ~XferSnapshotCRC( void );
+
+	// Xfer methods
+	virtual void open( AsciiString identifier );		///< start a CRC session with this xfer instance
+
+	virtual void xferSnapshot( Snapshot *snapshot );		///< entry point for xfering a snapshot
+
+	// xfer methods
+	virtual void xferAsciiString( AsciiString *asciiStringData );
+
+	void setNextLabel( const AsciiString& label ) { m_nextLabel = label; }	///< label for the next snapshot
+	EntryList& getEntries( void ) { return m_entries; }
+
+protected:
+
+	virtual void xferImplementation( void *data, Int dataSize );
+
+	struct OpenSnapshot
+	{
+		size_t entryIndex;
+		UnsignedInt crc;
+	};
+
+	std::vector<OpenSnapshot> m_openSnapshots;	///< stack of snapshots that are currently xfered
+	EntryList m_entries;
+	AsciiString m_nextLabel;
+	AsciiString m_lastString;
+	Int m_depth;
+	Int m_maxDepth;
+
+};
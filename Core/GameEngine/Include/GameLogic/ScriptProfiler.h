@@ -0,0 +1,96 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ScriptProfiler.h
+// Attributes the time spent in the ScriptEngine to scripts, condition types and action types
+
+#pragma once
+
+#include "Lib/BaseType.h"
+#include "Common/AsciiString.h"
+#include "Utility/intrin_compat.h"
+
+class Condition;
+class Script;
+class ScriptAction;
+
+//-------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature Opt-in profiler for the ScriptEngine, see -profileScripts.
+	* Counts cycles and calls for every script by name, every condition type and every action type.
+	* A script's cycles include the subroutines it calls. Its self cycles do not, so the self cycles of
+	* all scripts add up to the time spent in scripts. The cycles of an action type include what the
+	* action calls, so CALL_SUBROUTINE shows the cost of whole subroutine chains. The profile collects
+	* over all maps, and the ScriptEngine writes the report at the end of every map. The profiler only
+	* exists while it is enabled, so the ScriptEngine only pays for a null check otherwise. */
+//-------------------------------------------------------------------------------------------------
+class ScriptProfiler
+{
+public:
+
+	ScriptProfiler();
+
+	void reset();
+
+	static UnsignedInt64 getCycles() { return _rdtsc(); }
+
+	void beginScript();
+	void endScript(const Script* script, UnsignedInt64 cycles, Bool fired);
+	void addConditions(const Script* script, UnsignedInt64 cycles);
+	void addCondition(Condition* condition, UnsignedInt64 cycles, Bool result);
+	void addAction(ScriptAction* action, UnsignedInt64 cycles);
+
+	Bool hasData() const { return !m_scriptStats.empty(); }
+
+	Bool writeReport(const AsciiString& filename) const;
+	void printTopOffenders(FILE* fp, Int count) const;
+
+private:
+
+	struct Stats
+	{
+		Stats() : cycles(0), selfCycles(0), conditionCycles(0), calls(0), hits(0) {}
+		AsciiString name;
+		UnsignedInt64 cycles;
+		UnsignedInt64 selfCycles;				///< scripts only, without the scripts they call
+		UnsignedInt64 conditionCycles;	///< scripts only
+		UnsignedInt calls;
+		UnsignedInt hits;								///< scripts that fired, conditions that were true
+	};
+	typedef std::map<AsciiString, Stats> ScriptStatsMap;
+	typedef std::vector<Stats> TypeStatsVec;	///< indexed by condition or action type
+	typedef std::vector<const Stats*> StatsList;
+
+	static bool isMoreCycles(const Stats* a, const Stats* b) { return a->cycles > b->cycles; }
+	static bool isMoreSelfCycles(const Stats* a, const Stats* b) { return a->selfCycles > b->selfCycles; }
+
+	static Stats& getTypeStats(TypeStatsVec& stats, Int type);
+	static void collectTypeStats(const TypeStatsVec& stats, StatsList& list);
+
+	void collectScriptStats(StatsList& list) const;
+	UnsignedInt64 getTotalCycles() const;
+	Real getCyclesPerMillisecond() const;
+
+	ScriptStatsMap m_scriptStats;
+	TypeStatsVec m_conditionStats;
+	TypeStatsVec m_actionStats;
+	std::vector<UnsignedInt64> m_childCycles;	///< cycles of the called scripts, per running script
+	UnsignedInt64 m_startCycles;
+	UnsignedInt m_startMillis;
+};
+
+extern ScriptProfiler* TheScriptProfiler;	///< only exists when the scripts are profiled
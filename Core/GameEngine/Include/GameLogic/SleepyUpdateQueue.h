@@ -0,0 +1,258 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// SleepyUpdateQueue.h
+// Priority queue that schedules the sleepy update modules of GameLogic
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+#include <vector>
+
+// The queue holds pointers to update modules and uses these methods of them:
+//   UnsignedInt friend_getPriority() const;	// (next call frame << 2) | phase, lower runs first
+//   Int friend_getIndexInLogic() const;			// position in the queue, -1 if not queued
+//   void friend_setIndexInLogic(Int i);
+// After the priority of a queued module changed, the module must be rescheduled before the queue is used again.
+// This header does not depend on the game, so that the queue can be benchmarked standalone (see sleepyUpdateBench).
+
+//-------------------------------------------------------------------------------------------------
+/** Binary heap, the original scheduler of the game. Modules with equal priority run in an order that
+	* depends on the history of the heap, so nothing but this exact heap can reproduce the retail order.
+	* TheSuperHackers @performance The heap keeps a copy of the priority next to the module pointer,
+	* which saves a module read per comparison and does not change the order. */
+//-------------------------------------------------------------------------------------------------
+template <typename UpdatePtr>
+class SleepyUpdateHeap
+{
+public:
+
+	Bool empty() const { return m_entries.empty(); }
+	Int size() const { return (Int)m_entries.size(); }
+	UpdatePtr getAt(Int i) const { return m_entries[i].item; }
+
+	Bool contains(UpdatePtr u) const
+	{
+		const Int i = u->friend_getIndexInLogic();
+		return i >= 0 && i < size() && m_entries[i].item == u;
+	}
+
+	void clear()
+	{
+		for (size_t i = 0; i < m_entries.size(); ++i)
+			m_entries[i].item->friend_setIndexInLogic(-1);
+		m_entries.clear();
+	}
+
+	void push(UpdatePtr u)
+	{
+		pushUnsorted(u);
+		rebalanceParent(size() - 1);
+	}
+
+	// Adds the module without sorting, call remake() when done.
+	void pushUnsorted(UpdatePtr u)
+	{
+		Entry entry;
+		entry.priority = u->friend_getPriority();
+		entry.item = u;
+		m_entries.push_back(entry);
+		u->friend_setIndexInLogic(size() - 1);
+	}
+
+	// Sorts the whole heap at once.
+	void remake()
+	{
+		if (m_entries.empty())
+			return;
+
+		Int parent = size() / 2;
+		while (true)
+		{
+			rebalanceChild(parent);
+			if (parent == 0)
+				break;
+			--parent;
+		}
+	}
+
+	UpdatePtr peek() const
+	{
+		return m_entries.front().item;
+	}
+
+	void pop()
+	{
+		const Int sz = size();
+		m_entries[0].item->friend_setIndexInLogic(-1);
+		if (sz > 1)
+		{
+			m_entries[0] = m_entries[sz-1];
+			m_entries[0].item->friend_setIndexInLogic(0);
+			m_entries.pop_back();
+			rebalanceChild(0);
+		}
+		else
+		{
+			m_entries.pop_back();
+		}
+	}
+
+	void erase(UpdatePtr u)
+	{
+		// swap with the final item, toss the final item, then rebalance
+		const Int i = u->friend_getIndexInLogic();
+		m_entries[i].item->friend_setIndexInLogic(-1);
+
+		const Int final = size() - 1;
+		if (i < final)
+		{
+			m_entries[i] = m_entries[final];
+			m_entries[i].item->friend_setIndexInLogic(i);
+			m_entries.pop_back();
+			rebalance(i);
+		}
+		else
+		{
+			m_entries.pop_back();
+		}
+	}
+
+	// The priority of the module changed.
+	void reschedule(UpdatePtr u)
+	{
+		const Int i = u->friend_getIndexInLogic();
+		m_entries[i].priority = u->friend_getPriority();
+		rebalance(i);
+	}
+
+	// The priority of the module that was just peeked changed. Note that the game always rebalanced the top
+	// of the heap here, even if the update of the module moved another module to the top.
+	void reschedulePeeked(UpdatePtr u)
+	{
+		const Int i = u->friend_getIndexInLogic();
+		if (i >= 0)
+			m_entries[i].priority = u->friend_getPriority();
+		rebalance(0);
+	}
+
+	Bool validate() const
+	{
+		const Int sz = size();
+		for (Int i = 0; i < sz; ++i)
+		{
+			if (m_entries[i].item->friend_getIndexInLogic() != i)
+				return FALSE;
+			if (m_entries[i].item->friend_getPriority() != m_entries[i].priority)
+				return FALSE;
+			if (i > 0 && m_entries[i].priority < m_entries[(i+1)/2-1].priority)
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+private:
+
+	struct Entry
+	{
+		UnsignedInt priority;
+		UpdatePtr item;
+	};
+
+	// return true iff a is lower pri than b.
+	// remember: lower ordinal value means higher priority.
+	// therefore, higher ordinal value means lower priority.
+	static Bool isLowerPriority(const Entry& a, const Entry& b)
+	{
+		return a.priority > b.priority;
+	}
+
+	Int rebalanceParent(Int i)
+	{
+		Int parent = ((i+1)>>1)-1;
+		while (parent >= 0 && isLowerPriority(m_entries[parent], m_entries[i]))
+		{
+			const Entry a = m_entries[parent];
+			const Entry b = m_entries[i];
+
+			m_entries[i] = a;
+			m_entries[parent] = b;
+
+			a.item->friend_setIndexInLogic(i);
+			b.item->friend_setIndexInLogic(parent);
+
+			i = parent;
+			parent = ((parent+1)>>1)-1;
+		}
+
+		return i;
+	}
+
+	Int rebalanceChild(Int i)
+	{
+		Entry* pI = &m_entries[i];
+
+		// our children are i*2 and i*2+1
+		Int child = ((i)<<1)+1;
+		Entry* pChild = &m_entries[0] + child;
+		Entry* pSZ = &m_entries[0] + m_entries.size();	// yes, this is off the end.
+
+		while (pChild < pSZ)
+		{
+			// choose the higher-priority of the two children; we must be higher-pri than that.
+			if (pChild < pSZ-1 && isLowerPriority(*pChild, *(pChild+1)))
+			{
+				++pChild;
+				++child;
+			}
+
+			// if we're higher-pri than our children, we're done.
+			if (!isLowerPriority(*pI, *pChild))
+			{
+				break;
+			}
+
+			// doh. swap with the highest-pri child we have.
+			const Entry a = *pChild;
+			const Entry b = *pI;
+
+			*pI = a;
+			*pChild = b;
+
+			a.item->friend_setIndexInLogic(i);
+			b.item->friend_setIndexInLogic(child);
+
+			i = child;
+			pI = pChild;
+
+			child = ((i)<<1)+1;
+			pChild = &m_entries[0] + child;
+		}
+
+		return i;
+	}
+
+	void rebalance(Int i)
+	{
+		i = rebalanceParent(i);
+		i = rebalanceChild(i);
+	}
+
+	std::vector<Entry> m_entries;
+};
@@ -0,0 +1,79 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// UpdateProfiler.h
+// Attributes the time spent in UpdateModule::update to module classes and thing templates
+
+#pragma once
+
+#include "Lib/BaseType.h"
+#include "Common/AsciiString.h"
+#include "Common/NameKeyGenerator.h"
+#include "Utility/intrin_compat.h"
+
+class ThingTemplate;
+
+//-------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature Opt-in profiler for the sleepy updates in GameLogic::update, see -profileUpdates.
+	* Counts cycles, calls and calls that returned UPDATE_SLEEP_NONE for every pair of module class and
+	* thing template. The report is a table sorted by cycles, or a Chrome trace (chrome://tracing, Perfetto)
+	* if the file name ends with .json. The profiler only exists while it is enabled, so the update loop
+	* only pays for a null check otherwise. */
+//-------------------------------------------------------------------------------------------------
+class UpdateProfiler
+{
+public:
+
+	UpdateProfiler();
+
+	void reset();
+
+	static UnsignedInt64 getCycles() { return _rdtsc(); }
+
+	void addUpdate(NameKeyType moduleNameKey, const ThingTemplate* thingTemplate, UnsignedInt64 cycles, Bool sleepNone);
+
+	Bool writeReport(const AsciiString& filename) const;
+
+private:
+
+	struct Stats
+	{
+		Stats() : cycles(0), calls(0), sleepNoneCalls(0) {}
+		NameKeyType moduleNameKey;
+		AsciiString templateName;
+		UnsignedInt64 cycles;
+		UnsignedInt calls;
+		UnsignedInt sleepNoneCalls;
+	};
+	typedef std::map<UnsignedInt64, Stats> StatsMap;	///< key is module name key and template id
+	typedef std::vector<const Stats*> StatsList;
+
+	static bool isMoreCycles(const Stats* a, const Stats* b) { return a->cycles > b->cycles; }
+
+	void collectModuleTotals(std::vector<Stats>& totals) const;
+	Real getCyclesPerMillisecond() const;
+
+	Bool writeTable(FILE* fp) const;
+	Bool writeChromeTrace(FILE* fp) const;
+
+	StatsMap m_stats;
+	UnsignedInt64 m_startCycles;
+	UnsignedInt m_startMillis;
+};
+
+extern UpdateProfiler* TheUpdateProfiler;	///< only exists when the updates are profiled
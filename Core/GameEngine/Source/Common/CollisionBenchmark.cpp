@@ -0,0 +1,276 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/CollisionBenchmark.h"
+
+#include "Common/PathfindBenchmark.h"
+#include "Common/Player.h"
+#include "Common/PlayerList.h"
+#include "Common/ThingFactory.h"
+#include "Common/ThingTemplate.h"
+#include "GameLogic/GameLogic.h"
+#include "GameLogic/Object.h"
+#include "GameLogic/PartitionManager.h"
+#include "GameLogic/TerrainLogic.h"
+
+#include <algorithm>
+
+namespace
+{
+const UnsignedInt COLLISION_BENCH_SEED = 1;
+
+UnsignedInt64 getTicks()
+{
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	return ticks.QuadPart;
+}
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+CollisionBenchmark::CollisionBenchmark()
+	: m_random(COLLISION_BENCH_SEED)
+	, m_blobRadius(0.0f)
+	, m_stepRadius(0.0f)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_ticksPerSecond = frequency.QuadPart;
+	m_blobCenter.zero();
+}
+
+//-------------------------------------------------------------------------------------------------
+int CollisionBenchmark::run(const AsciiString& mapName)
+{
+	// Note that we use printf here because this is run from cmd.
+	CollisionBenchmark benchmark;
+	const Int numUnits = std::max(TheGlobalData->m_collisionBenchUnits, 2);
+	const Int numFrames = std::max(TheGlobalData->m_collisionBenchFrames, 1);
+	printf("Collision benchmark of \"%s\" with %d units for %d frames\n", mapName.str(), numUnits, numFrames);
+	fflush(stdout);
+
+	if (!PathfindBenchmark::loadMap(mapName))
+	{
+		printf("Cannot load map \"%s\"\n", mapName.str());
+		return 1;
+	}
+
+	const ThingTemplate* tmpl = findUnitTemplate();
+	if (tmpl == nullptr)
+	{
+		printf("No units to benchmark\n");
+		return 1;
+	}
+
+	UnitList units;
+	benchmark.createUnits(tmpl, numUnits, units);
+	printf("Collision units: %s in a blob of radius %.1f\n", tmpl->getName().str(), benchmark.m_blobRadius);
+
+	// The first update registers the units in their cells, it is not part of the measurement.
+	ThePartitionManager->update();
+	const PartitionCollisionStats startStats = ThePartitionManager->getCollisionStats();
+
+	std::vector<UnsignedInt64> ticks;
+	ticks.reserve(numFrames);
+	for (Int i = 0; i < numFrames; ++i)
+	{
+		benchmark.moveUnits(units);
+		const UnsignedInt64 startTicks = getTicks();
+		ThePartitionManager->update();
+		ticks.push_back(getTicks() - startTicks);
+	}
+
+	const PartitionCollisionStats& stats = ThePartitionManager->getCollisionStats();
+	const UnsignedInt contacts = stats.m_contacts - startStats.m_contacts;
+	const UnsignedInt collisions = stats.m_collisions - startStats.m_collisions;
+
+	UnsignedInt64 sequentialTicks = 0;
+	UnsignedInt64 batchTicks = 0;
+	const Int mismatches = benchmark.compareClosestQueries(units, numFrames, sequentialTicks, batchTicks);
+
+	for (size_t i = 0; i < units.size(); ++i)
+		TheGameLogic->destroyObject(units[i]);
+
+	const double microsPerTick = benchmark.m_ticksPerSecond != 0 ? 1000000.0 / benchmark.m_ticksPerSecond : 0.0;
+	std::sort(ticks.begin(), ticks.end());
+	UnsignedInt64 totalTicks = 0;
+	for (size_t i = 0; i < ticks.size(); ++i)
+		totalTicks += ticks[i];
+
+	printf("Collision update: mean %.2f us, p50 %.2f us, p99 %.2f us, max %.2f us\n",
+		totalTicks * microsPerTick / ticks.size(),
+		ticks[(ticks.size() * 50) / 100] * microsPerTick,
+		ticks[(ticks.size() * 99) / 100] * microsPerTick,
+		ticks.back() * microsPerTick);
+	printf("Collision pairs: %.1f tested, %.1f collided per frame\n",
+		(double)contacts / numFrames, (double)collisions / numFrames);
+	printf("Closest object queries: sequential %.2f us, batch %.2f us per frame, %d mismatches\n",
+		sequentialTicks * microsPerTick / numFrames,
+		batchTicks * microsPerTick / numFrames,
+		mismatches);
+	fflush(stdout);
+	return mismatches == 0 ? 0 : 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Every unit looks for the closest other unit around it, once with one getClosestObject per unit
+	* and once with one getClosestObjectsBatch for all units. Returns the number of queries where the
+	* two disagree. */
+//-------------------------------------------------------------------------------------------------
+Int CollisionBenchmark::compareClosestQueries(const UnitList& units, Int numFrames, UnsignedInt64& sequentialTicks, UnsignedInt64& batchTicks)
+{
+	const Real queryRadius = m_blobRadius * 0.25f;
+	PartitionFilterAlive filterAlive;
+	PartitionFilter *filters[] = { &filterAlive, nullptr };
+
+	std::vector<Object*> sequentialResults(units.size());
+	std::vector<Real> sequentialDists(units.size());
+	std::vector<PartitionQuery> queries(units.size());
+	Int mismatches = 0;
+
+	for (Int frame = 0; frame < numFrames; ++frame)
+	{
+		moveUnits(units);
+		ThePartitionManager->update();
+
+		UnsignedInt64 startTicks = getTicks();
+		for (size_t i = 0; i < units.size(); ++i)
+		{
+			sequentialResults[i] = ThePartitionManager->getClosestObject(units[i], queryRadius, FROM_CENTER_2D,
+				filters, &sequentialDists[i]);
+		}
+		sequentialTicks += getTicks() - startTicks;
+
+		for (size_t i = 0; i < units.size(); ++i)
+		{
+			queries[i] = PartitionQuery();
+			queries[i].obj = units[i];
+			queries[i].maxDist = queryRadius;
+			queries[i].dc = FROM_CENTER_2D;
+			queries[i].filters = filters;
+		}
+
+		startTicks = getTicks();
+		ThePartitionManager->getClosestObjectsBatch(&queries[0], (Int)queries.size());
+		batchTicks += getTicks() - startTicks;
+
+		for (size_t i = 0; i < units.size(); ++i)
+		{
+			if (queries[i].closestObj != sequentialResults[i]
+				|| (sequentialResults[i] != nullptr && queries[i].closestDist != sequentialDists[i]))
+			{
+				++mismatches;
+			}
+		}
+	}
+
+	return mismatches;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Returns the first buildable infantry in the template list, so the same unit is chosen on every run.
+	* Infantry of one team does not crush each other, so no unit dies during the benchmark. */
+//-------------------------------------------------------------------------------------------------
+const ThingTemplate* CollisionBenchmark::findUnitTemplate()
+{
+	for (const ThingTemplate* tmpl = TheThingFactory->firstTemplate(); tmpl; tmpl = tmpl->friend_getNextTemplate())
+	{
+		if (tmpl->getBuildable() == BSTATUS_YES && tmpl->isKindOf(KINDOF_INFANTRY) && !tmpl->isKindOf(KINDOF_AIRCRAFT))
+			return tmpl;
+	}
+	return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The blob has room for about one bounding circle per unit, so every unit overlaps several
+	* others and the cells of the blob hold many units. */
+//-------------------------------------------------------------------------------------------------
+void CollisionBenchmark::createUnits(const ThingTemplate* tmpl, Int count, UnitList& units)
+{
+	Team* team = ThePlayerList->getNeutralPlayer()->getDefaultTeam();
+
+	Region3D extent;
+	TheTerrainLogic->getExtent(&extent);
+	m_blobCenter.x = (extent.lo.x + extent.hi.x) * 0.5f;
+	m_blobCenter.y = (extent.lo.y + extent.hi.y) * 0.5f;
+
+	const Real unitRadius = std::max(tmpl->getTemplateGeometryInfo().getBoundingCircleRadius(), 1.0f);
+	m_blobRadius = unitRadius * sqrtf((Real)count);
+	m_stepRadius = unitRadius * 0.5f;
+
+	units.reserve(count);
+	for (Int i = 0; i < count; ++i)
+	{
+		Object* obj = TheThingFactory->newObject(tmpl, team);
+		if (obj == nullptr)
+			continue;
+
+		Coord3D pos;
+		getRandomPositionInBlob(pos);
+		obj->setPosition(&pos);
+		units.push_back(obj);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void CollisionBenchmark::moveUnits(const UnitList& units)
+{
+	for (size_t i = 0; i < units.size(); ++i)
+	{
+		Coord3D pos = *units[i]->getPosition();
+		pos.x += getRandomReal(-m_stepRadius, m_stepRadius);
+		pos.y += getRandomReal(-m_stepRadius, m_stepRadius);
+
+		// Units that step out of the blob come back in at a random position.
+		const Real dx = pos.x - m_blobCenter.x;
+		const Real dy = pos.y - m_blobCenter.y;
+		if (dx * dx + dy * dy > m_blobRadius * m_blobRadius)
+			getRandomPositionInBlob(pos);
+		else
+			pos.z = TheTerrainLogic->getGroundHeight(pos.x, pos.y);
+
+		units[i]->setPosition(&pos);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void CollisionBenchmark::getRandomPositionInBlob(Coord3D& pos)
+{
+	Real dx;
+	Real dy;
+	do
+	{
+		dx = getRandomReal(-m_blobRadius, m_blobRadius);
+		dy = getRandomReal(-m_blobRadius, m_blobRadius);
+	} while (dx * dx + dy * dy > m_blobRadius * m_blobRadius);
+
+	pos.x = m_blobCenter.x + dx;
+	pos.y = m_blobCenter.y + dy;
+	pos.z = TheTerrainLogic->getGroundHeight(pos.x, pos.y);
+}
+
+//-------------------------------------------------------------------------------------------------
+Real CollisionBenchmark::getRandomReal(Real lo, Real hi)
+{
+	m_random ^= m_random << 13;
+	m_random ^= m_random >> 17;
+	m_random ^= m_random << 5;
+	return lo + (hi - lo) * ((m_random & 0xFFFF) / 65535.0f);
+}
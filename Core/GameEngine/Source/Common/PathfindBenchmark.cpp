@@ -0,0 +1,545 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/PathfindBenchmark.h"
+
+#include "Common/FileSystem.h"
+#include "Common/MessageStream.h"
+#include "Common/Player.h"
+#include "Common/PlayerList.h"
+#include "Common/RandomValue.h"
+#include "Common/ThingFactory.h"
+#include "Common/ThingTemplate.h"
+#include "GameLogic/AI.h"
+#include "GameLogic/AIPathfind.h"
+#include "GameLogic/GameLogic.h"
+#include "GameLogic/Locomotor.h"
+#include "GameLogic/Object.h"
+#include "GameLogic/TerrainLogic.h"
+#include "GameLogic/Weapon.h"
+#include "GameLogic/Module/AIUpdate.h"
+#include "GameClient/GameClient.h"
+
+#include <algorithm>
+
+namespace
+{
+const char* const s_resultTag = "Pathfind Result:";
+const char* const s_csvHeader = "unit,surfaces,query,queries,found,mean_us,p50_us,p90_us,p99_us,max_us,cells_mean,cells_max,checksum";
+
+const char* const s_queryNames[PathfindBenchmark::QUERY_COUNT] =
+{
+	"findPath",
+	"findClosestPath",
+	"findAttackPath",
+	"isLinePassable",
+};
+
+// Tries this many random cells to find one that the unit can stand on.
+const Int MAX_POSITION_ATTEMPTS = 32;
+
+// Logic updates to wait for the map to load before giving up.
+const Int MAX_LOAD_UPDATES = 16;
+
+void printResultCSV(FILE* fp, const char* prefix, const PathfindBenchmark::Result& result)
+{
+	fprintf(fp, "%s%s,%d,%s,%u,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%u,%u,%08X\n",
+		prefix, result.unitName.str(), result.surfaces, s_queryNames[result.query], result.queries, result.found,
+		result.meanMicros, result.p50Micros, result.p90Micros, result.p99Micros, result.maxMicros,
+		result.meanCells, result.maxCells, result.checksum);
+}
+
+Int getQueryType(const char* name)
+{
+	for (Int i = 0; i < PathfindBenchmark::QUERY_COUNT; ++i)
+	{
+		if (strcmp(s_queryNames[i], name) == 0)
+			return i;
+	}
+	return -1;
+}
+
+UnsignedInt64 getTicks()
+{
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	return ticks.QuadPart;
+}
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+PathfindBenchmark::Result::Result()
+	: surfaces(0)
+	, query(QUERY_FIND_PATH)
+	, queries(0)
+	, found(0)
+	, meanMicros(0.0f)
+	, p50Micros(0.0f)
+	, p90Micros(0.0f)
+	, p99Micros(0.0f)
+	, maxMicros(0.0f)
+	, meanCells(0)
+	, maxCells(0)
+	, checksum(0)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+PathfindBenchmark::PathfindBenchmark(UnsignedInt seed)
+	: m_random(seed != 0 ? seed : 1)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_ticksPerSecond = frequency.QuadPart;
+}
+
+//-------------------------------------------------------------------------------------------------
+int PathfindBenchmark::run(const AsciiString& mapName)
+{
+	// Note that we use printf here because this is run from cmd.
+	PathfindBenchmark benchmark(TheGlobalData->m_pathfindBenchSeed);
+	printf("Pathfind benchmark of \"%s\" with %d queries and seed %u\n",
+		mapName.str(), TheGlobalData->m_pathfindBenchQueries, TheGlobalData->m_pathfindBenchSeed);
+	fflush(stdout);
+
+	if (!loadMap(mapName))
+	{
+		printf("Cannot load map \"%s\"\n", mapName.str());
+		return 1;
+	}
+
+	Pathfinder* pathfinder = TheAI->pathfinder();
+	const UnsignedInt64 classifyStartTicks = getTicks();
+	pathfinder->forceMapRecalculation();
+	const UnsignedInt64 classifyTicks = getTicks() - classifyStartTicks;
+	printf("Pathfind classifyMap: %.1f ms for %dx%d cells\n",
+		classifyTicks * 1000.0 / benchmark.m_ticksPerSecond,
+		pathfinder->m_extent.hi.x - pathfinder->m_extent.lo.x + 1, pathfinder->m_extent.hi.y - pathfinder->m_extent.lo.y + 1);
+
+	UnitList units;
+	benchmark.createUnits(units);
+	if (units.empty())
+	{
+		printf("No units to benchmark\n");
+		return 1;
+	}
+
+	// The cell count of the pathfind queue is borrowed to count the cells of every query.
+	const Int cumulativeCellsAllocated = pathfinder->m_cumulativeCellsAllocated;
+	ResultList results;
+	for (size_t i = 0; i < units.size(); ++i)
+		benchmark.runQueries(units[i], results);
+	pathfinder->m_cumulativeCellsAllocated = cumulativeCellsAllocated;
+
+	for (size_t i = 0; i < units.size(); ++i)
+		TheGameLogic->destroyObject(units[i].obj);
+
+	printResults(results);
+
+	int exitcode = 0;
+	if (TheGlobalData->m_pathfindBenchFileName.isNotEmpty())
+	{
+		if (writeResults(TheGlobalData->m_pathfindBenchFileName, results))
+			printf("Pathfind benchmark written to \"%s\"\n", TheGlobalData->m_pathfindBenchFileName.str());
+		else
+		{
+			printf("Cannot write pathfind benchmark \"%s\"\n", TheGlobalData->m_pathfindBenchFileName.str());
+			exitcode = 1;
+		}
+	}
+	if (TheGlobalData->m_pathfindBenchBaselineFileName.isNotEmpty())
+	{
+		ResultList baseline;
+		if (!readResults(TheGlobalData->m_pathfindBenchBaselineFileName, baseline))
+		{
+			printf("Cannot read pathfind benchmark baseline \"%s\"\n", TheGlobalData->m_pathfindBenchBaselineFileName.str());
+			exitcode = 1;
+		}
+		else if (!compareWithBaseline(results, baseline, TheGlobalData->m_replayBenchTolerance))
+		{
+			exitcode = 1;
+		}
+	}
+	fflush(stdout);
+	return exitcode;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Starts a single player game on the map, like -file does, and updates the logic until the map
+	* has finished loading. */
+//-------------------------------------------------------------------------------------------------
+Bool PathfindBenchmark::loadMap(const AsciiString& mapName)
+{
+	if (!TheFileSystem->doesFileExist(mapName.str()))
+		return FALSE;
+
+	TheWritableGlobalData->m_pendingFile = mapName;
+
+	// The message bypasses TheMessageStream, because it is not updated here. See RecorderClass::playbackFile.
+	GameMessage *msg = newInstance(GameMessage)(GameMessage::MSG_NEW_GAME);
+	msg->appendIntegerArgument(GAME_SINGLE_PLAYER);
+	msg->appendIntegerArgument(DIFFICULTY_NORMAL);
+	msg->appendIntegerArgument(0);
+	TheCommandList->appendMessage(msg);
+	InitRandom(0);
+
+	for (Int i = 0; i < MAX_LOAD_UPDATES; ++i)
+	{
+		TheGameClient->updateHeadless();
+		TheGameLogic->UPDATE();
+		if (TheGameLogic->isInGame() && !TheGameLogic->isLoadingMap() && TheGameLogic->getFrame() != 0)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Creates one neutral unit for every combination of locomotor surfaces, crusher and path width
+	* among the buildable ground units. The first template in the template list wins, so the same
+	* units are chosen on every run. */
+//-------------------------------------------------------------------------------------------------
+void PathfindBenchmark::createUnits(UnitList& units)
+{
+	Pathfinder* pathfinder = TheAI->pathfinder();
+	Team* team = ThePlayerList->getNeutralPlayer()->getDefaultTeam();
+
+	for (const ThingTemplate* tmpl = TheThingFactory->firstTemplate(); tmpl; tmpl = tmpl->friend_getNextTemplate())
+	{
+		if (tmpl->getBuildable() != BSTATUS_YES || tmpl->isKindOf(KINDOF_AIRCRAFT))
+			continue;
+		if (!tmpl->isKindOf(KINDOF_INFANTRY) && !tmpl->isKindOf(KINDOF_VEHICLE))
+			continue;
+
+		Object* obj = TheThingFactory->newObject(tmpl, team);
+		if (obj == nullptr)
+			continue;
+
+		Unit unit;
+		unit.obj = obj;
+		unit.surfaces = obj->getAI() ? obj->getAI()->getLocomotorSet().getValidSurfaces() : NO_SURFACES;
+		unit.isCrusher = obj->getCrusherLevel() > 0;
+		Bool centerInCell;
+		pathfinder->getRadiusAndCenter(obj, unit.radius, centerInCell);
+
+		Bool isNewType = unit.surfaces != NO_SURFACES && (unit.surfaces & LOCOMOTORSURFACE_AIR) == 0;
+		for (size_t i = 0; isNewType && i < units.size(); ++i)
+		{
+			if (units[i].surfaces == unit.surfaces && units[i].isCrusher == unit.isCrusher && units[i].radius == unit.radius)
+				isNewType = FALSE;
+		}
+
+		if (isNewType)
+			units.push_back(unit);
+		else
+			TheGameLogic->destroyObject(obj);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindBenchmark::runQueries(const Unit& unit, ResultList& results)
+{
+	Pathfinder* pathfinder = TheAI->pathfinder();
+	Object* obj = unit.obj;
+	const LocomotorSet& locomotorSet = obj->getAI()->getLocomotorSet();
+	const Weapon* weapon = obj->getCurrentWeapon();
+	const UnsignedInt numQueries = std::max(TheGlobalData->m_pathfindBenchQueries, 1);
+
+	std::vector<UnsignedInt64> ticks;
+	ticks.reserve(numQueries);
+
+	for (Int query = 0; query < QUERY_COUNT; ++query)
+	{
+		// The attack path needs a weapon for the attack range.
+		if (query == QUERY_FIND_ATTACK_PATH && weapon == nullptr)
+			continue;
+
+		Result result;
+		result.unitName = obj->getTemplate()->getName();
+		result.surfaces = unit.surfaces;
+		result.query = query;
+
+		ticks.clear();
+		UnsignedInt64 totalCells = 0;
+		for (UnsignedInt i = 0; i < numQueries; ++i)
+		{
+			// Closest paths and lines also get goals the unit cannot stand on, like a click into a cliff.
+			const Bool anyGoal = query == QUERY_FIND_CLOSEST_PATH || query == QUERY_IS_LINE_PASSABLE;
+			Coord3D from;
+			Coord3D to;
+			getRandomPosition(from, &unit);
+			getRandomPosition(to, anyGoal ? nullptr : &unit);
+			obj->setPosition(&from);
+
+			Path* path = nullptr;
+			Bool found = FALSE;
+			pathfinder->m_cumulativeCellsAllocated = 0;
+			const UnsignedInt64 startTicks = getTicks();
+			switch (query)
+			{
+				case QUERY_FIND_PATH:
+					path = pathfinder->findPath(obj, locomotorSet, &from, &to);
+					break;
+				case QUERY_FIND_CLOSEST_PATH:
+					path = pathfinder->findClosestPath(obj, locomotorSet, &from, &to, FALSE, 0.0f, FALSE);
+					break;
+				case QUERY_FIND_ATTACK_PATH:
+					path = pathfinder->findAttackPath(obj, locomotorSet, &from, nullptr, &to, weapon);
+					break;
+				case QUERY_IS_LINE_PASSABLE:
+					found = pathfinder->isLinePassable(obj, unit.surfaces, LAYER_GROUND, from, to, FALSE, FALSE);
+					break;
+			}
+			ticks.push_back(getTicks() - startTicks);
+
+			const UnsignedInt cells = pathfinder->m_cumulativeCellsAllocated;
+			totalCells += cells;
+			result.maxCells = std::max(result.maxCells, cells);
+
+			if (path != nullptr)
+			{
+				found = TRUE;
+				addPathToChecksum(result.checksum, path);
+				deleteInstance(path);
+			}
+			addToChecksum(result.checksum, found);
+			if (found)
+				++result.found;
+		}
+
+		finishResult(result, ticks, totalCells);
+		results.push_back(result);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+UnsignedInt PathfindBenchmark::getRandomValue(UnsignedInt count)
+{
+	m_random ^= m_random << 13;
+	m_random ^= m_random >> 17;
+	m_random ^= m_random << 5;
+	return m_random % count;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Returns the center of a random cell in the playable area. If validFor is given, the cell is
+	* one the unit can stand on, unless none was found after a few attempts. */
+//-------------------------------------------------------------------------------------------------
+void PathfindBenchmark::getRandomPosition(Coord3D& pos, const Unit* validFor)
+{
+	Pathfinder* pathfinder = TheAI->pathfinder();
+	const IRegion2D& extent = pathfinder->m_logicalExtent;
+	const UnsignedInt width = extent.hi.x - extent.lo.x + 1;
+	const UnsignedInt height = extent.hi.y - extent.lo.y + 1;
+
+	for (Int i = 0; i < MAX_POSITION_ATTEMPTS; ++i)
+	{
+		const Int x = extent.lo.x + getRandomValue(width);
+		const Int y = extent.lo.y + getRandomValue(height);
+		pos.x = (x + 0.5f) * PATHFIND_CELL_SIZE_F;
+		pos.y = (y + 0.5f) * PATHFIND_CELL_SIZE_F;
+		pos.z = TheTerrainLogic->getGroundHeight(pos.x, pos.y);
+
+		if (validFor == nullptr)
+			return;
+		PathfindCell* cell = pathfinder->getCell(LAYER_GROUND, x, y);
+		if (cell != nullptr && pathfinder->validMovementPosition(validFor->isCrusher, validFor->surfaces, cell))
+			return;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindBenchmark::addToChecksum(UnsignedInt& checksum, Int value)
+{
+	checksum = (checksum ^ (UnsignedInt)value) * 16777619u;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The node positions are rounded to whole world units, so the checksum only changes for paths
+	* that really take another way. */
+//-------------------------------------------------------------------------------------------------
+void PathfindBenchmark::addPathToChecksum(UnsignedInt& checksum, Path* path)
+{
+	for (const PathNode* node = path->getFirstNode(); node != nullptr; node = node->getNext())
+	{
+		const Coord3D* pos = node->getPosition();
+		addToChecksum(checksum, REAL_TO_INT_FLOOR(pos->x));
+		addToChecksum(checksum, REAL_TO_INT_FLOOR(pos->y));
+		addToChecksum(checksum, node->getLayer());
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindBenchmark::finishResult(Result& result, std::vector<UnsignedInt64>& ticks, UnsignedInt64 totalCells) const
+{
+	result.queries = static_cast<UnsignedInt>(ticks.size());
+	if (ticks.empty() || m_ticksPerSecond == 0)
+		return;
+
+	const double microsPerTick = 1000000.0 / m_ticksPerSecond;
+	std::sort(ticks.begin(), ticks.end());
+
+	UnsignedInt64 totalTicks = 0;
+	for (size_t i = 0; i < ticks.size(); ++i)
+		totalTicks += ticks[i];
+
+	result.meanMicros = (Real)(totalTicks * microsPerTick / ticks.size());
+	result.p50Micros = (Real)(ticks[(ticks.size() * 50) / 100] * microsPerTick);
+	result.p90Micros = (Real)(ticks[(ticks.size() * 90) / 100] * microsPerTick);
+	result.p99Micros = (Real)(ticks[(ticks.size() * 99) / 100] * microsPerTick);
+	result.maxMicros = (Real)(ticks.back() * microsPerTick);
+	result.meanCells = (UnsignedInt)(totalCells / ticks.size());
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathfindBenchmark::printResults(const ResultList& results)
+{
+	// CSV that can be consumed by scripts. Each line is prefixed so it can be grepped from the log.
+	AsciiString prefix;
+	prefix.format("%s ", s_resultTag);
+	printf("%s%s\n", prefix.str(), s_csvHeader);
+	for (size_t i = 0; i < results.size(); ++i)
+		printResultCSV(stdout, prefix.str(), results[i]);
+	fflush(stdout);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool PathfindBenchmark::writeResults(const AsciiString& filename, const ResultList& results)
+{
+	FILE* fp = fopen(filename.str(), "wt");
+	if (fp == nullptr)
+		return FALSE;
+
+	fprintf(fp, "%s\n", s_csvHeader);
+	for (size_t i = 0; i < results.size(); ++i)
+		printResultCSV(fp, "", results[i]);
+
+	const Bool success = ferror(fp) == 0;
+	fclose(fp);
+	return success;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool PathfindBenchmark::readResults(const AsciiString& filename, ResultList& results)
+{
+	FILE* fp = fopen(filename.str(), "rt");
+	if (fp == nullptr)
+		return FALSE;
+
+	results.clear();
+	char line[1024];
+	while (fgets(line, sizeof(line), fp) != nullptr)
+	{
+		char unitName[256];
+		char queryName[64];
+		int surfaces = 0;
+		unsigned int queries = 0;
+		unsigned int found = 0;
+		float meanMicros = 0.0f;
+		float p50Micros = 0.0f;
+		float p90Micros = 0.0f;
+		float p99Micros = 0.0f;
+		float maxMicros = 0.0f;
+		unsigned int meanCells = 0;
+		unsigned int maxCells = 0;
+		unsigned int checksum = 0;
+		// Skips the header and anything else that is not a result.
+		if (sscanf(line, "%255[^,],%d,%63[^,],%u,%u,%f,%f,%f,%f,%f,%u,%u,%X",
+				unitName, &surfaces, queryName, &queries, &found, &meanMicros, &p50Micros, &p90Micros, &p99Micros, &maxMicros,
+				&meanCells, &maxCells, &checksum) != 13)
+			continue;
+
+		const Int query = getQueryType(queryName);
+		if (query < 0)
+			continue;
+
+		Result result;
+		result.unitName = unitName;
+		result.surfaces = surfaces;
+		result.query = query;
+		result.queries = queries;
+		result.found = found;
+		result.meanMicros = meanMicros;
+		result.p50Micros = p50Micros;
+		result.p90Micros = p90Micros;
+		result.p99Micros = p99Micros;
+		result.maxMicros = maxMicros;
+		result.meanCells = meanCells;
+		result.maxCells = maxCells;
+		result.checksum = checksum;
+		results.push_back(result);
+	}
+
+	fclose(fp);
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+const PathfindBenchmark::Result* PathfindBenchmark::findResult(const ResultList& results, const Result& result)
+{
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		if (results[i].query == result.query && results[i].surfaces == result.surfaces && results[i].unitName.compare(result.unitName) == 0)
+			return &results[i];
+	}
+	return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The mean latency is compared, because the high percentiles of a few thousand queries are too
+	* noisy for a fixed tolerance. A query that was not in the baseline is reported, but does not fail
+	* the comparison. The baseline must be of the same map, query count and seed. */
+//-------------------------------------------------------------------------------------------------
+Bool PathfindBenchmark::compareWithBaseline(const ResultList& results, const ResultList& baseline, Real tolerancePercent)
+{
+	Bool success = TRUE;
+
+	printf("Pathfind Baseline: unit,query,mean_us,baseline,change%%,cells_mean,baseline,verdict\n");
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& result = results[i];
+		const Result* base = findResult(baseline, result);
+		if (base == nullptr)
+		{
+			printf("Pathfind Baseline: %s,%s,not in baseline\n", result.unitName.str(), s_queryNames[result.query]);
+			continue;
+		}
+
+		const Real change = base->meanMicros > 0.0f ? (result.meanMicros - base->meanMicros) * 100.0f / base->meanMicros : 0.0f;
+
+		const char* verdict = "ok";
+		if (result.queries != base->queries || result.found != base->found || result.checksum != base->checksum)
+			verdict = "PATHS CHANGED";
+		else if (change > tolerancePercent)
+			verdict = "REGRESSION";
+
+		if (strcmp(verdict, "ok") != 0)
+			success = FALSE;
+
+		printf("Pathfind Baseline: %s,%s,%.2f,%.2f,%+.1f,%u,%u,%s\n",
+			result.unitName.str(), s_queryNames[result.query],
+			result.meanMicros, base->meanMicros, change,
+			result.meanCells, base->meanCells,
+			verdict);
+	}
+
+	printf("Pathfind Baseline: %s with a tolerance of %.1f%%\n", success ? "passed" : "FAILED", tolerancePercent);
+	fflush(stdout);
+	return success;
+}
@@ -148,6 +148,20 @@ UnsignedInt GetGameLogicRandomSeedCRC( void )
 	return c.get();
 }
 
+// TheSuperHackers @feature The logic random state is not part of the save game, so replay
+// checkpoints need to capture and restore it separately to continue deterministically.
+void GetGameLogicRandomState( GameLogicRandomState *state )
+{
+	memcpy(state->seed, theGameLogicSeed, sizeof(state->seed));
+	state->baseSeed = theGameLogicBaseSeed;
+}
+
+void SetGameLogicRandomState( const GameLogicRandomState *state )
+{
+	memcpy(theGameLogicSeed, state->seed, sizeof(theGameLogicSeed));
+	theGameLogicBaseSeed = state->baseSeed;
+}
+
 void InitRandom( void )
 {
 #ifdef DETERMINISTIC
@@ -0,0 +1,279 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/ReplayBenchmark.h"
+
+#include <algorithm>
+
+namespace
+{
+const char* const s_resultTag = "Replay Result:";
+const char* const s_summaryTag = "Replay Summary:";
+const char* const s_csvHeader = "replay,frames,wall_ms,frames_per_sec,update_mean_us,update_p99_us,peak_pool_kb,crc,exit_code";
+
+void printResultCSV(FILE* fp, const char* prefix, const ReplayBenchmark::Result& result)
+{
+	fprintf(fp, "%s\"%s\",%u,%u,%.1f,%.1f,%.1f,%u,%08X,%u\n",
+		prefix, result.filename.str(), result.frames, result.wallMillis, result.getFramesPerSecond(),
+		result.meanUpdateMicros, result.p99UpdateMicros, result.peakPoolKB, result.crc, result.exitCode);
+}
+
+// Returns how much worse the value is than the baseline in percent. Higher values are worse unless lowerIsWorse.
+Real getRegressionPercent(Real value, Real baseline, Bool lowerIsWorse)
+{
+	if (baseline <= 0.0f)
+		return 0.0f;
+	const Real change = (value - baseline) * 100.0f / baseline;
+	return lowerIsWorse ? -change : change;
+}
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+ReplayBenchmark::Result::Result()
+	: frames(0)
+	, wallMillis(0)
+	, meanUpdateMicros(0.0f)
+	, p99UpdateMicros(0.0f)
+	, peakPoolKB(0)
+	, crc(0)
+	, exitCode(0)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+Real ReplayBenchmark::Result::getFramesPerSecond() const
+{
+	return wallMillis != 0 ? frames * 1000.0f / wallMillis : 0.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+ReplayBenchmark::ReplayBenchmark()
+	: m_updateStartTicks(0)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_ticksPerSecond = frequency.QuadPart;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayBenchmark::beginReplay()
+{
+	m_updateTicks.clear();
+	TheMemoryPoolFactory->resetPeakPoolBytes();
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayBenchmark::beginUpdate()
+{
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	m_updateStartTicks = ticks.QuadPart;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayBenchmark::endUpdate()
+{
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	m_updateTicks.push_back(ticks.QuadPart - m_updateStartTicks);
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayBenchmark::endReplay(Result& result) const
+{
+	result.meanUpdateMicros = 0.0f;
+	result.p99UpdateMicros = 0.0f;
+	if (!m_updateTicks.empty() && m_ticksPerSecond != 0)
+	{
+		const double microsPerTick = 1000000.0 / m_ticksPerSecond;
+
+		UnsignedInt64 totalTicks = 0;
+		for (size_t i = 0; i < m_updateTicks.size(); ++i)
+			totalTicks += m_updateTicks[i];
+		result.meanUpdateMicros = (Real)(totalTicks * microsPerTick / m_updateTicks.size());
+
+		std::vector<UnsignedInt64> sortedTicks(m_updateTicks);
+		const size_t p99Index = (sortedTicks.size() * 99) / 100;
+		std::nth_element(sortedTicks.begin(), sortedTicks.begin() + p99Index, sortedTicks.end());
+		result.p99UpdateMicros = (Real)(sortedTicks[p99Index] * microsPerTick);
+	}
+	result.peakPoolKB = (UnsignedInt)(TheMemoryPoolFactory->getPeakPoolBytes() / 1024);
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayBenchmark::printResult(const Result& result)
+{
+	printf("%s frames=%u wallMillis=%u updateMeanUs=%.1f updateP99Us=%.1f peakPoolKB=%u crc=%08X\n",
+		s_resultTag, result.frames, result.wallMillis, result.meanUpdateMicros, result.p99UpdateMicros, result.peakPoolKB, result.crc);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayBenchmark::parseResult(const AsciiString& output, Result& result)
+{
+	const char* tag = strstr(output.str(), s_resultTag);
+	if (tag == nullptr)
+		return FALSE;
+
+	unsigned int frames = 0;
+	unsigned int wallMillis = 0;
+	float meanUpdateMicros = 0.0f;
+	float p99UpdateMicros = 0.0f;
+	unsigned int peakPoolKB = 0;
+	unsigned int crc = 0;
+	if (sscanf(tag + strlen(s_resultTag), " frames=%u wallMillis=%u updateMeanUs=%f updateP99Us=%f peakPoolKB=%u crc=%X",
+			&frames, &wallMillis, &meanUpdateMicros, &p99UpdateMicros, &peakPoolKB, &crc) != 6)
+		return FALSE;
+
+	// The wall time of a worker is measured by the parent process, so it is not taken from the output.
+	result.frames = frames;
+	result.meanUpdateMicros = meanUpdateMicros;
+	result.p99UpdateMicros = p99UpdateMicros;
+	result.peakPoolKB = peakPoolKB;
+	result.crc = crc;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayBenchmark::printSummary(const ResultList& results)
+{
+	// CSV that can be consumed by scripts. Each line is prefixed so it can be grepped from the log.
+	AsciiString prefix;
+	prefix.format("%s ", s_summaryTag);
+	printf("%s%s\n", prefix.str(), s_csvHeader);
+	for (size_t i = 0; i < results.size(); ++i)
+		printResultCSV(stdout, prefix.str(), results[i]);
+	fflush(stdout);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayBenchmark::writeResults(const AsciiString& filename, const ResultList& results)
+{
+	FILE* fp = fopen(filename.str(), "wt");
+	if (fp == nullptr)
+		return FALSE;
+
+	fprintf(fp, "%s\n", s_csvHeader);
+	for (size_t i = 0; i < results.size(); ++i)
+		printResultCSV(fp, "", results[i]);
+
+	const Bool success = ferror(fp) == 0;
+	fclose(fp);
+	return success;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayBenchmark::readResults(const AsciiString& filename, ResultList& results)
+{
+	FILE* fp = fopen(filename.str(), "rt");
+	if (fp == nullptr)
+		return FALSE;
+
+	results.clear();
+	char line[1024];
+	while (fgets(line, sizeof(line), fp) != nullptr)
+	{
+		char replay[_MAX_PATH];
+		unsigned int frames = 0;
+		unsigned int wallMillis = 0;
+		float framesPerSec = 0.0f;
+		float meanUpdateMicros = 0.0f;
+		float p99UpdateMicros = 0.0f;
+		unsigned int peakPoolKB = 0;
+		unsigned int crc = 0;
+		unsigned int exitCode = 0;
+		// Skips the header and anything else that is not a result.
+		if (sscanf(line, "\"%259[^\"]\",%u,%u,%f,%f,%f,%u,%X,%u",
+				replay, &frames, &wallMillis, &framesPerSec, &meanUpdateMicros, &p99UpdateMicros, &peakPoolKB, &crc, &exitCode) != 9)
+			continue;
+
+		Result result;
+		result.filename = replay;
+		result.frames = frames;
+		result.wallMillis = wallMillis;
+		result.meanUpdateMicros = meanUpdateMicros;
+		result.p99UpdateMicros = p99UpdateMicros;
+		result.peakPoolKB = peakPoolKB;
+		result.crc = crc;
+		result.exitCode = exitCode;
+		results.push_back(result);
+	}
+
+	fclose(fp);
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+const ReplayBenchmark::Result* ReplayBenchmark::findResult(const ResultList& results, const AsciiString& filename)
+{
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		if (results[i].filename.compareNoCase(filename) == 0)
+			return &results[i];
+	}
+	return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Frames per second are compared instead of the mean update time, because they also include the
+	* time spent outside of GameLogic::UPDATE. A replay that was not in the baseline is reported, but
+	* does not fail the comparison. */
+//-------------------------------------------------------------------------------------------------
+Bool ReplayBenchmark::compareWithBaseline(const ResultList& results, const ResultList& baseline, Real tolerancePercent)
+{
+	Bool success = TRUE;
+
+	printf("Replay Baseline: replay,frames_per_sec,baseline,change%%,update_p99_us,baseline,change%%,peak_pool_kb,baseline,change%%,verdict\n");
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& result = results[i];
+		const Result* base = findResult(baseline, result.filename);
+		if (base == nullptr)
+		{
+			printf("Replay Baseline: \"%s\",not in baseline\n", result.filename.str());
+			continue;
+		}
+
+		const Real fpsRegression = getRegressionPercent(result.getFramesPerSecond(), base->getFramesPerSecond(), TRUE);
+		const Real p99Regression = getRegressionPercent(result.p99UpdateMicros, base->p99UpdateMicros, FALSE);
+		const Real poolRegression = getRegressionPercent((Real)result.peakPoolKB, (Real)base->peakPoolKB, FALSE);
+
+		const char* verdict = "ok";
+		if (result.exitCode != 0)
+			verdict = "FAILED";
+		else if (result.frames != base->frames || result.crc != base->crc)
+			verdict = "CRC CHANGED";
+		else if (fpsRegression > tolerancePercent || p99Regression > tolerancePercent || poolRegression > tolerancePercent)
+			verdict = "REGRESSION";
+
+		if (strcmp(verdict, "ok") != 0)
+			success = FALSE;
+
+		printf("Replay Baseline: \"%s\",%.1f,%.1f,%+.1f,%.1f,%.1f,%+.1f,%u,%u,%+.1f,%s\n",
+			result.filename.str(),
+			result.getFramesPerSecond(), base->getFramesPerSecond(), -fpsRegression,
+			result.p99UpdateMicros, base->p99UpdateMicros, p99Regression,
+			result.peakPoolKB, base->peakPoolKB, poolRegression,
+			verdict);
+	}
+
+	printf("Replay Baseline: %s with a tolerance of %.1f%%\n", success ? "passed" : "FAILED", tolerancePercent);
+	fflush(stdout);
+	return success;
+}
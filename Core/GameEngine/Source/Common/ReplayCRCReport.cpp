@@ -0,0 +1,424 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/ReplayCRCReport.h"
+
+#include "Common/CRCDebug.h"
+#include "Common/GameState.h"
+#include "Common/NameKeyGenerator.h"
+#include "Common/Recorder.h"
+#include "Common/ThingTemplate.h"
+#include "Common/XferSnapshotCRC.h"
+#include "GameClient/GameClient.h"
+#include "GameLogic/GameLogic.h"
+#include "GameLogic/Object.h"
+#include "GameLogic/Module/BehaviorModule.h"
+
+namespace
+{
+const char* const s_reportVersion = "ReplayCRCReport 1";
+
+// Converts the labels of the xfer entries to paths. Unlabeled snapshots are named by their index below the parent.
+void appendEntries(ReplayCRCReport::EntryList& entries, const XferSnapshotCRC::EntryList& xferEntries)
+{
+	std::vector<AsciiString> parents;
+	std::vector<Int> childCounts;
+	for (size_t i = 0; i < xferEntries.size(); ++i)
+	{
+		const XferSnapshotCRC::Entry& xferEntry = xferEntries[i];
+		childCounts.resize(xferEntry.depth + 1, 0);
+		parents.resize(xferEntry.depth);
+
+		AsciiString label = xferEntry.label;
+		if (label.isEmpty())
+			label.format("#%d", childCounts[xferEntry.depth]);
+		++childCounts[xferEntry.depth];
+
+		ReplayCRCReport::Entry entry;
+		entry.depth = xferEntry.depth;
+		entry.crc = xferEntry.crc;
+		entry.size = xferEntry.size;
+		for (size_t p = 0; p < parents.size(); ++p)
+		{
+			entry.path.concat(parents[p]);
+			entry.path.concat(" / ");
+		}
+		entry.path.concat(label);
+		entries.push_back(entry);
+
+		parents.push_back(label);
+	}
+}
+
+// Module snapshots are labeled with their tag. Add the module class, because tags are only unique per template.
+void addModuleNames(XferSnapshotCRC::EntryList& xferEntries, size_t begin, const Object* obj)
+{
+	for (size_t i = begin; i < xferEntries.size(); ++i)
+	{
+		XferSnapshotCRC::Entry& xferEntry = xferEntries[i];
+		if (xferEntry.depth != 1 || xferEntry.label.isEmpty())
+			continue;
+
+		for (BehaviorModule** module = obj->getBehaviorModules(); *module; ++module)
+		{
+			if (KEYNAME((*module)->getModuleTagNameKey()) == xferEntry.label)
+			{
+				xferEntry.label.concat(" ");
+				xferEntry.label.concat(KEYNAME((*module)->getModuleNameKey()));
+				break;
+			}
+		}
+	}
+}
+} // namespace
+
+ReplayCRCReport::ReplayCRCReport()
+	: m_firstFrame(0)
+	, m_detailFrame(0)
+{
+}
+
+Bool ReplayCRCReport::writeForMismatch(const AsciiString& replayFilename, UnsignedInt mismatchFrame, const AsciiString& reportFilename)
+{
+	// The CRC before the mismatching one matched, so the divergence happened after it.
+	const UnsignedInt crcInterval = REPLAY_CRC_INTERVAL > 0 ? REPLAY_CRC_INTERVAL : 1;
+
+	ReplayCRCReport report;
+	report.m_replayFilename = replayFilename;
+	report.m_firstFrame = mismatchFrame > crcInterval ? mismatchFrame - crcInterval : 0;
+
+	printf("CRC Report: Simulating frames %u to %u again\n", report.m_firstFrame, mismatchFrame);
+	fflush(stdout);
+
+	// Without a checkpoint before the divergence, simulate the whole replay again.
+	const Bool restored = TheRecorder->restorePlaybackCheckpoint(report.m_firstFrame);
+	if (!restored && !TheRecorder->simulateReplay(replayFilename))
+		return FALSE;
+	TheGameLogic->setGamePaused(FALSE);
+
+	Bool simulated = report.simulateFrames(mismatchFrame, nullptr);
+
+	// TheSuperHackers @bugfix The replay's own CRCs matched up to the mismatch. If the run from the checkpoint
+	// mismatches them earlier, it did not play like the recorded game, so simulate the whole replay again.
+	if (restored && (!simulated || TheRecorder->sawCRCMismatch()))
+	{
+		printf("CRC Report: The checkpoint does not reproduce the replay, simulating from frame 0\n");
+		fflush(stdout);
+
+		if (!TheRecorder->simulateReplay(replayFilename))
+			return FALSE;
+		TheGameLogic->setGamePaused(FALSE);
+
+		simulated = report.simulateFrames(mismatchFrame, nullptr);
+	}
+
+	if (!simulated)
+	{
+		printf("CRC Report: Cannot simulate the replay up to frame %u\n", mismatchFrame);
+		return FALSE;
+	}
+
+	if (!report.write(reportFilename))
+	{
+		printf("CRC Report: Cannot write \"%s\"\n", reportFilename.str());
+		return FALSE;
+	}
+
+	printf("CRC Report: Written to \"%s\". Simulate the replay with another build and -replayCRCReference \"%s\" to find the first diverging object.\n",
+		reportFilename.str(), reportFilename.str());
+	fflush(stdout);
+	return TRUE;
+}
+
+Bool ReplayCRCReport::writeForReference(const AsciiString& replayFilename, const AsciiString& referenceFilename, const AsciiString& reportFilename)
+{
+	ReplayCRCReport reference;
+	if (!reference.read(referenceFilename) || reference.m_frameCRCs.empty())
+	{
+		printf("CRC Report: Cannot read reference \"%s\"\n", referenceFilename.str());
+		return FALSE;
+	}
+
+	ReplayCRCReport report;
+	report.m_replayFilename = replayFilename;
+	report.m_firstFrame = reference.m_firstFrame;
+
+	const UnsignedInt lastFrame = reference.m_firstFrame + (UnsignedInt)reference.m_frameCRCs.size() - 1;
+	if (!report.simulateFrames(lastFrame, &reference))
+	{
+		printf("CRC Report: Cannot simulate the replay up to frame %u\n", lastFrame);
+		return FALSE;
+	}
+
+	// Don't overwrite the reference when no other file name was given.
+	const Bool canWrite = reportFilename.isNotEmpty() && reportFilename.compareNoCase(referenceFilename) != 0;
+	if (canWrite && !report.write(reportFilename))
+	{
+		printf("CRC Report: Cannot write \"%s\"\n", reportFilename.str());
+		return FALSE;
+	}
+
+	const Bool matches = report.m_detailFrame == lastFrame && report.getFrameCRC(lastFrame) == reference.getFrameCRC(lastFrame);
+	if (matches)
+	{
+		printf("CRC Report: No difference to the reference in frames %u to %u\n", reference.m_firstFrame, lastFrame);
+		fflush(stdout);
+		return TRUE;
+	}
+
+	printf("CRC Report: First diverging frame is %u, CRC %8.8X, reference CRC %8.8X\n",
+		report.m_detailFrame, report.getFrameCRC(report.m_detailFrame), reference.getFrameCRC(report.m_detailFrame));
+
+	if (reference.m_detailFrame == report.m_detailFrame)
+	{
+		report.printFirstDifference(reference);
+	}
+	else if (canWrite)
+	{
+		printf("CRC Report: Simulate the replay with the other build and -replayCRCReference \"%s\" to find the first diverging object.\n",
+			reportFilename.str());
+	}
+	fflush(stdout);
+	return FALSE;
+}
+
+// Continues the current playback up to the first frame of the report, then records the CRC of every frame until the
+// last frame or until the first frame that diverges from the reference. The details are collected on the final frame.
+Bool ReplayCRCReport::simulateFrames(UnsignedInt lastFrame, const ReplayCRCReport* reference)
+{
+	while (TheRecorder->isPlaybackInProgress() && TheGameLogic->getFrame() < m_firstFrame)
+	{
+		TheGameClient->updateHeadless();
+		TheGameLogic->UPDATE();
+	}
+
+	if (TheGameLogic->getFrame() != m_firstFrame)
+		return FALSE;
+
+	m_frameCRCs.clear();
+	while (true)
+	{
+		const UnsignedInt frame = TheGameLogic->getFrame();
+		const UnsignedInt crc = TheGameLogic->getCRC(CRC_RECALC);
+		m_frameCRCs.push_back(crc);
+
+		if (frame >= lastFrame)
+			break;
+		if (reference != nullptr && reference->hasFrameCRC(frame) && reference->getFrameCRC(frame) != crc)
+			break;
+		if (!TheRecorder->isPlaybackInProgress())
+			return FALSE;
+
+		TheGameClient->updateHeadless();
+		TheGameLogic->UPDATE();
+	}
+
+	m_detailFrame = TheGameLogic->getFrame();
+	collectDetails();
+	return TRUE;
+}
+
+void ReplayCRCReport::collectDetails()
+{
+	m_entries.clear();
+
+	// The logic blocks of the save game, see GameState::init.
+	XferSnapshotCRC blockXfer(1);
+	blockXfer.open("ReplayCRCReportBlocks");
+	TheGameState->friend_xferSaveDataForCRC(&blockXfer, SNAPSHOT_DEEPCRC_LOGICONLY);
+	blockXfer.close();
+	appendEntries(m_entries, blockXfer.getEntries());
+
+	// Every object with its modules. The objects in the game logic block are only numbered.
+	XferSnapshotCRC objectXfer(2);
+	objectXfer.open("ReplayCRCReportObjects");
+	for (Object* obj = TheGameLogic->getFirstObject(); obj; obj = obj->getNextObject())
+	{
+		AsciiString label;
+		label.format("Object %u %s", (UnsignedInt)obj->getID(), obj->getTemplate()->getName().str());
+
+		const size_t begin = objectXfer.getEntries().size();
+		objectXfer.setNextLabel(label);
+		objectXfer.xferSnapshot(obj);
+		addModuleNames(objectXfer.getEntries(), begin, obj);
+	}
+	objectXfer.close();
+	appendEntries(m_entries, objectXfer.getEntries());
+}
+
+Bool ReplayCRCReport::write(const AsciiString& filename) const
+{
+	FILE* fp = fopen(filename.str(), "wt");
+	if (fp == nullptr)
+		return FALSE;
+
+	fprintf(fp, "%s\n", s_reportVersion);
+	fprintf(fp, "Replay %s\n", m_replayFilename.str());
+	fprintf(fp, "FirstFrame %u\n", m_firstFrame);
+	for (size_t i = 0; i < m_frameCRCs.size(); ++i)
+		fprintf(fp, "FrameCRC %u %8.8X\n", m_firstFrame + (UnsignedInt)i, m_frameCRCs[i]);
+	fprintf(fp, "DetailFrame %u\n", m_detailFrame);
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		const Entry& entry = m_entries[i];
+		fprintf(fp, "Entry %d %8.8X %u %s\n", entry.depth, entry.crc, entry.size, entry.path.str());
+	}
+
+	fclose(fp);
+	return TRUE;
+}
+
+Bool ReplayCRCReport::read(const AsciiString& filename)
+{
+	FILE* fp = fopen(filename.str(), "rt");
+	if (fp == nullptr)
+		return FALSE;
+
+	char line[1024];
+	Bool valid = fgets(line, sizeof(line), fp) != nullptr && strncmp(line, s_reportVersion, strlen(s_reportVersion)) == 0;
+	while (valid && fgets(line, sizeof(line), fp) != nullptr)
+	{
+		AsciiString text = line;
+		text.trim();
+
+		unsigned int frame = 0;
+		unsigned int crc = 0;
+		unsigned int size = 0;
+		int depth = 0;
+		int pathOffset = 0;
+		if (sscanf(text.str(), "FrameCRC %u %x", &frame, &crc) == 2)
+		{
+			valid = frame == m_firstFrame + m_frameCRCs.size();
+			m_frameCRCs.push_back(crc);
+		}
+		else if (sscanf(text.str(), "Entry %d %x %u %n", &depth, &crc, &size, &pathOffset) == 3 && pathOffset > 0)
+		{
+			Entry entry;
+			entry.depth = depth;
+			entry.crc = crc;
+			entry.size = size;
+			entry.path = text.str() + pathOffset;
+			m_entries.push_back(entry);
+		}
+		else if (sscanf(text.str(), "FirstFrame %u", &frame) == 1)
+		{
+			m_firstFrame = frame;
+		}
+		else if (sscanf(text.str(), "DetailFrame %u", &frame) == 1)
+		{
+			m_detailFrame = frame;
+		}
+		else if (text.startsWith("Replay "))
+		{
+			m_replayFilename = text.str() + strlen("Replay ");
+		}
+	}
+
+	fclose(fp);
+	return valid;
+}
+
+Bool ReplayCRCReport::hasFrameCRC(UnsignedInt frame) const
+{
+	return frame >= m_firstFrame && frame - m_firstFrame < m_frameCRCs.size();
+}
+
+UnsignedInt ReplayCRCReport::getFrameCRC(UnsignedInt frame) const
+{
+	return hasFrameCRC(frame) ? m_frameCRCs[frame - m_firstFrame] : 0;
+}
+
+const ReplayCRCReport::Entry* ReplayCRCReport::findEntry(const AsciiString& path) const
+{
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		if (m_entries[i].path == path)
+			return &m_entries[i];
+	}
+	return nullptr;
+}
+
+Bool ReplayCRCReport::isObjectEntry(const Entry& entry)
+{
+	return entry.path.startsWith("Object ");
+}
+
+Bool ReplayCRCReport::divergesFrom(const Entry& entry, const ReplayCRCReport& reference, UnsignedInt* referenceCRC)
+{
+	const Entry* referenceEntry = reference.findEntry(entry.path);
+	*referenceCRC = referenceEntry != nullptr ? referenceEntry->crc : 0;
+	return referenceEntry == nullptr || referenceEntry->crc != entry.crc || referenceEntry->size != entry.size;
+}
+
+// Prints the diverging save game blocks, then descends into the first diverging object on every depth,
+// so that the innermost printed snapshot is the first diverging module of that object.
+void ReplayCRCReport::printFirstDifference(const ReplayCRCReport& reference) const
+{
+	UnsignedInt referenceCRC = 0;
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		const Entry& entry = m_entries[i];
+		if (entry.depth == 0 && !isObjectEntry(entry) && divergesFrom(entry, reference, &referenceCRC))
+			printf("CRC Report: Diverging block %s, CRC %8.8X, reference CRC %8.8X\n", entry.path.str(), entry.crc, referenceCRC);
+	}
+
+	Int searchDepth = 0;
+	Bool descending = TRUE;
+	Int numDiverging = 0;
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		const Entry& entry = m_entries[i];
+		if (!isObjectEntry(entry))
+			continue;
+
+		// Stop descending when leaving the diverging snapshot that was found last.
+		if (searchDepth > 0 && entry.depth < searchDepth)
+			descending = FALSE;
+
+		if (entry.depth != 0 && (!descending || entry.depth != searchDepth))
+			continue;
+		if (!divergesFrom(entry, reference, &referenceCRC))
+			continue;
+
+		if (entry.depth == 0)
+			++numDiverging;
+		if (descending && entry.depth == searchDepth)
+		{
+			printf("CRC Report: %s %s, CRC %8.8X, reference CRC %8.8X\n",
+				searchDepth == 0 ? "First diverging" : "Diverging", entry.path.str(), entry.crc, referenceCRC);
+			++searchDepth;
+		}
+	}
+
+	for (size_t i = 0; i < reference.m_entries.size(); ++i)
+	{
+		const Entry& referenceEntry = reference.m_entries[i];
+		if (referenceEntry.depth == 0 && isObjectEntry(referenceEntry) && findEntry(referenceEntry.path) == nullptr)
+		{
+			printf("CRC Report: %s only exists in the reference\n", referenceEntry.path.str());
+			++numDiverging;
+		}
+	}
+
+	if (numDiverging == 0)
+		printf("CRC Report: All objects match the reference\n");
+	else
+		printf("CRC Report: %d objects diverge on frame %u\n", numDiverging, m_detailFrame);
+}
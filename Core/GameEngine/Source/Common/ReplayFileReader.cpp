@@ -0,0 +1,449 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/ReplayFileReader.h"
+
+#include "Common/crc.h"
+#include "Common/file.h"
+#include "Common/FileSystem.h"
+#include "Common/MessageStream.h"
+
+#include <algorithm>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+const char s_sidecarTag[] = "GENIDX";
+const UnsignedInt s_sidecarVersion = 1;
+const Int s_maxStringLength = 1024;	///< matches the buffers RecorderClass used to read strings
+
+// Returns the size of an argument in the replay file, see RecorderClass::writeArgument.
+Int getArgumentSize(UnsignedByte type)
+{
+	switch (type)
+	{
+		case ARGUMENTDATATYPE_INTEGER:			return sizeof(Int);
+		case ARGUMENTDATATYPE_REAL:					return sizeof(Real);
+		case ARGUMENTDATATYPE_BOOLEAN:			return sizeof(Bool);
+		case ARGUMENTDATATYPE_OBJECTID:			return sizeof(ObjectID);
+		case ARGUMENTDATATYPE_DRAWABLEID:		return sizeof(DrawableID);
+		case ARGUMENTDATATYPE_TEAMID:				return sizeof(UnsignedInt);
+		case ARGUMENTDATATYPE_LOCATION:			return sizeof(Coord3D);
+		case ARGUMENTDATATYPE_PIXEL:				return sizeof(ICoord2D);
+		case ARGUMENTDATATYPE_PIXELREGION:	return sizeof(IRegion2D);
+		case ARGUMENTDATATYPE_TIMESTAMP:		return sizeof(UnsignedInt);
+		case ARGUMENTDATATYPE_WIDECHAR:			return sizeof(WideChar);
+		default:														return 0;	// RecorderClass::readArgument reads nothing either
+	}
+}
+
+bool lessCommandFrame(const ReplayFrameIndex::Command& command, UnsignedInt frame)
+{
+	return command.frame < frame;
+}
+
+bool lessCommandStatsType(const ReplayFrameIndex::CommandStats& a, const ReplayFrameIndex::CommandStats& b)
+{
+	return a.type < b.type;
+}
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+ReplayFileReader::ReplayFileReader()
+	: m_data(nullptr)
+	, m_size(0)
+	, m_position(0)
+#ifdef _WIN32
+	, m_fileHandle(INVALID_HANDLE_VALUE)
+	, m_mappingHandle(nullptr)
+#else
+	, m_isMapped(FALSE)
+#endif
+	, m_fileData(nullptr)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+ReplayFileReader::~ReplayFileReader()
+{
+	close();
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayFileReader::open(const AsciiString& filepath)
+{
+	close();
+
+#ifdef _WIN32
+	m_fileHandle = CreateFileA(filepath.str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+	{
+		const DWORD fileSize = GetFileSize(m_fileHandle, nullptr);
+		if (fileSize != INVALID_FILE_SIZE && fileSize != 0)
+			m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mappingHandle != nullptr)
+		{
+			m_data = static_cast<const UnsignedByte*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+			m_size = (Int)fileSize;
+		}
+	}
+#else
+	const int fd = ::open(filepath.str(), O_RDONLY);
+	if (fd >= 0)
+	{
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0 && fileStat.st_size <= INT_MAX)
+		{
+			void* mapping = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapping != MAP_FAILED)
+			{
+				m_data = static_cast<const UnsignedByte*>(mapping);
+				m_size = (Int)fileStat.st_size;
+				m_isMapped = TRUE;
+			}
+		}
+		// The mapping stays valid after the file is closed.
+		::close(fd);
+	}
+#endif
+
+	if (m_data == nullptr)
+	{
+		close();
+
+		File* file = TheFileSystem->openFile(filepath.str(), File::READ | File::BINARY);
+		if (file == nullptr)
+			return FALSE;
+
+		m_size = file->size();
+		m_fileData = file->readEntireAndClose();
+		m_data = reinterpret_cast<const UnsignedByte*>(m_fileData);
+	}
+
+	m_position = 0;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayFileReader::close()
+{
+#ifdef _WIN32
+	if (m_mappingHandle != nullptr)
+	{
+		if (m_data != nullptr)
+			UnmapViewOfFile(m_data);
+		CloseHandle(m_mappingHandle);
+		m_mappingHandle = nullptr;
+	}
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (m_isMapped)
+	{
+		munmap(const_cast<UnsignedByte*>(m_data), (size_t)m_size);
+		m_isMapped = FALSE;
+	}
+#endif
+
+	delete [] m_fileData;
+	m_fileData = nullptr;
+	m_data = nullptr;
+	m_size = 0;
+	m_position = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayFileReader::seek(Int position)
+{
+	if (position < 0 || position > m_size)
+		return FALSE;
+
+	m_position = position;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayFileReader::skip(Int bytes)
+{
+	if (bytes < 0 || bytes > m_size - m_position)
+		return FALSE;
+
+	m_position += bytes;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayFileReader::read(void* buffer, Int bytes)
+{
+	if (bytes < 0 || bytes > m_size - m_position)
+		return FALSE;
+
+	memcpy(buffer, m_data + m_position, bytes);
+	m_position += bytes;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+AsciiString ReplayFileReader::readAsciiString()
+{
+	const char* str = reinterpret_cast<const char*>(m_data + m_position);
+	const Int maxLength = m_size - m_position;
+	Int length = 0;
+	while (length < maxLength && str[length] != '\0')
+		++length;
+
+	AsciiString retval;
+	retval.set(str, std::min(length, s_maxStringLength - 1));
+
+	// Skips the terminator as well.
+	m_position += std::min(length + 1, maxLength);
+	return retval;
+}
+
+//-------------------------------------------------------------------------------------------------
+UnicodeString ReplayFileReader::readUnicodeString()
+{
+	WideChar str[s_maxStringLength];
+	Int length = 0;
+	while (length < s_maxStringLength - 1 && read(str[length]) && str[length] != L'\0')
+		++length;
+	str[length] = L'\0';
+
+	// Skips the rest of a string that is too long.
+	WideChar c = L'\0';
+	if (length == s_maxStringLength - 1)
+	{
+		while (read(c) && c != L'\0')
+		{
+		}
+	}
+
+	return UnicodeString(str);
+}
+
+//-------------------------------------------------------------------------------------------------
+UnsignedInt ReplayFileReader::computeCRC(Int offset, Int bytes) const
+{
+	CRC crc;
+	if (offset >= 0 && bytes > 0 && bytes <= m_size - offset)
+		crc.computeCRC(m_data + offset, bytes);
+	return crc.get();
+}
+
+//-------------------------------------------------------------------------------------------------
+ReplayFrameIndex::ReplayFrameIndex()
+	: m_commandsOffset(0)
+	, m_fileSize(0)
+	, m_headerCRC(0)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayFrameIndex::clear()
+{
+	m_commands.clear();
+	m_commandsOffset = 0;
+	m_fileSize = 0;
+	m_headerCRC = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The layout of a command matches RecorderClass::writeToFile. A command that is cut off by the end
+	* of the file is not indexed. */
+//-------------------------------------------------------------------------------------------------
+Bool ReplayFrameIndex::build(ReplayFileReader& reader, Int commandsOffset)
+{
+	clear();
+
+	const Int startPosition = reader.position();
+	if (!reader.seek(commandsOffset))
+		return FALSE;
+
+	m_commandsOffset = commandsOffset;
+	m_fileSize = reader.size();
+	m_headerCRC = reader.computeCRC(0, commandsOffset);
+
+	Bool success = TRUE;
+	while (!reader.isEnd())
+	{
+		Command command;
+		command.offset = reader.position();
+
+		UnsignedByte numTypes = 0;
+		if (!reader.read(command.frame) || !reader.read(command.type) || !reader.read(command.playerIndex) || !reader.read(numTypes))
+		{
+			success = FALSE;
+			break;
+		}
+
+		Int argumentBytes = 0;
+		for (UnsignedByte i = 0; i < numTypes; ++i)
+		{
+			UnsignedByte type = (UnsignedByte)ARGUMENTDATATYPE_UNKNOWN;
+			UnsignedByte numArgs = 0;
+			if (!reader.read(type) || !reader.read(numArgs))
+			{
+				success = FALSE;
+				break;
+			}
+			argumentBytes += getArgumentSize(type) * numArgs;
+		}
+
+		if (!success || !reader.skip(argumentBytes))
+		{
+			success = FALSE;
+			break;
+		}
+
+		DEBUG_ASSERTCRASH(m_commands.empty() || m_commands.back().frame <= command.frame,
+			("ReplayFrameIndex::build - Command on frame %u follows a command on frame %u", command.frame, m_commands.back().frame));
+		m_commands.push_back(command);
+	}
+
+	reader.seek(startPosition);
+	return success;
+}
+
+//-------------------------------------------------------------------------------------------------
+Int ReplayFrameIndex::getOffsetForFrame(UnsignedInt frame) const
+{
+	CommandList::const_iterator it = std::lower_bound(m_commands.begin(), m_commands.end(), frame, lessCommandFrame);
+	return it != m_commands.end() ? it->offset : m_fileSize;
+}
+
+//-------------------------------------------------------------------------------------------------
+UnsignedInt ReplayFrameIndex::getLastCommandFrame() const
+{
+	return m_commands.empty() ? 0 : m_commands.back().frame;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayFrameIndex::getCommandStats(CommandStatsList& stats) const
+{
+	stats.clear();
+	for (size_t i = 0; i < m_commands.size(); ++i)
+	{
+		const Command& command = m_commands[i];
+
+		size_t s = 0;
+		while (s < stats.size() && stats[s].type != command.type)
+			++s;
+
+		if (s == stats.size())
+		{
+			CommandStats newStats;
+			newStats.type = command.type;
+			newStats.count = 0;
+			newStats.firstFrame = command.frame;
+			stats.push_back(newStats);
+		}
+
+		++stats[s].count;
+		stats[s].lastFrame = command.frame;
+	}
+
+	std::sort(stats.begin(), stats.end(), lessCommandStatsType);
+}
+
+//-------------------------------------------------------------------------------------------------
+AsciiString ReplayFrameIndex::getSidecarFilename(const AsciiString& replayFilepath)
+{
+	AsciiString filename = replayFilepath;
+	filename.concat(".idx");
+	return filename;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayFrameIndex::writeSidecar(const AsciiString& filename) const
+{
+	if (!isValid())
+		return FALSE;
+
+	FILE* fp = fopen(filename.str(), "wb");
+	if (fp == nullptr)
+		return FALSE;
+
+	const UnsignedInt count = (UnsignedInt)m_commands.size();
+	fwrite(s_sidecarTag, sizeof(s_sidecarTag) - 1, 1, fp);
+	fwrite(&s_sidecarVersion, sizeof(s_sidecarVersion), 1, fp);
+	fwrite(&m_fileSize, sizeof(m_fileSize), 1, fp);
+	fwrite(&m_commandsOffset, sizeof(m_commandsOffset), 1, fp);
+	fwrite(&m_headerCRC, sizeof(m_headerCRC), 1, fp);
+	fwrite(&count, sizeof(count), 1, fp);
+	if (count != 0)
+		fwrite(&m_commands[0], sizeof(Command), count, fp);
+
+	const Bool success = ferror(fp) == 0;
+	fclose(fp);
+	return success;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayFrameIndex::readSidecar(const AsciiString& filename, const ReplayFileReader& reader, Int commandsOffset)
+{
+	clear();
+
+	FILE* fp = fopen(filename.str(), "rb");
+	if (fp == nullptr)
+		return FALSE;
+
+	char tag[sizeof(s_sidecarTag) - 1];
+	UnsignedInt version = 0;
+	Int fileSize = 0;
+	Int sidecarCommandsOffset = 0;
+	UnsignedInt headerCRC = 0;
+	UnsignedInt count = 0;
+	Bool success =
+		fread(tag, sizeof(tag), 1, fp) == 1 && memcmp(tag, s_sidecarTag, sizeof(tag)) == 0 &&
+		fread(&version, sizeof(version), 1, fp) == 1 && version == s_sidecarVersion &&
+		fread(&fileSize, sizeof(fileSize), 1, fp) == 1 && fileSize == reader.size() &&
+		fread(&sidecarCommandsOffset, sizeof(sidecarCommandsOffset), 1, fp) == 1 && sidecarCommandsOffset == commandsOffset &&
+		fread(&headerCRC, sizeof(headerCRC), 1, fp) == 1 && headerCRC == reader.computeCRC(0, commandsOffset) &&
+		fread(&count, sizeof(count), 1, fp) == 1 && count <= (UnsignedInt)fileSize;
+
+	if (success)
+	{
+		m_commands.resize(count);
+		if (count != 0)
+			success = fread(&m_commands[0], sizeof(Command), count, fp) == count;
+	}
+
+	fclose(fp);
+
+	if (!success)
+	{
+		clear();
+		return FALSE;
+	}
+
+	m_commandsOffset = commandsOffset;
+	m_fileSize = fileSize;
+	m_headerCRC = headerCRC;
+	return TRUE;
+}
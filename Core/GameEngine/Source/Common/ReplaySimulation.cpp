@@ -23,10 +23,19 @@
 #include "Common/GameEngine.h"
 #include "Common/LocalFileSystem.h"
 #include "Common/Recorder.h"
+#include "Common/ReplayBenchmark.h"
+#include "Common/ReplayCRCReport.h"
 #include "Common/WorkerProcess.h"
+#include "GameLogic/AI.h"
+#include "GameLogic/AIPathfind.h"
 #include "GameLogic/GameLogic.h"
+#include "GameLogic/UpdateProfiler.h"
 #include "GameClient/GameClient.h"
 
+#include <algorithm>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 Bool ReplaySimulation::s_isRunning = false;
 UnsignedInt ReplaySimulation::s_replayIndex = 0;
@@ -45,6 +54,139 @@ int countProcessesRunning(const std::vector<WorkerProcess>& processes)
 	}
 	return numProcessesRunning;
 }
+
+struct ReplayJob
+{
+	AsciiString filename;
+	UnsignedInt frameCount;
+	size_t resultIndex;
+};
+
+// Longest replays go first so that a long replay does not end up as the last job keeping one worker busy
+// while all others are idle. Replays with equal length keep their original order.
+bool isLongerReplayJob(const ReplayJob& a, const ReplayJob& b)
+{
+	return a.frameCount > b.frameCount;
+}
+
+// TheSuperHackers @feature Write the results for -replayBench and compare them with -replayBenchBaseline.
+// Returns false if the results regressed or could not be written or compared.
+Bool finishReplayBenchmark(const ReplayBenchmark::ResultList& results)
+{
+	Bool success = TRUE;
+	if (TheGlobalData->m_replayBenchFileName.isNotEmpty())
+	{
+		if (ReplayBenchmark::writeResults(TheGlobalData->m_replayBenchFileName, results))
+			printf("Replay benchmark written to \"%s\"\n", TheGlobalData->m_replayBenchFileName.str());
+		else
+		{
+			printf("Cannot write replay benchmark \"%s\"\n", TheGlobalData->m_replayBenchFileName.str());
+			success = FALSE;
+		}
+	}
+	if (TheGlobalData->m_replayBenchBaselineFileName.isNotEmpty())
+	{
+		ReplayBenchmark::ResultList baseline;
+		if (!ReplayBenchmark::readResults(TheGlobalData->m_replayBenchBaselineFileName, baseline))
+		{
+			printf("Cannot read replay benchmark baseline \"%s\"\n", TheGlobalData->m_replayBenchBaselineFileName.str());
+			success = FALSE;
+		}
+		else if (!ReplayBenchmark::compareWithBaseline(results, baseline, TheGlobalData->m_replayBenchTolerance))
+		{
+			success = FALSE;
+		}
+	}
+	fflush(stdout);
+	return success;
+}
+
+// TheSuperHackers @feature Show how long the pathfind requests of the replay waited and how much they searched.
+void printPathfindQueueStats()
+{
+	const PathfindQueueStats& stats = TheAI->pathfinder()->getQueueStats();
+	if (stats.m_requests == 0)
+		return;
+	printf("Pathfind queue: %u requests (%u player), wait mean %.1f max %u frames, cells mean %u max %u, max depth %u, backlog frames %u, shared corridor paths %u, flow field paths %u\n",
+		stats.m_requests, stats.m_playerRequests,
+		(double)stats.m_totalWaitFrames / stats.m_requests, stats.m_maxWaitFrames,
+		stats.m_totalCells / stats.m_requests, stats.m_maxCells,
+		stats.m_maxQueueDepth, stats.m_backlogFrames, stats.m_sharedCorridorPaths, stats.m_flowFieldPaths);
+}
+
+// TheSuperHackers @bugfix These options write one file for all replays, which the worker processes would overwrite
+// or clobber concurrently. Returns the first one that is set.
+const char* getOptionNotSupportedByWorkers()
+{
+	if (TheGlobalData->m_updateProfileFileName.isNotEmpty())
+		return "-profileUpdates";
+	if (TheGlobalData->m_scriptProfileFileName.isNotEmpty())
+		return "-profileScripts";
+	if (TheGlobalData->m_replayCRCReportFileName.isNotEmpty())
+		return "-replayCRCReport";
+	if (TheGlobalData->m_replayCRCReferenceFileName.isNotEmpty())
+		return "-replayCRCReference";
+	if (TheGlobalData->m_memoryPoolSizesFileName.isNotEmpty())
+		return "-memoryPoolSizes";
+	return nullptr;
+}
+
+void addWorkerArg(std::vector<UnicodeString>& args, const WideChar* arg)
+{
+	args.push_back(UnicodeString(arg));
+}
+
+void addWorkerArg(std::vector<UnicodeString>& args, const WideChar* arg, UnsignedInt value)
+{
+	UnicodeString valueString;
+	valueString.format(L"%u", value);
+	args.push_back(UnicodeString(arg));
+	args.push_back(valueString);
+}
+
+// Passes the options that apply to every single replay on to the worker processes.
+std::vector<UnicodeString> getWorkerArgs(const UnicodeString& exePath, const AsciiString& filename)
+{
+	std::vector<UnicodeString> args;
+	args.push_back(exePath);
+	if (TheGlobalData->m_windowed)
+		addWorkerArg(args, L"-win");
+	if (TheGlobalData->m_headless)
+		addWorkerArg(args, L"-headless");
+	if (TheGlobalData->m_headlessClientEffects)
+		addWorkerArg(args, L"-headlessClientEffects");
+	if (TheGlobalData->m_replayCheckpointInterval != 0)
+	{
+		addWorkerArg(args, L"-replayCheckpoints", TheGlobalData->m_replayCheckpointInterval);
+		addWorkerArg(args, L"-replayCheckpointMemory", TheGlobalData->m_replayCheckpointMemoryMB);
+	}
+	if (TheGlobalData->m_replayIndexSidecars)
+		addWorkerArg(args, L"-replayIndex");
+	if (TheGlobalData->m_pathfindTimeBudgetMicros > 0)
+		addWorkerArg(args, L"-pathfindTimeBudget", (UnsignedInt)TheGlobalData->m_pathfindTimeBudgetMicros);
+
+	UnicodeString filenameWide;
+	filenameWide.translate(filename);
+	addWorkerArg(args, L"-replay");
+	args.push_back(filenameWide);
+	return args;
+}
+
+UnicodeString getExecutablePath()
+{
+	UnicodeString path;
+#ifdef _WIN32
+	WideChar exePath[1024];
+	GetModuleFileNameW(nullptr, exePath, ARRAY_SIZE(exePath));
+	path = exePath;
+#else
+	char exePath[1024];
+	ssize_t len = readlink("/proc/self/exe", exePath, ARRAY_SIZE(exePath)-1);
+	exePath[len > 0 ? len : 0] = 0;
+	path.translate(AsciiString(exePath));
+#endif
+	return path;
+}
 } // namespace
 
 int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString> &filenames)
@@ -75,16 +217,31 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 	}
 	// Note that we use printf here because this is run from cmd.
 	DWORD totalStartTimeMillis = GetTickCount();
+	ReplayBenchmark::ResultList results(filenames.size());
+	ReplayBenchmark benchmark;
+	const Bool compareCRCReference = TheGlobalData->m_replayCRCReferenceFileName.isNotEmpty();
+	Bool wroteCRCReport = FALSE;
+	if (TheGlobalData->m_updateProfileFileName.isNotEmpty())
+		TheUpdateProfiler = NEW UpdateProfiler;
 	for (size_t i = 0; i < filenames.size(); i++)
 	{
 		AsciiString filename = filenames[i];
 		printf("Simulating Replay \"%s\"\n", filename.str());
 		fflush(stdout);
 		DWORD startTimeMillis = GetTickCount();
+		results[i].filename = filename;
+		const Int numErrorsBefore = numErrors;
+		benchmark.beginReplay();
 		if (TheRecorder->simulateReplay(filename))
 		{
 			UnsignedInt totalTimeSec = TheRecorder->getPlaybackFrameCount() / LOGICFRAMES_PER_SECOND;
-			while (TheRecorder->isPlaybackInProgress())
+			if (compareCRCReference)
+			{
+				// Only the frames of the reference report are simulated.
+				if (!ReplayCRCReport::writeForReference(filename, TheGlobalData->m_replayCRCReferenceFileName, TheGlobalData->m_replayCRCReportFileName))
+					numErrors++;
+			}
+			while (!compareCRCReference && TheRecorder->isPlaybackInProgress())
 			{
 				TheGameClient->updateHeadless();
 
@@ -98,7 +255,9 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 							realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
 					fflush(stdout);
 				}
+				benchmark.beginUpdate();
 				TheGameLogic->UPDATE();
+				benchmark.endUpdate();
 				if (TheRecorder->sawCRCMismatch())
 				{
 					numErrors++;
@@ -109,17 +268,46 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 			UnsignedInt realTimeSec = (GetTickCount()-startTimeMillis) / 1000;
 			printf("Elapsed Time: %02d:%02d Game Time: %02d:%02d/%02d:%02d\n",
 					realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
+			results[i].frames = TheGameLogic->getFrame();
+			results[i].wallMillis = GetTickCount()-startTimeMillis;
+			results[i].crc = TheGameLogic->getCRC(CRC_RECALC);
+			benchmark.endReplay(results[i]);
+			ReplayBenchmark::printResult(results[i]);
+			printPathfindQueueStats();
 			fflush(stdout);
+
+			// TheSuperHackers @feature Narrow down the first mismatch to the diverging object.
+			if (!compareCRCReference && !wroteCRCReport && TheGlobalData->m_replayCRCReportFileName.isNotEmpty() && TheRecorder->sawCRCMismatch())
+			{
+				wroteCRCReport = TRUE;
+				ReplayCRCReport::writeForMismatch(filename, TheRecorder->getCRCMismatchFrame(), TheGlobalData->m_replayCRCReportFileName);
+			}
 		}
 		else
 		{
 			printf("Cannot open replay\n");
 			numErrors++;
 		}
+		results[i].exitCode = numErrors != numErrorsBefore ? 1 : 0;
 	}
+	if (TheUpdateProfiler != nullptr)
+	{
+		if (TheUpdateProfiler->writeReport(TheGlobalData->m_updateProfileFileName))
+			printf("Update profile written to \"%s\"\n", TheGlobalData->m_updateProfileFileName.str());
+		else
+			printf("Cannot write update profile \"%s\"\n", TheGlobalData->m_updateProfileFileName.str());
+		fflush(stdout);
+		delete TheUpdateProfiler;
+		TheUpdateProfiler = nullptr;
+	}
+
+	if (!finishReplayBenchmark(results))
+		numErrors++;
+
 	if (filenames.size() > 1)
 	{
 		printf("Simulation of all replays completed. Errors occurred: %d\n", numErrors);
+		ReplayBenchmark::printSummary(results);
 
 		UnsignedInt realTime = (GetTickCount()-totalStartTimeMillis) / 1000;
 		printf("Total Time: %d:%02d:%02d\n", realTime/60/60, realTime/60%60, realTime%60);
@@ -131,54 +319,87 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 
 int ReplaySimulation::simulateReplaysInWorkerProcesses(const std::vector<AsciiString> &filenames, int maxProcesses)
 {
+	const char* unsupportedOption = getOptionNotSupportedByWorkers();
+	if (unsupportedOption != nullptr)
+	{
+		printf("%s cannot be combined with -jobs, simulate the replays without -jobs instead\n", unsupportedOption);
+		fflush(stdout);
+		return 1;
+	}
+
 	DWORD totalStartTimeMillis = GetTickCount();
 
-	WideChar exePath[1024];
-	GetModuleFileNameW(nullptr, exePath, ARRAY_SIZE(exePath));
+	UnicodeString exePath = getExecutablePath();
+
+	// TheSuperHackers @performance Schedule the replays by their recorded frame count, longest first.
+	ReplayBenchmark::ResultList results(filenames.size());
+	std::vector<ReplayJob> jobs(filenames.size());
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		RecorderClass::ReplayHeader header;
+		header.forPlayback = FALSE;
+		header.filename = filenames[i];
+		header.frameCount = 0;
+		if (!TheRecorder->readReplayHeader(header))
+			header.frameCount = 0;
+
+		results[i].filename = filenames[i];
+		jobs[i].filename = filenames[i];
+		jobs[i].frameCount = header.frameCount;
+		jobs[i].resultIndex = i;
+	}
+	std::stable_sort(jobs.begin(), jobs.end(), isLongerReplayJob);
 
 	std::vector<WorkerProcess> processes;
+	std::vector<size_t> processJobs;
+	std::vector<DWORD> processStartTimes;
 	int filenamePositionStarted = 0;
 	int filenamePositionDone = 0;
 	int numErrors = 0;
 
 	while (true)
 	{
-		int i;
+		size_t i;
 		for (i = 0; i < processes.size(); i++)
 			processes[i].update();
 
-		// Get result of finished processes and print output in order
-		while (!processes.empty())
+		// Get result of finished processes and print output as soon as they finish
+		for (i = 0; i < processes.size(); )
 		{
-			if (!processes[0].isDone())
-				break;
-			AsciiString stdOutput = processes[0].getStdOutput();
+			if (!processes[i].isDone())
+			{
+				++i;
+				continue;
+			}
+			const ReplayJob& job = jobs[processJobs[i]];
+			ReplayBenchmark::Result& result = results[job.resultIndex];
+			AsciiString stdOutput = processes[i].getStdOutput();
 			printf("%d/%d %s", filenamePositionDone+1, (int)filenames.size(), stdOutput.str());
-			DWORD exitcode = processes[0].getExitCode();
+			UnsignedInt exitcode = processes[i].getExitCode();
 			if (exitcode != 0)
 				printf("Error!\n");
 			fflush(stdout);
 			numErrors += exitcode == 0 ? 0 : 1;
-			processes.erase(processes.begin());
+
+			result.exitCode = exitcode;
+			result.wallMillis = GetTickCount() - processStartTimes[i];
+			ReplayBenchmark::parseResult(stdOutput, result);
+
+			processes.erase(processes.begin() + i);
+			processJobs.erase(processJobs.begin() + i);
+			processStartTimes.erase(processStartTimes.begin() + i);
 			filenamePositionDone++;
 		}
 
 		int numProcessesRunning = countProcessesRunning(processes);
 
 		// Add new processes when we are below the limit and there are replays left
-		while (numProcessesRunning < maxProcesses && filenamePositionStarted < filenames.size())
+		while (numProcessesRunning < maxProcesses && filenamePositionStarted < (int)jobs.size())
 		{
-			UnicodeString filenameWide;
-			filenameWide.translate(filenames[filenamePositionStarted]);
-			UnicodeString command;
-			command.format(L"\"%s\"%s%s -replay \"%s\"",
-				exePath,
-				TheGlobalData->m_windowed ? L" -win" : L"",
-				TheGlobalData->m_headless ? L" -headless" : L"",
-				filenameWide.str());
-
 			processes.push_back(WorkerProcess());
-			processes.back().startProcess(command);
+			processes.back().startProcess(getWorkerArgs(exePath, jobs[filenamePositionStarted].filename));
+			processJobs.push_back(filenamePositionStarted);
+			processStartTimes.push_back(GetTickCount());
 
 			filenamePositionStarted++;
 			numProcessesRunning++;
@@ -187,14 +408,17 @@ int ReplaySimulation::simulateReplaysInWorkerProcesses(const std::vector<AsciiSt
 		if (processes.empty())
 			break;
 
-		// Don't waste CPU here, our workers need every bit of CPU time they can get
-		Sleep(100);
+		WorkerProcess::waitForActivity(processes, 100);
 	}
 
 	DEBUG_ASSERTCRASH(filenamePositionStarted == filenames.size(), ("inconsistent file position 1"));
 	DEBUG_ASSERTCRASH(filenamePositionDone == filenames.size(), ("inconsistent file position 2"));
 
+	if (!finishReplayBenchmark(results))
+		numErrors++;
+
 	printf("Simulation of all replays completed. Errors occurred: %d\n", numErrors);
+	ReplayBenchmark::printSummary(results);
 
 	UnsignedInt realTime = (GetTickCount()-totalStartTimeMillis) / 1000;
 	printf("Total Wall Time: %d:%02d:%02d\n", realTime/60/60, realTime/60%60, realTime%60);
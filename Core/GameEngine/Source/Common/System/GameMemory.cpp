@@ -195,6 +195,11 @@ DECLARE_PERF_TIMER(MemoryPoolInitFilling)
 static Bool thePreMainInitFlag = false;
 static Bool theMainInitFlag = false;
 
+class MemoryPoolThreadCache;
+static DWORD theThreadCacheTlsIndex = TLS_OUT_OF_INDEXES;		///< TLS slot with the MemoryPoolThreadCache of each thread
+static MemoryPoolThreadCache *theFirstThreadCache = nullptr;
+static Int theThreadCachedPoolCount = 0;
+
 // ----------------------------------------------------------------------------
 // PRIVATE PROTOTYPES
 // ----------------------------------------------------------------------------
@@ -504,6 +509,61 @@ public:
 
 };
 
+// ----------------------------------------------------------------------------
+enum
+{
+	MAX_THREAD_CACHED_POOLS = 2048,		///< pools created after this many are not cached
+	MAX_THREAD_CACHE_BLOCKS = 32,			///< max number of free blocks a thread cache keeps per pool
+	MAX_THREAD_CACHE_BYTES = 8 * 1024	///< max size of the free blocks a thread cache keeps per pool
+};
+
+// ----------------------------------------------------------------------------
+/**
+	TheSuperHackers @performance A thread cache holds a magazine of free blocks for every pool, so that
+	allocating and freeing pool blocks does not need to lock TheMemoryPoolCriticalSection. Every thread that
+	allocates gets its own cache. Only when a magazine runs empty or full, half of it is moved from or back
+	to the blobs of the pool at once, under the lock.
+
+	Blocks in a magazine still count as used by their pool, but not towards its peaks. In debug builds they
+	are marked as free, so the leak reports ignore them.
+
+	A cache is only touched by its own thread, with two exceptions: a new thread takes over the cache of a
+	thread that has exited, and destroying or resetting a pool returns the blocks of all caches to the pool.
+	No other thread may use a pool while it is destroyed or reset anyway.
+*/
+class MemoryPoolThreadCache
+{
+private:
+	struct Magazine
+	{
+		MemoryPoolSingleBlock	*m_firstBlock;
+		Int										m_count;
+	};
+
+	MemoryPoolThreadCache	*m_next;													///< next cache in the list of all caches
+	HANDLE								m_thread;													///< the thread that uses this cache
+	Magazine							m_magazines[MAX_THREAD_CACHED_POOLS];	///< indexed by MemoryPool::getThreadCacheIndex()
+
+	static MemoryPoolThreadCache *create();
+
+public:
+
+	static void init();
+	static void shutdown();
+
+	/// return the cache of the calling thread. returns null if thread caches are not available.
+	static MemoryPoolThreadCache *getForCurrentThread();
+
+	/// return the blocks of the given pool in all caches to the pool.
+	static void releaseBlocks(MemoryPool *pool);
+
+	/// return the number of caches, which is the most threads that allocated at the same time.
+	static Int getCacheCount();
+
+	MemoryPoolSingleBlock *allocateBlock(MemoryPool *pool);
+	void freeBlock(MemoryPool *pool, MemoryPoolSingleBlock *block);
+};
+
 // ----------------------------------------------------------------------------
 // PUBLIC DATA
 // ----------------------------------------------------------------------------
@@ -1487,6 +1547,162 @@ void Checkpointable::debugResetCheckpoints()
 }
 #endif
 
+//-----------------------------------------------------------------------------
+// METHODS for MemoryPoolThreadCache
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+/**
+	allocate the TLS slot for the thread caches. without it, the pools are not cached.
+*/
+/*static*/ void MemoryPoolThreadCache::init()
+{
+	if (theThreadCacheTlsIndex == TLS_OUT_OF_INDEXES)
+		theThreadCacheTlsIndex = ::TlsAlloc();
+}
+
+//-----------------------------------------------------------------------------
+/**
+	throw away all thread caches. all pools must have been destroyed already, so the
+	caches do not hold any blocks anymore.
+*/
+/*static*/ void MemoryPoolThreadCache::shutdown()
+{
+	while (theFirstThreadCache)
+	{
+		MemoryPoolThreadCache *cache = theFirstThreadCache;
+		theFirstThreadCache = cache->m_next;
+		if (cache->m_thread)
+			::CloseHandle(cache->m_thread);
+		::sysFree((void *)cache);
+	}
+
+	if (theThreadCacheTlsIndex != TLS_OUT_OF_INDEXES)
+	{
+		::TlsFree(theThreadCacheTlsIndex);
+		theThreadCacheTlsIndex = TLS_OUT_OF_INDEXES;
+	}
+	theThreadCachedPoolCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	create the cache for the calling thread. if a thread with a cache has exited,
+	its cache is taken over together with the blocks in it.
+*/
+/*static*/ MemoryPoolThreadCache *MemoryPoolThreadCache::create()
+{
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	MemoryPoolThreadCache *cache = theFirstThreadCache;
+	for (; cache != nullptr; cache = cache->m_next)
+	{
+		if (cache->m_thread && ::WaitForSingleObject(cache->m_thread, 0) == WAIT_OBJECT_0)
+			break;
+	}
+
+	if (cache != nullptr)
+	{
+		::CloseHandle(cache->m_thread);
+	}
+	else
+	{
+		cache = (MemoryPoolThreadCache *)::sysAllocateDoNotZero(sizeof(MemoryPoolThreadCache));	// throws on failure
+		memset(cache, 0, sizeof(MemoryPoolThreadCache));
+		cache->m_next = theFirstThreadCache;
+		theFirstThreadCache = cache;
+	}
+
+	// if this fails, the cache is just never taken over.
+	cache->m_thread = nullptr;
+	::DuplicateHandle(::GetCurrentProcess(), ::GetCurrentThread(), ::GetCurrentProcess(), &cache->m_thread, SYNCHRONIZE, FALSE, 0);
+
+	::TlsSetValue(theThreadCacheTlsIndex, cache);
+	return cache;
+}
+
+//-----------------------------------------------------------------------------
+/*static*/ MemoryPoolThreadCache *MemoryPoolThreadCache::getForCurrentThread()
+{
+	if (theThreadCacheTlsIndex == TLS_OUT_OF_INDEXES)
+		return nullptr;
+
+	MemoryPoolThreadCache *cache = (MemoryPoolThreadCache *)::TlsGetValue(theThreadCacheTlsIndex);
+	if (cache == nullptr)
+		cache = create();
+	return cache;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	return the free blocks of the given pool in all caches to its blobs. no other
+	thread may use the pool meanwhile.
+*/
+/*static*/ void MemoryPoolThreadCache::releaseBlocks(MemoryPool *pool)
+{
+	Int index = pool->getThreadCacheIndex();
+	if (index < 0)
+		return;
+
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	for (MemoryPoolThreadCache *cache = theFirstThreadCache; cache != nullptr; cache = cache->m_next)
+	{
+		Magazine &magazine = cache->m_magazines[index];
+		pool->drainThreadCache(magazine.m_firstBlock, magazine.m_count, magazine.m_count);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/*static*/ Int MemoryPoolThreadCache::getCacheCount()
+{
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	Int count = 0;
+	for (MemoryPoolThreadCache *cache = theFirstThreadCache; cache != nullptr; cache = cache->m_next)
+		++count;
+	return count;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	take a free block of the given pool from this cache. if the magazine is empty,
+	refill half of it from the blobs first. throws ERROR_OUT_OF_MEMORY on failure.
+*/
+MemoryPoolSingleBlock *MemoryPoolThreadCache::allocateBlock(MemoryPool *pool)
+{
+	Magazine &magazine = m_magazines[pool->getThreadCacheIndex()];
+	if (magazine.m_count == 0)
+	{
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		pool->fillThreadCache(magazine.m_firstBlock, magazine.m_count, pool->getThreadCacheSize() / 2);	// throws on failure
+	}
+
+	MemoryPoolSingleBlock *block = magazine.m_firstBlock;
+	magazine.m_firstBlock = block->getNextFreeBlock();
+	--magazine.m_count;
+	return block;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	put a free block of the given pool into this cache. if the magazine is full,
+	return half of it to the blobs first.
+*/
+void MemoryPoolThreadCache::freeBlock(MemoryPool *pool, MemoryPoolSingleBlock *block)
+{
+	Magazine &magazine = m_magazines[pool->getThreadCacheIndex()];
+	if (magazine.m_count >= pool->getThreadCacheSize())
+	{
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		pool->drainThreadCache(magazine.m_firstBlock, magazine.m_count, pool->getThreadCacheSize() / 2);
+	}
+
+	block->setNextFreeBlock(magazine.m_firstBlock);
+	magazine.m_firstBlock = block;
+	++magazine.m_count;
+}
+
 //-----------------------------------------------------------------------------
 // METHODS for MemoryPool
 //-----------------------------------------------------------------------------
@@ -1504,10 +1720,15 @@ MemoryPool::MemoryPool() :
 	m_overflowAllocationCount(0),
 	m_usedBlocksInPool(0),
 	m_totalBlocksInPool(0),
+	m_liveBlocksInPool(0),
 	m_peakUsedBlocksInPool(0),
+	m_sessionPeakUsedBlocks(0),
+	m_overflowBlobCount(0),
 	m_firstBlob(nullptr),
 	m_lastBlob(nullptr),
-	m_firstBlobWithFreeBlocks(nullptr)
+	m_firstBlobWithFreeBlocks(nullptr),
+	m_threadCacheIndex(-1),
+	m_threadCacheSize(0)
 {
 }
 
@@ -1525,11 +1746,23 @@ void MemoryPool::init(MemoryPoolFactory *factory, const char *poolName, Int allo
 	m_overflowAllocationCount = overflowAllocationCount;
 	m_usedBlocksInPool = 0;
 	m_totalBlocksInPool = 0;
+	m_liveBlocksInPool = 0;
 	m_peakUsedBlocksInPool = 0;
 	m_firstBlob = nullptr;
 	m_lastBlob = nullptr;
 	m_firstBlobWithFreeBlocks = nullptr;
 
+	// pools that may not grow are not cached, so that no thread runs out of blocks while another one caches them.
+	// reset() calls this again, but the pool keeps its slot in the thread caches.
+	if (m_threadCacheIndex < 0 && m_overflowAllocationCount > 0 && theThreadCachedPoolCount < MAX_THREAD_CACHED_POOLS)
+	{
+		m_threadCacheSize = min((Int)MAX_THREAD_CACHE_BLOCKS, (Int)MAX_THREAD_CACHE_BYTES / m_allocationSize);
+		if (m_threadCacheSize >= 2)
+			m_threadCacheIndex = theThreadCachedPoolCount++;
+		else
+			m_threadCacheSize = 0;
+	}
+
 	// go ahead and init the initial block here (will throw on failure)
 	createBlob(m_initialAllocationCount);
 }
@@ -1622,14 +1855,11 @@ Int MemoryPool::freeBlob(MemoryPoolBlob* blob)
 
 //-----------------------------------------------------------------------------
 /**
-	allocate a block from this pool and return it, but don't bother zeroing
-	out the block. if unable to allocate, throw ERROR_OUT_OF_MEMORY. this
-	function will never return null.
+	take a free block from the blobs of this pool, creating a new blob if necessary.
+	if unable to allocate, throw ERROR_OUT_OF_MEMORY. this function will never return null.
 */
-void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG1)
+MemoryPoolSingleBlock* MemoryPool::allocateSingleBlockFromBlobs(DECLARE_LITERALSTRING_ARG1)
 {
-	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
-
 	if (m_firstBlobWithFreeBlocks != nullptr && !m_firstBlobWithFreeBlocks->hasAnyFreeBlocks())
 	{
 		// hmm... the current 'free' blob has nothing available. look and see if there
@@ -1657,6 +1887,7 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 		else
 		{
 			createBlob(m_overflowAllocationCount); // throws on failure
+			++m_overflowBlobCount;
 		}
 	}
 
@@ -1667,17 +1898,123 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 	MemoryPoolSingleBlock *block = blob->allocateSingleBlock(PASS_LITERALSTRING_ARG1);
 	DEBUG_ASSERTCRASH(block, ("should not fail here"));
 
+	// bookkeeping
+	++m_usedBlocksInPool;
+
+	return block;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	return a block to its blob. the block must belong to this pool.
+*/
+void MemoryPool::freeSingleBlockToBlobs(MemoryPoolSingleBlock *block)
+{
+	MemoryPoolBlob *blob = block->getOwningBlob();
+	DEBUG_ASSERTCRASH(blob && blob->getOwningPool() == this, ("block does not belong to this pool"));
+
+	blob->freeSingleBlock(block);
+
+	// if we want to free the blobs as they become empty, do that here.
+	// normally we don't bother, but just in case this is ever desired, here's how you'd do it...
+	//
+	// if (blob->m_usedBlocksInBlob == 0)
+	// {
+	//	freeBlob(blob);
+	//	return;
+	//}
+
+	if (!m_firstBlobWithFreeBlocks)
+		m_firstBlobWithFreeBlocks = blob;
+
+	// bookkeeping
+	--m_usedBlocksInPool;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	move free blocks from the blobs to the head of a thread cache list, until it holds maxCount blocks.
+	count is updated with every block, so the list stays valid if this throws ERROR_OUT_OF_MEMORY.
+*/
+void MemoryPool::fillThreadCache(MemoryPoolSingleBlock *&firstBlock, Int &count, Int maxCount)
+{
+	while (count < maxCount)
+	{
+#ifdef MEMORYPOOL_DEBUG
+		MemoryPoolSingleBlock *block = allocateSingleBlockFromBlobs(FREE_SINGLEBLOCK_TAG_STRING);	// throws on failure
+#else
+		MemoryPoolSingleBlock *block = allocateSingleBlockFromBlobs();	// throws on failure
+#endif
+		block->setNextFreeBlock(firstBlock);
+		firstBlock = block;
+		++count;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+	move drainCount blocks from the head of a thread cache list back to their blobs.
+*/
+void MemoryPool::drainThreadCache(MemoryPoolSingleBlock *&firstBlock, Int &count, Int drainCount)
+{
+	DEBUG_ASSERTCRASH(drainCount <= count, ("draining more blocks than cached"));
+
+	for (; drainCount > 0; --drainCount)
+	{
+		MemoryPoolSingleBlock *block = firstBlock;
+		firstBlock = block->getNextFreeBlock();
+		--count;
+		freeSingleBlockToBlobs(block);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+	allocate a block from this pool and return it, but don't bother zeroing
+	out the block. if unable to allocate, throw ERROR_OUT_OF_MEMORY. this
+	function will never return null.
+*/
+void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG1)
+{
+	MemoryPoolSingleBlock *block;
+
+	MemoryPoolThreadCache *cache = (m_threadCacheIndex >= 0) ? MemoryPoolThreadCache::getForCurrentThread() : nullptr;
+	if (cache != nullptr)
+	{
+		block = cache->allocateBlock(this);	// throws on failure
+#ifdef MEMORYPOOL_DEBUG
+		// the blob does this for uncached blocks; it only serves to update the debugLiteralTagString.
+		block->initBlock(getAllocationSize(), block->getOwningBlob(), m_factory, debugLiteralTagString);
+#endif
+	}
+	else
+	{
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		block = allocateSingleBlockFromBlobs(PASS_LITERALSTRING_ARG1);	// throws on failure
+	}
+
+	// the peaks don't count the free blocks in the thread caches.
+	const Int liveBlocks = ::InterlockedIncrement((LONG *)&m_liveBlocksInPool);
+	if (m_peakUsedBlocksInPool < liveBlocks)
+	{
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		if (m_peakUsedBlocksInPool < liveBlocks)
+			m_peakUsedBlocksInPool = liveBlocks;
+		if (m_sessionPeakUsedBlocks < liveBlocks)
+			m_sessionPeakUsedBlocks = liveBlocks;
+	}
+
+#ifdef MEMORYPOOL_DEBUG
+	// the debug bookkeeping is shared by all threads.
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+#endif
+
 #ifdef MEMORYPOOL_CHECKPOINTING
 	BlockCheckpointInfo *bi = debugAddCheckpointInfo(block->debugGetLiteralTagString(), m_factory->getCurCheckpoint(), getAllocationSize());
 	if (bi)
 		block->debugSetCheckpointInfo(bi);
 #endif
 
-	// bookkeeping
-	++m_usedBlocksInPool;
-	if (m_peakUsedBlocksInPool < m_usedBlocksInPool)
-		m_peakUsedBlocksInPool = m_usedBlocksInPool;
-
 #ifdef MEMORYPOOL_DEBUG
 	m_factory->adjustTotals(debugLiteralTagString, 1*getAllocationSize(), 0);
 	#ifdef USE_FILLER_VALUE
@@ -1713,43 +2050,41 @@ void MemoryPool::freeBlock(void* pBlockPtr)
 	if (!pBlockPtr)
 		return;	// my, that was easy
 
-	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
-
 	MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
-	MemoryPoolBlob *blob = block->getOwningBlob();
+	DEBUG_ASSERTCRASH(block->getOwningBlob() && block->getOwningBlob()->getOwningPool() == this, ("block does not belong to this pool"));
+
 #ifdef MEMORYPOOL_DEBUG
-	const char* tagString = block->debugGetLiteralTagString();
-#endif
+	{
+		// the debug bookkeeping is shared by all threads.
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
-	DEBUG_ASSERTCRASH(blob && blob->getOwningPool() == this, ("block does not belong to this pool"));
+	#ifdef MEMORYPOOL_CHECKPOINTING
+		BlockCheckpointInfo *bi = block->debugGetCheckpointInfo();
+		DEBUG_ASSERTCRASH(bi, ("hmm, no checkpoint info"));
+		if (bi)
+			bi->debugSetFreepoint(m_factory->getCurCheckpoint());
+	#endif
 
-#ifdef MEMORYPOOL_CHECKPOINTING
-	BlockCheckpointInfo *bi = block->debugGetCheckpointInfo();
-	DEBUG_ASSERTCRASH(bi, ("hmm, no checkpoint info"));
-	if (bi)
-		bi->debugSetFreepoint(m_factory->getCurCheckpoint());
+		m_factory->adjustTotals(block->debugGetLiteralTagString(), -1*getAllocationSize(), 0);
+	}
 #endif
 
-	blob->freeSingleBlock(block);
-
-	// if we want to free the blobs as they become empty, do that here.
-	// normally we don't bother, but just in case this is ever desired, here's how you'd do it...
-	//
-	// if (blob->m_usedBlocksInBlob == 0)
-	// {
-	//	freeBlob(blob);
-	//	return;
-	//}
-
-	if (!m_firstBlobWithFreeBlocks)
-		m_firstBlobWithFreeBlocks = blob;
-
-	// bookkeeping
-	--m_usedBlocksInPool;
+	::InterlockedDecrement((LONG *)&m_liveBlocksInPool);
 
+	MemoryPoolThreadCache *cache = (m_threadCacheIndex >= 0) ? MemoryPoolThreadCache::getForCurrentThread() : nullptr;
+	if (cache != nullptr)
+	{
 #ifdef MEMORYPOOL_DEBUG
-	m_factory->adjustTotals(tagString, -1*getAllocationSize(), 0);
+		// the blob does this for uncached blocks; it lets the leak reports skip the cached block.
+		block->debugMarkBlockAsFree();
 #endif
+		cache->freeBlock(this, block);
+	}
+	else
+	{
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		freeSingleBlockToBlobs(block);
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -1795,6 +2130,8 @@ void MemoryPool::reset()
 {
 	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
+	MemoryPoolThreadCache::releaseBlocks(this);
+
 	// toss everything. we could do this slightly more efficiently,
 	// but not really worth the extra code to do so.
 	while (m_firstBlob)
@@ -1846,6 +2183,14 @@ void MemoryPool::removeFromList(MemoryPool **pHead)
 	}
 }
 
+//-----------------------------------------------------------------------------
+void MemoryPool::accumulateSessionUsage(Int peakBlockCount, Int overflowBlobCount)
+{
+	if (m_sessionPeakUsedBlocks < peakBlockCount)
+		m_sessionPeakUsedBlocks = peakBlockCount;
+	m_overflowBlobCount += overflowBlobCount;
+}
+
 //-----------------------------------------------------------------------------
 #ifdef MEMORYPOOL_DEBUG
 /**
@@ -2161,7 +2506,10 @@ void DynamicMemoryAllocator::debugIgnoreLeaksForThisBlock(void* pBlockPtr)
 */
 void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes DECLARE_LITERALSTRING_ARG2)
 {
+#ifdef MEMORYPOOL_DEBUG
+	// the debug bookkeeping is shared by all threads.
 	ScopedCriticalSection scopedCriticalSection(TheDmaCriticalSection);
+#endif
 
 	void *result = nullptr;
 
@@ -2193,6 +2541,9 @@ void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes
 	}
 	else
 	{
+		// the subpools are thread safe on their own, but the list of raw blocks is not.
+		ScopedCriticalSection scopedCriticalSection(TheDmaCriticalSection);
+
 		// too big for our pools -- just go right to the metal.
 		MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::rawAllocateSingleBlock(&m_rawBlocks, numBytes, m_factory PASS_LITERALSTRING_ARG2);
 
@@ -2235,7 +2586,7 @@ void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes
 }
 #endif // MEMORYPOOL_DEBUG
 
-	++m_usedBlocksInDma;
+	::InterlockedIncrement((LONG *)&m_usedBlocksInDma);
 	DEBUG_ASSERTCRASH(m_usedBlocksInDma >= 0, ("negative count for m_usedBlocksInDma"));
 #ifdef MEMORYPOOL_DEBUG
 	#ifdef USE_FILLER_VALUE
@@ -2277,7 +2628,10 @@ void DynamicMemoryAllocator::freeBytes(void* pBlockPtr)
 	if (!pBlockPtr)
 		return;
 
+#ifdef MEMORYPOOL_DEBUG
+	// the debug bookkeeping is shared by all threads.
 	ScopedCriticalSection scopedCriticalSection(TheDmaCriticalSection);
+#endif
 
 #ifdef MEMORYPOOL_CHECK_BLOCK_OWNERSHIP
 	DEBUG_ASSERTCRASH(debugIsBlockInDma(pBlockPtr), ("block is not in this dma"));
@@ -2323,6 +2677,9 @@ void DynamicMemoryAllocator::freeBytes(void* pBlockPtr)
 	}
 	else
 	{
+		// the subpools are thread safe on their own, but the list of raw blocks is not.
+		ScopedCriticalSection scopedCriticalSection(TheDmaCriticalSection);
+
 		// was allocated via sysAllocate.
 #ifdef MEMORYPOOL_CHECKPOINTING
 		BlockCheckpointInfo *bi = block->debugGetCheckpointInfo();
@@ -2344,7 +2701,7 @@ void DynamicMemoryAllocator::freeBytes(void* pBlockPtr)
 		::sysFree((void *)block);
 
 	}
-	--m_usedBlocksInDma;
+	::InterlockedDecrement((LONG *)&m_usedBlocksInDma);
 	DEBUG_ASSERTCRASH(m_usedBlocksInDma >= 0, ("negative count for m_usedBlocksInDma"));
 
 #ifdef INTENSE_DMA_BOOKKEEPING
@@ -2613,7 +2970,7 @@ MemoryPoolFactory::MemoryPoolFactory() :
 */
 void MemoryPoolFactory::init()
 {
-	// my, that was easy
+	MemoryPoolThreadCache::init();
 }
 
 //-----------------------------------------------------------------------------
@@ -2631,6 +2988,8 @@ MemoryPoolFactory::~MemoryPoolFactory()
 	{
 		destroyDynamicMemoryAllocator(m_firstDmaInFactory);
 	}
+
+	MemoryPoolThreadCache::shutdown();
 }
 
 //-----------------------------------------------------------------------------
@@ -2699,6 +3058,8 @@ void MemoryPoolFactory::destroyMemoryPool(MemoryPool *pMemoryPool)
 	if (!pMemoryPool)
 		return;
 
+	MemoryPoolThreadCache::releaseBlocks(pMemoryPool);
+
 	DEBUG_ASSERTCRASH(pMemoryPool->getUsedBlockCount() == 0, ("destroying a nonempty pool"));
 
 	pMemoryPool->removeFromList(&m_firstPoolInFactory);
@@ -2963,6 +3324,157 @@ void MemoryPoolFactory::debugResetCheckpoints()
 }
 #endif
 
+//-----------------------------------------------------------------------------
+/**
+	The pools do not peak at the same time, so this is an upper bound of the peak memory use of all pools.
+*/
+Int MemoryPoolFactory::getPeakPoolBytes()
+{
+	Int peakBytes = 0;
+	for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+	{
+		peakBytes += pool->getPeakBlockCount() * pool->getAllocationSize();
+	}
+	return peakBytes;
+}
+
+//-----------------------------------------------------------------------------
+void MemoryPoolFactory::resetPeakPoolBytes()
+{
+	for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+	{
+		pool->resetPeakBlockCount();
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+	Every named pool gets a line "name initial overflow ; peak P overflowBlobs B", which is what
+	userMemoryManagerInitPools() reads from Data\INI\MemoryPools.ini. The initial size is the peak
+	plus 1/8 headroom plus the free blocks the thread caches may hold, so that the pool does not create
+	overflow blobs in the middle of a game. Pools that may not grow never shrink. The subpools of the
+	dmas are listed as comments only, because their sizes are fixed in GameMemoryInitDMA.
+*/
+Bool MemoryPoolFactory::writePoolSizes(const char *filename)
+{
+	// read the file of an earlier session, if there is one. note that we don't use the normal
+	// game file system here, because that relies on memory pools.
+	char *oldText = nullptr;
+	char *oldTextEnd = nullptr;
+	FILE *fp = fopen(filename, "rb");
+	if (fp)
+	{
+		fseek(fp, 0, SEEK_END);
+		Int size = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		if (size > 0)
+		{
+			oldText = (char *)::sysAllocateDoNotZero(size + 1);
+			size = fread(oldText, 1, size, fp);
+			oldTextEnd = oldText + size;
+			*oldTextEnd = 0;
+			for (char *c = oldText; c < oldTextEnd; ++c)
+			{
+				if (*c == '\n' || *c == '\r')
+					*c = 0;
+			}
+		}
+		fclose(fp);
+	}
+
+	// merge the recorded usage into the named pools.
+	char poolName[256];
+	Int initial, overflow, peak, overflowBlobs;
+	char *line;
+	for (line = oldText; line < oldTextEnd; line += strlen(line) + 1)
+	{
+		if (sscanf(line, "%255s %d %d ; peak %d overflowBlobs %d", poolName, &initial, &overflow, &peak, &overflowBlobs) != 5)
+			continue;
+		for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+		{
+			if (stricmp(pool->getPoolName(), poolName) == 0)
+			{
+				pool->accumulateSessionUsage(peak, overflowBlobs);
+				break;
+			}
+		}
+	}
+
+	fp = fopen(filename, "w");
+	if (fp == nullptr)
+	{
+		if (oldText)
+			::sysFree(oldText);
+		DEBUG_CRASH(("could not create pool sizes file %s", filename));
+		return false;
+	}
+
+	fprintf(fp, "; memory pool sizes suggested by the recorded usage. copy to Data\\INI\\MemoryPools.ini to use them.\n");
+	fprintf(fp, "; name initial overflow ; peak <blocks> overflowBlobs <count>\n");
+
+	const Int threadCacheCount = MemoryPoolThreadCache::getCacheCount();
+	Int overflowedPools = 0;
+	for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+	{
+		Bool isDmaSubPool = false;
+		for (DynamicMemoryAllocator *dma = m_firstDmaInFactory; dma && !isDmaSubPool; dma = dma->getNextDmaInList())
+		{
+			for (Int i = 0; i < dma->getDmaMemoryPoolCount(); ++i)
+			{
+				if (dma->getNthDmaMemoryPool(i) == pool)
+				{
+					isDmaSubPool = true;
+					break;
+				}
+			}
+		}
+
+		peak = pool->getSessionPeakBlockCount();
+		overflowBlobs = pool->getOverflowBlobCount();
+		if (overflowBlobs > 0)
+			++overflowedPools;
+
+		if (isDmaSubPool)
+		{
+			fprintf(fp, "; %s %d %d ; peak %d overflowBlobs %d\n", pool->getPoolName(),
+				pool->getInitialBlockCount(), pool->getOverflowBlockCount(), peak, overflowBlobs);
+			continue;
+		}
+
+		initial = ::roundUpMemBound(max(peak + peak / 8 + pool->getThreadCacheSize() * threadCacheCount, 1));
+		if (pool->getOverflowBlockCount() == 0 && initial < pool->getInitialBlockCount())
+			initial = pool->getInitialBlockCount();
+
+		fprintf(fp, "%s %d %d ; peak %d overflowBlobs %d\n", pool->getPoolName(),
+			initial, pool->getOverflowBlockCount(), peak, overflowBlobs);
+	}
+
+	// keep the pools of the earlier sessions that were not created in this one.
+	for (line = oldText; line < oldTextEnd; line += strlen(line) + 1)
+	{
+		if (line[0] == ';' || sscanf(line, "%255s", poolName) != 1)
+			continue;
+		Bool found = false;
+		for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+		{
+			if (stricmp(pool->getPoolName(), poolName) == 0)
+			{
+				found = true;
+				break;
+			}
+		}
+		if (!found)
+			fprintf(fp, "%s\n", line);
+	}
+
+	fclose(fp);
+	if (oldText)
+		::sysFree(oldText);
+
+	DEBUG_LOG(("Wrote memory pool sizes to %s, %d pools created overflow blobs", filename, overflowedPools));
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 void MemoryPoolFactory::memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead )
 {
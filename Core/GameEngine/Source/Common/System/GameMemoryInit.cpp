@@ -135,8 +135,9 @@ void userMemoryManagerInitPools()
 					if (stricmp(p->name, poolName) == 0)
 					{
 						// currently, these must be multiples of 4. so round up.
+						// TheSuperHackers @fix an overflow of 0 keeps the pool from growing, so don't round it up.
 						p->initial = roundUpMemBound(initial);
-						p->overflow = roundUpMemBound(overflow);
+						p->overflow = overflow > 0 ? roundUpMemBound(overflow) : 0;
 						break;	// from for-p
 					}
 				}
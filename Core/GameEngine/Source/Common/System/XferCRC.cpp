@@ -32,6 +32,7 @@
 
 #include "Common/XferCRC.h"
 #include "Common/XferDeepCRC.h"
+#include "Common/XferSnapshotCRC.h"
 #include "Common/crc.h"
 #include "Common/Snapshot.h"
 #include "Utility/endian_compat.h"
@@ -341,3 +342,106 @@ void XferDeepCRC::xferUnicodeString( UnicodeString *unicodeStringData )
 		xferUser( (void *)unicodeStringData->str(), sizeof( WideChar ) * len );
 
 }
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferSnapshotCRC::XferSnapshotCRC( Int maxDepth )
+{
+	m_xferMode = XFER_SAVE;
+	m_depth = 0;
+	m_maxDepth = maxDepth;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferSnapshotCRC::~XferSnapshotCRC( void )
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Start a new session, discards all previous entries */
+//-------------------------------------------------------------------------------------------------
+void XferSnapshotCRC::open( AsciiString identifier )
+{
+	XferCRC::open( identifier );
+
+	m_openSnapshots.clear();
+	m_entries.clear();
+	m_nextLabel.clear();
+	m_lastString.clear();
+	m_depth = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Run the save path of the snapshot and track its CRC separately */
+// ------------------------------------------------------------------------------------------------
+void XferSnapshotCRC::xferSnapshot( Snapshot *snapshot )
+{
+	if( snapshot == nullptr )
+	{
+		return;
+	}
+
+	const Bool track = m_depth < m_maxDepth;
+	if( track )
+	{
+		Entry entry;
+		entry.depth = m_depth;
+		entry.label = m_nextLabel.isNotEmpty() ? m_nextLabel : m_lastString;
+		entry.crc = 0;
+		entry.size = 0;
+
+		OpenSnapshot open;
+		open.entryIndex = m_entries.size();
+		open.crc = 0;
+
+		m_entries.push_back( entry );
+		m_openSnapshots.push_back( open );
+	}
+	m_nextLabel.clear();
+	m_lastString.clear();
+
+	++m_depth;
+	snapshot->xfer( this );
+	--m_depth;
+
+	if( track )
+	{
+		const OpenSnapshot &open = m_openSnapshots.back();
+		m_entries[ open.entryIndex ].crc = htobe( open.crc );
+		m_openSnapshots.pop_back();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Remember the string as a label for the next snapshot */
+// ------------------------------------------------------------------------------------------------
+void XferSnapshotCRC::xferAsciiString( AsciiString *asciiStringData )
+{
+	m_lastString = *asciiStringData;
+	XferCRC::xferAsciiString( asciiStringData );
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Add the data to the total CRC and to the CRC of every open snapshot */
+//-------------------------------------------------------------------------------------------------
+void XferSnapshotCRC::xferImplementation( void *data, Int dataSize )
+{
+	if (!data || dataSize < 1)
+	{
+		return;
+	}
+
+	const UnsignedInt totalCRC = m_crc;
+	for( size_t i = 0; i < m_openSnapshots.size(); ++i )
+	{
+		OpenSnapshot &open = m_openSnapshots[ i ];
+		m_crc = open.crc;
+		XferCRC::xferImplementation( data, dataSize );
+		open.crc = m_crc;
+		m_entries[ open.entryIndex ].size += dataSize;
+	}
+	m_crc = totalCRC;
+
+	XferCRC::xferImplementation( data, dataSize );
+}
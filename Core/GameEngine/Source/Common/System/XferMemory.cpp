@@ -0,0 +1,233 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: XferMemory.cpp ///////////////////////////////////////////////////////////////////////////
+// Desc:   Xfer memory buffer write and read implementation
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+#include "Common/XferMemory.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// XferSaveMemory /////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferSaveMemory::XferSaveMemory( XferBuffer *buffer )
+{
+	m_buffer = buffer;
+	m_isOpen = FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferSaveMemory::~XferSaveMemory( void )
+{
+	DEBUG_ASSERTCRASH( m_blockPositions.empty(), ("XferSaveMemory::~XferSaveMemory - block stack is not empty") );
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Start writing to the buffer */
+//-------------------------------------------------------------------------------------------------
+void XferSaveMemory::open( AsciiString identifier )
+{
+	if( m_isOpen )
+	{
+		DEBUG_CRASH(( "Cannot open buffer '%s' cause we've already got '%s' open",
+									identifier.str(), m_identifier.str() ));
+		throw XFER_FILE_ALREADY_OPEN;
+	}
+
+	if( m_buffer == nullptr )
+		throw XFER_INVALID_PARAMETERS;
+
+	// call base class
+	Xfer::open( identifier );
+
+	m_buffer->clear();
+	m_blockPositions.clear();
+	m_isOpen = TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void XferSaveMemory::close( void )
+{
+	if( !m_isOpen )
+	{
+		DEBUG_CRASH(( "Xfer close called, but no buffer was open" ));
+		throw XFER_FILE_NOT_OPEN;
+	}
+
+	m_isOpen = FALSE;
+	m_identifier.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Write a placeholder block size and remember its position, see XferSave::beginBlock */
+//-------------------------------------------------------------------------------------------------
+Int XferSaveMemory::beginBlock( void )
+{
+	DEBUG_ASSERTCRASH( m_isOpen, ("Xfer begin block - buffer '%s' is not open", m_identifier.str()) );
+
+	m_blockPositions.push_back( m_buffer->size() );
+
+	XferBlockSize blockSize = 0;
+	xferImplementation( &blockSize, sizeof( XferBlockSize ) );
+
+	return XFER_OK;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Patch the size of the most recent begin block, see XferSave::endBlock */
+//-------------------------------------------------------------------------------------------------
+void XferSaveMemory::endBlock( void )
+{
+	if( m_blockPositions.empty() )
+	{
+		DEBUG_CRASH(( "Xfer end block called, but no matching begin block was found" ));
+		throw XFER_BEGIN_END_MISMATCH;
+	}
+
+	const size_t blockPos = m_blockPositions.back();
+	m_blockPositions.pop_back();
+
+	XferBlockSize blockSize = (XferBlockSize)(m_buffer->size() - blockPos - sizeof( XferBlockSize ));
+	memcpy( &(*m_buffer)[ blockPos ], &blockSize, sizeof( XferBlockSize ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void XferSaveMemory::skip( Int dataSize )
+{
+	DEBUG_ASSERTCRASH( m_isOpen, ("XferSaveMemory - buffer '%s' is not open", m_identifier.str()) );
+
+	m_buffer->resize( m_buffer->size() + dataSize );
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Append the data to the buffer */
+//-------------------------------------------------------------------------------------------------
+void XferSaveMemory::xferImplementation( void *data, Int dataSize )
+{
+	DEBUG_ASSERTCRASH( m_isOpen, ("XferSaveMemory - buffer '%s' is not open", m_identifier.str()) );
+
+	const UnsignedByte *bytes = static_cast<const UnsignedByte *>( data );
+	m_buffer->insert( m_buffer->end(), bytes, bytes + dataSize );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// XferLoadMemory /////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferLoadMemory::XferLoadMemory( const XferBuffer *buffer )
+{
+	m_buffer = buffer;
+	m_readPosition = 0;
+	m_isOpen = FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferLoadMemory::~XferLoadMemory( void )
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Start reading from the start of the buffer */
+//-------------------------------------------------------------------------------------------------
+void XferLoadMemory::open( AsciiString identifier )
+{
+	if( m_isOpen )
+	{
+		DEBUG_CRASH(( "Cannot open buffer '%s' cause we've already got '%s' open",
+									identifier.str(), m_identifier.str() ));
+		throw XFER_FILE_ALREADY_OPEN;
+	}
+
+	if( m_buffer == nullptr )
+		throw XFER_INVALID_PARAMETERS;
+
+	// call base class
+	Xfer::open( identifier );
+
+	m_readPosition = 0;
+	m_isOpen = TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void XferLoadMemory::close( void )
+{
+	if( !m_isOpen )
+	{
+		DEBUG_CRASH(( "Xfer close called, but no buffer was open" ));
+		throw XFER_FILE_NOT_OPEN;
+	}
+
+	m_isOpen = FALSE;
+	m_identifier.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+Int XferLoadMemory::beginBlock( void )
+{
+	XferBlockSize blockSize = 0;
+	xferImplementation( &blockSize, sizeof( XferBlockSize ) );
+	return blockSize;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void XferLoadMemory::endBlock( void )
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void XferLoadMemory::skip( Int dataSize )
+{
+	DEBUG_ASSERTCRASH( dataSize >= 0, ("XferLoadMemory::skip - dataSize '%d' must be greater than 0", dataSize) );
+
+	if( m_readPosition + dataSize > m_buffer->size() )
+		throw XFER_SKIP_ERROR;
+
+	m_readPosition += dataSize;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Copy the next bytes out of the buffer */
+//-------------------------------------------------------------------------------------------------
+void XferLoadMemory::xferImplementation( void *data, Int dataSize )
+{
+	DEBUG_ASSERTCRASH( m_isOpen, ("XferLoadMemory - buffer '%s' is not open", m_identifier.str()) );
+
+	if( m_readPosition + dataSize > m_buffer->size() )
+	{
+		DEBUG_CRASH(( "XferLoadMemory - Error reading from buffer '%s'", m_identifier.str() ));
+		throw XFER_READ_ERROR;
+	}
+
+	memcpy( data, &(*m_buffer)[ m_readPosition ], dataSize );
+	m_readPosition += dataSize;
+}
@@ -19,6 +19,20 @@
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 #include "Common/WorkerProcess.h"
 
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif
+#endif
+
+#ifdef _WIN32
+
 // We need Job-related functions, but these aren't defined in the Windows-headers that VC6 uses.
 // So we define them here and load them dynamically.
 #if defined(_MSC_VER) && _MSC_VER < 1300
@@ -74,11 +88,26 @@ WorkerProcess::WorkerProcess()
 	m_isDone = false;
 }
 
-bool WorkerProcess::startProcess(UnicodeString command)
+bool WorkerProcess::startProcess(const std::vector<UnicodeString>& args)
 {
 	m_stdOutput.clear();
 	m_isDone = false;
 
+	// Our command line parser only strips quotes from arguments that follow an unquoted one,
+	// so quote just the executable and the arguments that need it.
+	UnicodeString command;
+	for (size_t i = 0; i < args.size(); ++i)
+	{
+		if (i != 0)
+			command.concat(L' ');
+		const Bool quote = i == 0 || wcschr(args[i].str(), L' ') != nullptr;
+		if (quote)
+			command.concat(L'"');
+		command.concat(args[i]);
+		if (quote)
+			command.concat(L'"');
+	}
+
 	// Create pipe for reading console output
 	SECURITY_ATTRIBUTES saAttr = { sizeof(SECURITY_ATTRIBUTES) };
 	saAttr.bInheritHandle = TRUE;
@@ -133,7 +162,7 @@ bool WorkerProcess::isDone() const
 	return m_isDone;
 }
 
-DWORD WorkerProcess::getExitCode() const
+UnsignedInt WorkerProcess::getExitCode() const
 {
 	return m_exitcode;
 }
@@ -188,7 +217,9 @@ void WorkerProcess::update()
 
 	// Pipe broke, that means the process already exited. But we call this just to make sure
 	WaitForSingleObject(m_processHandle, INFINITE);
-	GetExitCodeProcess(m_processHandle, &m_exitcode);
+	DWORD exitcode = 0;
+	GetExitCodeProcess(m_processHandle, &exitcode);
+	m_exitcode = exitcode;
 	CloseHandle(m_processHandle);
 	m_processHandle = nullptr;
 
@@ -229,3 +260,196 @@ void WorkerProcess::kill()
 	m_isDone = false;
 }
 
+void WorkerProcess::waitForActivity(const std::vector<WorkerProcess>& processes, UnsignedInt timeoutMillis)
+{
+	// Anonymous pipes cannot be waited on together with WaitForMultipleObjects,
+	// so don't waste CPU here, our workers need every bit of CPU time they can get
+	Sleep(timeoutMillis);
+}
+
+#else // _WIN32
+
+WorkerProcess::WorkerProcess()
+{
+	m_processId = 0;
+	m_readFd = -1;
+	m_exitcode = 0;
+	m_isDone = false;
+}
+
+bool WorkerProcess::startProcess(const std::vector<UnicodeString>& args)
+{
+	m_stdOutput.clear();
+	m_isDone = false;
+
+	if (args.empty())
+		return false;
+
+	// Build the argument vector before forking, the child must not allocate.
+	std::vector<AsciiString> argsAscii(args.size());
+	std::vector<char*> argv(args.size() + 1, nullptr);
+	for (size_t i = 0; i < args.size(); ++i)
+	{
+		argsAscii[i].translate(args[i]);
+		argv[i] = const_cast<char*>(argsAscii[i].str());
+	}
+
+	// Create pipe for reading console output
+	int fds[2];
+	if (pipe(fds) != 0)
+		return false;
+
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0)
+	{
+		// Child process. Only async-signal-safe calls from here on.
+#if defined(__linux__)
+		// We want to make sure that when our process is killed, our workers automatically terminate as well.
+		prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+		close(fds[0]);
+		dup2(fds[1], STDOUT_FILENO);
+		dup2(fds[1], STDERR_FILENO);
+		close(fds[1]);
+		execv(argv[0], &argv[0]);
+		_exit(127);
+	}
+
+	close(fds[1]);
+	fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+	fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+	m_processId = pid;
+	m_readFd = fds[0];
+
+	return true;
+}
+
+bool WorkerProcess::isRunning() const
+{
+	return m_processId != 0;
+}
+
+bool WorkerProcess::isDone() const
+{
+	return m_isDone;
+}
+
+UnsignedInt WorkerProcess::getExitCode() const
+{
+	return m_exitcode;
+}
+
+AsciiString WorkerProcess::getStdOutput() const
+{
+	return m_stdOutput;
+}
+
+bool WorkerProcess::fetchStdOutput()
+{
+	DEBUG_ASSERTCRASH(m_readFd >= 0, ("Is not expected invalid"));
+	while (true)
+	{
+		char buffer[1024];
+		ssize_t readBytes = read(m_readFd, buffer, ARRAY_SIZE(buffer)-1);
+		if (readBytes == 0)
+		{
+			// End of file, the child closed its end of the pipe
+			return true;
+		}
+		if (readBytes < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				// Child process is still running and we have all output so far
+				return false;
+			}
+			return true;
+		}
+
+		buffer[readBytes] = 0;
+		m_stdOutput.concat(buffer);
+	}
+}
+
+void WorkerProcess::update()
+{
+	if (!isRunning())
+		return;
+
+	if (!fetchStdOutput())
+	{
+		// There is still potential output pending
+		return;
+	}
+
+	// Pipe broke, that means the process already exited. But we wait just to make sure
+	int status = 0;
+	while (waitpid(m_processId, &status, 0) < 0 && errno == EINTR)
+	{
+	}
+	m_exitcode = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+	m_processId = 0;
+
+	close(m_readFd);
+	m_readFd = -1;
+
+	m_isDone = true;
+}
+
+void WorkerProcess::kill()
+{
+	if (!isRunning())
+		return;
+
+	::kill(m_processId, SIGKILL);
+	while (waitpid(m_processId, nullptr, 0) < 0 && errno == EINTR)
+	{
+	}
+	m_processId = 0;
+
+	if (m_readFd >= 0)
+	{
+		close(m_readFd);
+		m_readFd = -1;
+	}
+
+	m_stdOutput.clear();
+	m_isDone = false;
+}
+
+void WorkerProcess::waitForActivity(const std::vector<WorkerProcess>& processes, UnsignedInt timeoutMillis)
+{
+	std::vector<pollfd> pollFds;
+	pollFds.reserve(processes.size());
+	for (size_t i = 0; i < processes.size(); ++i)
+	{
+		if (processes[i].m_readFd < 0)
+			continue;
+		pollfd pfd;
+		pfd.fd = processes[i].m_readFd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		pollFds.push_back(pfd);
+	}
+
+	if (pollFds.empty())
+	{
+		Sleep(timeoutMillis);
+		return;
+	}
+
+	// Wakes up on new output and on hangup, which is when a worker exits.
+	poll(&pollFds[0], pollFds.size(), (int)timeoutMillis);
+}
+
+#endif // _WIN32
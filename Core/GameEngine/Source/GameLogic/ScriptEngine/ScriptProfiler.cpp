@@ -0,0 +1,249 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ScriptProfiler.cpp
+// Attributes the time spent in the ScriptEngine to scripts, condition types and action types
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "GameLogic/ScriptProfiler.h"
+
+#include "GameLogic/ScriptEngine.h"
+#include "GameLogic/Scripts.h"
+
+#include <algorithm>
+
+ScriptProfiler* TheScriptProfiler = nullptr;
+
+//-------------------------------------------------------------------------------------------------
+ScriptProfiler::ScriptProfiler()
+{
+	reset();
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::reset()
+{
+	m_scriptStats.clear();
+	m_conditionStats.clear();
+	m_actionStats.clear();
+	m_childCycles.clear();
+	m_startCycles = getCycles();
+	m_startMillis = GetTickCount();
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::beginScript()
+{
+	m_childCycles.push_back(0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::endScript(const Script* script, UnsignedInt64 cycles, Bool fired)
+{
+	DEBUG_ASSERTCRASH(!m_childCycles.empty(), ("ScriptProfiler::endScript without beginScript"));
+	const UnsignedInt64 childCycles = m_childCycles.back();
+	m_childCycles.pop_back();
+	if (!m_childCycles.empty())
+		m_childCycles.back() += cycles;
+
+	Stats& stats = m_scriptStats[script->getName()];
+	if (stats.name.isEmpty())
+		stats.name = script->getName();
+	stats.cycles += cycles;
+	stats.selfCycles += cycles - childCycles;
+	++stats.calls;
+	if (fired)
+		++stats.hits;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Also called for the conditions of the generic team scripts, which are not run by executeScript. */
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::addConditions(const Script* script, UnsignedInt64 cycles)
+{
+	Stats& stats = m_scriptStats[script->getName()];
+	if (stats.name.isEmpty())
+		stats.name = script->getName();
+	stats.conditionCycles += cycles;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::addCondition(Condition* condition, UnsignedInt64 cycles, Bool result)
+{
+	const Int type = condition->getConditionType();
+	Stats& stats = getTypeStats(m_conditionStats, type);
+	if (stats.name.isEmpty())
+		stats.name = TheScriptEngine->getConditionTemplate(type)->m_internalName;
+	stats.cycles += cycles;
+	++stats.calls;
+	if (result)
+		++stats.hits;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::addAction(ScriptAction* action, UnsignedInt64 cycles)
+{
+	const Int type = action->getActionType();
+	Stats& stats = getTypeStats(m_actionStats, type);
+	if (stats.name.isEmpty())
+		stats.name = TheScriptEngine->getActionTemplate(type)->m_internalName;
+	stats.cycles += cycles;
+	++stats.calls;
+}
+
+//-------------------------------------------------------------------------------------------------
+ScriptProfiler::Stats& ScriptProfiler::getTypeStats(TypeStatsVec& stats, Int type)
+{
+	if ((size_t)type >= stats.size())
+		stats.resize(type + 1);
+	return stats[type];
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::collectTypeStats(const TypeStatsVec& stats, StatsList& list)
+{
+	list.clear();
+	for (size_t i = 0; i < stats.size(); ++i)
+	{
+		if (stats[i].calls != 0)
+			list.push_back(&stats[i]);
+	}
+	std::sort(list.begin(), list.end(), isMoreCycles);
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::collectScriptStats(StatsList& list) const
+{
+	list.clear();
+	for (ScriptStatsMap::const_iterator it = m_scriptStats.begin(); it != m_scriptStats.end(); ++it)
+		list.push_back(&it->second);
+	std::sort(list.begin(), list.end(), isMoreSelfCycles);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The self cycles of all scripts add up to the time spent in scripts. The conditions of the generic
+	* team scripts are evaluated outside of scripts and are added on top. */
+//-------------------------------------------------------------------------------------------------
+UnsignedInt64 ScriptProfiler::getTotalCycles() const
+{
+	UnsignedInt64 totalCycles = 0;
+	for (ScriptStatsMap::const_iterator it = m_scriptStats.begin(); it != m_scriptStats.end(); ++it)
+	{
+		const Stats& stats = it->second;
+		totalCycles += stats.calls != 0 ? stats.selfCycles : stats.conditionCycles;
+	}
+	return totalCycles;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Cycles are read from the time stamp counter. Its rate is estimated from the wall time
+	* since the last reset, which is precise enough for a profile of a whole map. */
+//-------------------------------------------------------------------------------------------------
+Real ScriptProfiler::getCyclesPerMillisecond() const
+{
+	const UnsignedInt millis = GetTickCount() - m_startMillis;
+	if (millis == 0)
+		return 0.0f;
+	return (Real)((double)(getCycles() - m_startCycles) / millis);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Writes the scripts sorted by self cycles, then the condition types and the action types sorted by cycles. */
+//-------------------------------------------------------------------------------------------------
+Bool ScriptProfiler::writeReport(const AsciiString& filename) const
+{
+	FILE* fp = fopen(filename.str(), "wt");
+	if (fp == nullptr)
+		return FALSE;
+
+	StatsList scriptList;
+	collectScriptStats(scriptList);
+	StatsList conditionList;
+	collectTypeStats(m_conditionStats, conditionList);
+	StatsList actionList;
+	collectTypeStats(m_actionStats, actionList);
+
+	const Real cyclesPerMs = getCyclesPerMillisecond();
+	const double msDivisor = cyclesPerMs > 0.0f ? cyclesPerMs : 1.0;
+	const UnsignedInt64 totalCycles = getTotalCycles();
+	const double totalDivisor = totalCycles != 0 ? (double)totalCycles : 1.0;
+
+	fprintf(fp, "Script profile: %u scripts, %u condition types, %u action types, %.1f ms in scripts, %.0f cycles per ms\n\n",
+		(UnsignedInt)scriptList.size(), (UnsignedInt)conditionList.size(), (UnsignedInt)actionList.size(),
+		totalCycles / msDivisor, cyclesPerMs);
+
+	fprintf(fp, "%-48s %10s %10s %10s %10s %10s %8s\n", "Script", "Runs", "Fired", "ms", "Self ms", "Cond ms", "Self%");
+	for (size_t i = 0; i < scriptList.size(); ++i)
+	{
+		const Stats& stats = *scriptList[i];
+		fprintf(fp, "%-48s %10u %10u %10.2f %10.2f %10.2f %8.2f\n",
+			stats.name.str(), stats.calls, stats.hits,
+			stats.cycles / msDivisor, stats.selfCycles / msDivisor, stats.conditionCycles / msDivisor,
+			100.0 * stats.selfCycles / totalDivisor);
+	}
+
+	fprintf(fp, "\n%-48s %10s %10s %10s %10s %8s\n", "Condition", "Calls", "True", "ms", "us/call", "Total%");
+	for (size_t i = 0; i < conditionList.size(); ++i)
+	{
+		const Stats& stats = *conditionList[i];
+		fprintf(fp, "%-48s %10u %10u %10.2f %10.3f %8.2f\n",
+			stats.name.str(), stats.calls, stats.hits,
+			stats.cycles / msDivisor, 1000.0 * stats.cycles / msDivisor / stats.calls,
+			100.0 * stats.cycles / totalDivisor);
+	}
+
+	fprintf(fp, "\n%-48s %10s %10s %10s %8s\n", "Action", "Calls", "ms", "us/call", "Total%");
+	for (size_t i = 0; i < actionList.size(); ++i)
+	{
+		const Stats& stats = *actionList[i];
+		fprintf(fp, "%-48s %10u %10.2f %10.3f %8.2f\n",
+			stats.name.str(), stats.calls,
+			stats.cycles / msDivisor, 1000.0 * stats.cycles / msDivisor / stats.calls,
+			100.0 * stats.cycles / totalDivisor);
+	}
+
+	const Bool success = ferror(fp) == 0;
+	fclose(fp);
+	return success;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Prints the most expensive scripts, condition types and action types in short. */
+//-------------------------------------------------------------------------------------------------
+void ScriptProfiler::printTopOffenders(FILE* fp, Int count) const
+{
+	StatsList scriptList;
+	collectScriptStats(scriptList);
+	StatsList conditionList;
+	collectTypeStats(m_conditionStats, conditionList);
+	StatsList actionList;
+	collectTypeStats(m_actionStats, actionList);
+
+	const Real cyclesPerMs = getCyclesPerMillisecond();
+	const double msDivisor = cyclesPerMs > 0.0f ? cyclesPerMs : 1.0;
+
+	fprintf(fp, "Script profile: %.1f ms in scripts\n", getTotalCycles() / msDivisor);
+	for (size_t i = 0; i < scriptList.size() && i < (size_t)count; ++i)
+		fprintf(fp, "  script    %-48s %10.2f ms self, %u runs\n", scriptList[i]->name.str(), scriptList[i]->selfCycles / msDivisor, scriptList[i]->calls);
+	for (size_t i = 0; i < conditionList.size() && i < (size_t)count; ++i)
+		fprintf(fp, "  condition %-48s %10.2f ms, %u calls\n", conditionList[i]->name.str(), conditionList[i]->cycles / msDivisor, conditionList[i]->calls);
+	for (size_t i = 0; i < actionList.size() && i < (size_t)count; ++i)
+		fprintf(fp, "  action    %-48s %10.2f ms, %u calls\n", actionList[i]->name.str(), actionList[i]->cycles / msDivisor, actionList[i]->calls);
+	fflush(fp);
+}
@@ -0,0 +1,218 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// UpdateProfiler.cpp
+// Attributes the time spent in UpdateModule::update to module classes and thing templates
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "GameLogic/UpdateProfiler.h"
+
+#include "Common/ThingTemplate.h"
+
+#include <algorithm>
+
+UpdateProfiler* TheUpdateProfiler = nullptr;
+
+//-------------------------------------------------------------------------------------------------
+UpdateProfiler::UpdateProfiler()
+{
+	reset();
+}
+
+//-------------------------------------------------------------------------------------------------
+void UpdateProfiler::reset()
+{
+	m_stats.clear();
+	m_startCycles = getCycles();
+	m_startMillis = GetTickCount();
+}
+
+//-------------------------------------------------------------------------------------------------
+void UpdateProfiler::addUpdate(NameKeyType moduleNameKey, const ThingTemplate* thingTemplate, UnsignedInt64 cycles, Bool sleepNone)
+{
+	// Template ids stay the same for overrides and when templates are reloaded, pointers do not.
+	const UnsignedInt64 key = ((UnsignedInt64)(UnsignedInt)moduleNameKey << 16) | thingTemplate->getTemplateID();
+
+	Stats& stats = m_stats[key];
+	if (stats.calls == 0)
+	{
+		stats.moduleNameKey = moduleNameKey;
+		stats.templateName = thingTemplate->getName();
+	}
+	stats.cycles += cycles;
+	++stats.calls;
+	if (sleepNone)
+		++stats.sleepNoneCalls;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Cycles are read from the time stamp counter. Its rate is estimated from the wall time
+	* since the last reset, which is precise enough for a profile of a whole replay. */
+//-------------------------------------------------------------------------------------------------
+Real UpdateProfiler::getCyclesPerMillisecond() const
+{
+	const UnsignedInt millis = GetTickCount() - m_startMillis;
+	if (millis == 0)
+		return 0.0f;
+	return (Real)((double)(getCycles() - m_startCycles) / millis);
+}
+
+//-------------------------------------------------------------------------------------------------
+void UpdateProfiler::collectModuleTotals(std::vector<Stats>& totals) const
+{
+	std::map<NameKeyType, Stats> moduleTotals;
+	for (StatsMap::const_iterator it = m_stats.begin(); it != m_stats.end(); ++it)
+	{
+		const Stats& stats = it->second;
+		Stats& total = moduleTotals[stats.moduleNameKey];
+		total.moduleNameKey = stats.moduleNameKey;
+		total.cycles += stats.cycles;
+		total.calls += stats.calls;
+		total.sleepNoneCalls += stats.sleepNoneCalls;
+	}
+
+	totals.clear();
+	for (std::map<NameKeyType, Stats>::const_iterator it = moduleTotals.begin(); it != moduleTotals.end(); ++it)
+		totals.push_back(it->second);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool UpdateProfiler::writeReport(const AsciiString& filename) const
+{
+	FILE* fp = fopen(filename.str(), "wt");
+	if (fp == nullptr)
+		return FALSE;
+
+	const Bool isChromeTrace = filename.endsWithNoCase(".json");
+	const Bool success = isChromeTrace ? writeChromeTrace(fp) : writeTable(fp);
+
+	fclose(fp);
+	return success;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Writes the totals per module class, then every module class and template pair, sorted by cycles. */
+//-------------------------------------------------------------------------------------------------
+Bool UpdateProfiler::writeTable(FILE* fp) const
+{
+	std::vector<Stats> totals;
+	collectModuleTotals(totals);
+
+	StatsList moduleList;
+	UnsignedInt64 totalCycles = 0;
+	for (size_t i = 0; i < totals.size(); ++i)
+	{
+		moduleList.push_back(&totals[i]);
+		totalCycles += totals[i].cycles;
+	}
+	std::sort(moduleList.begin(), moduleList.end(), isMoreCycles);
+
+	StatsList pairList;
+	for (StatsMap::const_iterator it = m_stats.begin(); it != m_stats.end(); ++it)
+		pairList.push_back(&it->second);
+	std::sort(pairList.begin(), pairList.end(), isMoreCycles);
+
+	const Real cyclesPerMs = getCyclesPerMillisecond();
+	const double totalDivisor = totalCycles != 0 ? (double)totalCycles : 1.0;
+
+	fprintf(fp, "Update profile: %u module classes, %u pairs of module class and template, %.0f cycles per ms\n\n",
+		(UnsignedInt)moduleList.size(), (UnsignedInt)pairList.size(), cyclesPerMs);
+
+	fprintf(fp, "%-40s %12s %12s %8s %12s %10s %8s\n", "Module", "Calls", "SleepNone", "Never%", "MCycles", "ms", "Total%");
+	for (size_t i = 0; i < moduleList.size(); ++i)
+	{
+		const Stats& stats = *moduleList[i];
+		fprintf(fp, "%-40s %12u %12u %8.1f %12.1f %10.1f %8.2f\n",
+			KEYNAME(stats.moduleNameKey).str(), stats.calls, stats.sleepNoneCalls,
+			stats.calls != 0 ? 100.0 * stats.sleepNoneCalls / stats.calls : 0.0,
+			stats.cycles / 1000000.0,
+			cyclesPerMs > 0.0f ? stats.cycles / cyclesPerMs : 0.0,
+			100.0 * stats.cycles / totalDivisor);
+	}
+
+	fprintf(fp, "\n%-40s %-40s %12s %12s %8s %12s %10s %8s\n", "Module", "Template", "Calls", "SleepNone", "Never%", "MCycles", "ms", "Total%");
+	for (size_t i = 0; i < pairList.size(); ++i)
+	{
+		const Stats& stats = *pairList[i];
+		fprintf(fp, "%-40s %-40s %12u %12u %8.1f %12.1f %10.1f %8.2f\n",
+			KEYNAME(stats.moduleNameKey).str(), stats.templateName.str(), stats.calls, stats.sleepNoneCalls,
+			stats.calls != 0 ? 100.0 * stats.sleepNoneCalls / stats.calls : 0.0,
+			stats.cycles / 1000000.0,
+			cyclesPerMs > 0.0f ? stats.cycles / cyclesPerMs : 0.0,
+			100.0 * stats.cycles / totalDivisor);
+	}
+
+	return ferror(fp) == 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The trace holds no timeline, because a replay has far too many updates for that. Instead every
+	* module class is one span with the length of its total time, and its templates are nested spans
+	* inside it. Trace viewers then show the profile as a flame graph. */
+//-------------------------------------------------------------------------------------------------
+Bool UpdateProfiler::writeChromeTrace(FILE* fp) const
+{
+	std::vector<Stats> totals;
+	collectModuleTotals(totals);
+
+	StatsList moduleList;
+	for (size_t i = 0; i < totals.size(); ++i)
+		moduleList.push_back(&totals[i]);
+	std::sort(moduleList.begin(), moduleList.end(), isMoreCycles);
+
+	StatsList pairList;
+	for (StatsMap::const_iterator it = m_stats.begin(); it != m_stats.end(); ++it)
+		pairList.push_back(&it->second);
+	std::sort(pairList.begin(), pairList.end(), isMoreCycles);
+
+	// Trace times are in microseconds. Fall back to cycles if the rate is unknown.
+	const Real cyclesPerMs = getCyclesPerMillisecond();
+	const double cyclesPerUs = cyclesPerMs > 0.0f ? cyclesPerMs / 1000.0 : 1.0;
+
+	fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(fp, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"GameLogic::update sleepy updates\"}}");
+
+	double moduleStart = 0.0;
+	for (size_t i = 0; i < moduleList.size(); ++i)
+	{
+		const Stats& module = *moduleList[i];
+		const AsciiString moduleName = KEYNAME(module.moduleNameKey);
+		fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"module\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,"
+			"\"args\":{\"calls\":%u,\"sleepNone\":%u}}",
+			moduleName.str(), moduleStart, module.cycles / cyclesPerUs, module.calls, module.sleepNoneCalls);
+
+		double templateStart = moduleStart;
+		for (size_t j = 0; j < pairList.size(); ++j)
+		{
+			const Stats& stats = *pairList[j];
+			if (stats.moduleNameKey != module.moduleNameKey)
+				continue;
+
+			fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"template\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,"
+				"\"args\":{\"module\":\"%s\",\"calls\":%u,\"sleepNone\":%u}}",
+				stats.templateName.str(), templateStart, stats.cycles / cyclesPerUs, moduleName.str(), stats.calls, stats.sleepNoneCalls);
+			templateStart += stats.cycles / cyclesPerUs;
+		}
+
+		moduleStart += module.cycles / cyclesPerUs;
+	}
+
+	fprintf(fp, "\n]}\n");
+	return ferror(fp) == 0;
+}
@@ -0,0 +1,291 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// sleepyUpdateBench.cpp
+// Compares the sleepy update heap with the heap the game had before on a synthetic workload.
+//
+// The workload mimics the update loop of GameLogic: modules that update every frame, modules that
+// sleep a random number of frames, and modules that sleep forever until something wakes them up.
+// The heap only caches the priorities of its modules, so both heaps must update the modules in
+// exactly the same order, including the modules with equal priority.
+
+#include "Lib/BaseType.h"
+#include "GameLogic/SleepyUpdateQueue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+enum
+{
+	SLEEP_FOREVER = 0x3fffffff,
+	FRAMES = 3000
+};
+
+//-------------------------------------------------------------------------------------------------
+class BenchModule
+{
+public:
+
+	enum Kind
+	{
+		KIND_EVERY_FRAME,
+		KIND_RANDOM,
+		KIND_FOREVER
+	};
+
+	BenchModule() : m_priority(0), m_index(-1), m_kind(KIND_RANDOM), m_phase(0), m_random(0) {}
+
+	void init(Int id, Kind kind)
+	{
+		m_kind = kind;
+		m_phase = (UnsignedInt)id & 3;
+		m_random = 0x9e3779b9u * (UnsignedInt)(id + 1);
+		setNextCallFrame(1 + (nextRandom() % 30));
+	}
+
+	UnsignedInt friend_getPriority() const { return m_priority; }
+	UnsignedInt friend_getNextCallFrame() const { return m_priority >> 2; }
+	Int friend_getIndexInLogic() const { return m_index; }
+	void friend_setIndexInLogic(Int i) { m_index = i; }
+
+	void setNextCallFrame(UnsignedInt frame)
+	{
+		if (frame > SLEEP_FOREVER)
+			frame = SLEEP_FOREVER;
+		m_priority = (frame << 2) | m_phase;
+	}
+
+	UnsignedInt update()
+	{
+		switch (m_kind)
+		{
+			case KIND_EVERY_FRAME:	return 1;
+			case KIND_RANDOM:				return 1 + (nextRandom() % 30);
+			default:								return SLEEP_FOREVER;
+		}
+	}
+
+private:
+
+	UnsignedInt nextRandom()
+	{
+		m_random = m_random * 1664525u + 1013904223u;
+		return m_random >> 8;
+	}
+
+	UnsignedInt m_priority;
+	Int m_index;
+	Kind m_kind;
+	UnsignedInt m_phase;
+	UnsignedInt m_random;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** The heap of GameLogic before SleepyUpdateHeap, which reads the priority from the module on every
+	* comparison. Only has the methods the benchmark uses. */
+//-------------------------------------------------------------------------------------------------
+template <typename UpdatePtr>
+class OriginalSleepyUpdateHeap
+{
+public:
+
+	Bool empty() const { return m_items.empty(); }
+	UpdatePtr peek() const { return m_items.front(); }
+
+	void push(UpdatePtr u)
+	{
+		m_items.push_back(u);
+		u->friend_setIndexInLogic((Int)m_items.size() - 1);
+		rebalanceParent((Int)m_items.size() - 1);
+	}
+
+	void reschedule(UpdatePtr u)
+	{
+		rebalance(u->friend_getIndexInLogic());
+	}
+
+	void reschedulePeeked(UpdatePtr u)
+	{
+		rebalance(0);
+	}
+
+private:
+
+	static Bool isLowerPriority(UpdatePtr a, UpdatePtr b)
+	{
+		return a->friend_getPriority() > b->friend_getPriority();
+	}
+
+	Int rebalanceParent(Int i)
+	{
+		Int parent = ((i+1)>>1)-1;
+		while (parent >= 0 && isLowerPriority(m_items[parent], m_items[i]))
+		{
+			UpdatePtr a = m_items[parent];
+			UpdatePtr b = m_items[i];
+
+			m_items[i] = a;
+			m_items[parent] = b;
+
+			a->friend_setIndexInLogic(i);
+			b->friend_setIndexInLogic(parent);
+
+			i = parent;
+			parent = ((parent+1)>>1)-1;
+		}
+
+		return i;
+	}
+
+	Int rebalanceChild(Int i)
+	{
+		const Int sz = (Int)m_items.size();
+		Int child = (i<<1)+1;
+		while (child < sz)
+		{
+			if (child < sz-1 && isLowerPriority(m_items[child], m_items[child+1]))
+				++child;
+
+			if (!isLowerPriority(m_items[i], m_items[child]))
+				break;
+
+			UpdatePtr a = m_items[child];
+			UpdatePtr b = m_items[i];
+
+			m_items[i] = a;
+			m_items[child] = b;
+
+			a->friend_setIndexInLogic(i);
+			b->friend_setIndexInLogic(child);
+
+			i = child;
+			child = (i<<1)+1;
+		}
+
+		return i;
+	}
+
+	void rebalance(Int i)
+	{
+		i = rebalanceParent(i);
+		i = rebalanceChild(i);
+	}
+
+	std::vector<UpdatePtr> m_items;
+};
+
+//-------------------------------------------------------------------------------------------------
+struct BenchResult
+{
+	double seconds;
+	UnsignedInt updates;
+	UnsignedInt checksum;		///< depends on the order of all updates
+	Bool ordered;						///< every frame updated its modules in the order of their priority
+};
+
+//-------------------------------------------------------------------------------------------------
+template <typename Queue>
+static void runBench(Int moduleCount, BenchResult& result)
+{
+	BenchModule* modules = new BenchModule[moduleCount];
+	for (Int i = 0; i < moduleCount; ++i)
+	{
+		const Int kindRoll = i % 10;
+		const BenchModule::Kind kind = kindRoll < 2 ? BenchModule::KIND_EVERY_FRAME : (kindRoll < 6 ? BenchModule::KIND_RANDOM : BenchModule::KIND_FOREVER);
+		modules[i].init(i, kind);
+	}
+
+	Queue* queue = new Queue;
+	for (Int i = 0; i < moduleCount; ++i)
+		queue->push(&modules[i]);
+
+	UnsignedInt wakeRandom = 12345;
+	result.updates = 0;
+	result.checksum = 0;
+	result.ordered = TRUE;
+
+	const clock_t start = clock();
+
+	for (UnsignedInt now = 1; now <= FRAMES; ++now)
+	{
+		// Wake up a few modules, like damage or upgrades do.
+		for (Int w = 0; w < moduleCount / 200 + 1; ++w)
+		{
+			wakeRandom = wakeRandom * 1664525u + 1013904223u;
+			BenchModule* u = &modules[(wakeRandom >> 8) % (UnsignedInt)moduleCount];
+			const UnsignedInt when = now + 1 + ((wakeRandom >> 4) & 7);
+			if (when < u->friend_getNextCallFrame())
+			{
+				u->setNextCallFrame(when);
+				queue->reschedule(u);
+			}
+		}
+
+		UnsignedInt lastPriority = 0;
+		while (!queue->empty())
+		{
+			BenchModule* u = queue->peek();
+			if (u->friend_getNextCallFrame() > now)
+				break;
+
+			if (u->friend_getPriority() < lastPriority)
+				result.ordered = FALSE;
+			lastPriority = u->friend_getPriority();
+
+			result.checksum = result.checksum * 31 + (UnsignedInt)(u - modules);
+			++result.updates;
+
+			u->setNextCallFrame(now + u->update());
+			queue->reschedulePeeked(u);
+		}
+	}
+
+	result.seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	delete queue;
+	delete [] modules;
+}
+
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	static const Int moduleCounts[] = { 2000, 10000, 50000 };
+	Bool success = TRUE;
+
+	printf("%d frames, 20%% of modules update every frame, 40%% sleep 1-30 frames, 40%% sleep until woken\n\n", (Int)FRAMES);
+	printf("%8s %12s %10s %10s %8s %s\n", "Modules", "Updates", "Before ms", "Heap ms", "Speedup", "Result");
+
+	for (size_t i = 0; i < sizeof(moduleCounts) / sizeof(moduleCounts[0]); ++i)
+	{
+		BenchResult original;
+		BenchResult heap;
+		runBench< OriginalSleepyUpdateHeap<BenchModule*> >(moduleCounts[i], original);
+		runBench< SleepyUpdateHeap<BenchModule*> >(moduleCounts[i], heap);
+
+		const Bool match = original.ordered && heap.ordered && original.updates == heap.updates && original.checksum == heap.checksum;
+		success = success && match;
+
+		printf("%8d %12u %10.1f %10.1f %7.2fx %s\n",
+			moduleCounts[i], heap.updates, original.seconds * 1000.0, heap.seconds * 1000.0,
+			heap.seconds > 0.0 ? original.seconds / heap.seconds : 0.0,
+			match ? "same order" : "MISMATCH");
+	}
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -120,6 +120,12 @@ public:
 	// Run game without graphics, input or audio.
 	Bool m_headless;
 
+	// TheSuperHackers @performance Headless mode creates no FX, floating texts or client-only drawables, because
+	// nothing ever draws them. -headlessClientEffects creates them anyway, to audit that skipping them leaves the
+	// logic CRC unchanged.
+	Bool m_headlessClientEffects;
+	Bool isLogicOnly() const { return m_headless && !m_headlessClientEffects; }
+
 	Bool m_windowed;
 	Int m_xResolution;
 	Int m_yResolution;
@@ -350,6 +356,26 @@ public:
 
 	std::vector<AsciiString> m_simulateReplays; ///< If not empty, simulate this list of replays and exit.
 	Int m_simulateReplayJobs; ///< Maximum number of processes to use for simulation, or SIMULATE_REPLAYS_SEQUENTIAL for sequential simulation
+	UnsignedInt m_replayCheckpointInterval; ///< If not 0, keep an in-memory checkpoint of the game every N logic frames during replay playback
+	UnsignedInt m_replayCheckpointMemoryMB; ///< Memory budget for replay checkpoints, oldest checkpoints are evicted first
+	Bool m_replayIndexSidecars; ///< If true, store the command index of a played back replay in a sidecar file next to it
+	AsciiString m_replayCRCReportFileName; ///< If not empty, write a CRC report to this file when a simulated replay mismatches
+	AsciiString m_replayCRCReferenceFileName; ///< If not empty, write the CRC report for the frames of this reference report and compare against it
+	AsciiString m_updateProfileFileName; ///< If not empty, profile the update modules during replay simulation and write the report to this file
+	AsciiString m_scriptProfileFileName; ///< If not empty, profile the scripts and write the report to this file at the end of every map
+	AsciiString m_replayBenchFileName; ///< If not empty, write the performance results of the simulated replays to this CSV file
+	AsciiString m_replayBenchBaselineFileName; ///< If not empty, compare the performance results of the simulated replays with this CSV file
+	Real m_replayBenchTolerance; ///< Regression in percent that the comparison with the baseline tolerates
+	Int m_pathfindTimeBudgetMicros; ///< If not 0, process queued pathfinds for this many microseconds per frame instead of a fixed number of cells
+	AsciiString m_memoryPoolSizesFileName; ///< If not empty, write the memory pool sizes suggested by the usage of this session to this file on exit
+	AsciiString m_pathfindBenchMap; ///< If not empty, benchmark the pathfinder on this map and exit
+	Int m_pathfindBenchQueries; ///< Queries of every type and locomotor type in the pathfinding benchmark
+	UnsignedInt m_pathfindBenchSeed; ///< Seed of the query positions in the pathfinding benchmark
+	AsciiString m_pathfindBenchFileName; ///< If not empty, write the results of the pathfinding benchmark to this CSV file
+	AsciiString m_pathfindBenchBaselineFileName; ///< If not empty, compare the results of the pathfinding benchmark with this CSV file
+	AsciiString m_collisionBenchMap; ///< If not empty, benchmark the collision detection on this map and exit
+	Int m_collisionBenchUnits; ///< Units in the blob of the collision benchmark
+	Int m_collisionBenchFrames; ///< Timed partition manager updates of the collision benchmark
 
 	Int m_maxParticleCount;						///< maximum number of particles that can exist
 	Int m_maxFieldParticleCount;			///< maximum number of field-type particles that can exist (roughly)
@@ -494,6 +520,7 @@ public:
 #if defined(RTS_DEBUG)
 	Bool m_wireframe;
 	Bool m_stateMachineDebug;
+	Bool m_auditScriptConditions;	///< Evaluate cached script conditions anyway and assert that the result did not change
 	Bool m_useCameraConstraints;
 	Bool m_specialPowerUsesDelay;
 	Bool m_fogOfWarOn;
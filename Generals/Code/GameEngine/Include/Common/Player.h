@@ -383,6 +383,12 @@ public:
 	*/
 	void becomingTeamMember(Object *obj, Bool yes);
 
+	/**
+		keeps the object counters of our teams in sync. This is called when the given object joins (add==true)
+		or leaves (add==false) one of our teams, and around changes of its dead or under construction state.
+	*/
+	void adjustObjectCount(const Object *obj, Bool add);
+
 	/**
 		this is called when the player becomes the local player (yes==true)
 		or ceases to be the local player (yes==false). you can't stop this
@@ -646,6 +652,31 @@ private:
 	*/
 	Bool addScience(ScienceType science);
 
+	// TheSuperHackers @performance The objects on our teams are counted by ThingTemplate and by their dead and
+	// under construction state, so that the count functions don't need to iterate all our objects.
+	enum ObjectCountState
+	{
+		OBJECT_COUNT_DEAD									= (1 << 0),
+		OBJECT_COUNT_UNDER_CONSTRUCTION		= (1 << 1),
+
+		OBJECT_COUNT_STATE_COUNT					= (1 << 2)
+	};
+
+	struct ObjectCount
+	{
+		const ThingTemplate*	thingTemplate;
+		Int										total;
+		Int										counts[OBJECT_COUNT_STATE_COUNT];	///< indexed by ObjectCountState bits
+
+		Int getCount(Bool ignoreDead, Bool ignoreUnderConstruction) const;
+	};
+	typedef std::vector<ObjectCount> ObjectCountVec;
+
+	static Int getObjectCountState(const Object *obj);
+	void addObjectCount(const Object *obj, Int delta) const;
+	void rebuildObjectCounts() const;
+	void invalidateObjectCounts() { m_objectCountsDirty = TRUE; }
+
 public:
 	Int getSkillPoints() const						{ return m_skillPoints; }
 	Int getSciencePurchasePoints() const	{ return m_sciencePurchasePoints; }
@@ -747,6 +778,8 @@ private:
 	UnicodeString				m_generalName;		///< (SAVE) This is the name of the general the player is allowed to change.
 
 	PlayerTeamList				m_playerTeamPrototypes;				///< ALL the teams we control, via prototype
+	mutable ObjectCountVec	m_objectCounts;						///< (NO-SAVE) the objects of m_playerTeamPrototypes by ThingTemplate
+	mutable Bool					m_objectCountsDirty;					///< (NO-SAVE) m_objectCounts must be rebuilt before it is used
 	PlayerRelationMap			*m_playerRelations;						///< allies & enemies
 	TeamRelationMap				*m_teamRelations;							///< allies & enemies
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "Common/MessageStream.h"
+#include "Common/ReplayFileReader.h"
 #include "GameNetwork/GameInfo.h"
 
 class File;
@@ -84,13 +85,24 @@ public:
 #endif
 	Bool isPlaybackInProgress() const;
 
+	// TheSuperHackers @feature In-memory checkpoints for fast seeking in replays, see -replayCheckpoints.
+	void updatePlaybackCheckpoints();									///< Takes a checkpoint when due. Must be called at the end of a logic frame.
+	Bool restorePlaybackCheckpoint(UnsignedInt frame);	///< Restores the latest checkpoint at or before frame. FALSE if there is none or it does not reproduce its CRC, then restart the playback.
+	Bool seekPlayback(UnsignedInt frame);								///< Restores the latest checkpoint at or before frame and simulates up to frame.
+	void clearPlaybackCheckpoints();
+	UnsignedInt getPlaybackCheckpointCount() const { return (UnsignedInt)m_checkpoints.size(); }
+
+	// TheSuperHackers @performance Index of the commands in the replay that is played back.
+	const ReplayFrameIndex& getPlaybackFrameIndex();		///< Builds the index on first use. valid during playback only
+	Bool skipPlaybackToFrame(UnsignedInt frame);				///< Continues with the first command on or after frame without reading the commands before. Analysis only.
+
 public:
 	void handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool fromPlayback);
 protected:
 	CRCInfo *m_crcInfo;
 public:
 
-	// read in info relating to a replay, conditionally setting up m_file for playback
+	// read in info relating to a replay, conditionally setting up m_playbackFile for playback
 	struct ReplayHeader
 	{
 		AsciiString filename;
@@ -115,6 +127,7 @@ public:
 
 	RecorderModeType getMode();												///< Returns the current operating mode.
 	Bool isPlaybackMode() const { return m_mode == RECORDERMODETYPE_PLAYBACK || m_mode == RECORDERMODETYPE_SIMULATION_PLAYBACK; }
+	Bool isRecording() const { return m_mode == RECORDERMODETYPE_RECORD && m_file != nullptr; }	///< Is a replay file being written?
 	void initControls();															///< Show or Hide the Replay controls
 
 	static AsciiString getReplayDir();								///< Returns the directory that holds the replay files.
@@ -131,6 +144,7 @@ public:
 	void logPlayerDisconnect(UnicodeString player, Int slot);
 	void logCRCMismatch( void );
 	Bool sawCRCMismatch() const;
+	UnsignedInt getCRCMismatchFrame() const { return m_crcMismatchFrame; }	///< First frame with a CRC mismatch in the current playback
 	void cleanUpReplayFile( void );										///< after a crash, send replay/debug info to a central repository
 
 	void setArchiveEnabled(Bool enable) { m_archiveReplays = enable; } ///< Enable or disable replay archiving.
@@ -143,8 +157,6 @@ protected:
 	void logGameStart(AsciiString options);
 	void logGameEnd( void );
 
-	AsciiString readAsciiString();										///< Read the next string from m_file using ascii characters.
-	UnicodeString readUnicodeString();								///< Read the next string from m_file using unicode characters.
 	void readNextFrame();															///< Read the next frame number to execute a command on.
 	void appendNextCommand();													///< Read the next GameMessage and append it to TheCommandList.
 	void writeArgument(GameMessageArgumentDataType type, const GameMessageArgumentType arg);
@@ -159,6 +171,9 @@ protected:
 	CullBadCommandsResult cullBadCommands(); ///< prevent the user from giving mouse commands that he shouldn't be able to do during playback.
 
 	File* m_file;
+	ReplayFileReader m_playbackFile;
+	ReplayFrameIndex m_playbackFrameIndex;
+	Int m_playbackCommandsOffset;											///< Offset of the first command in m_playbackFile.
 	AsciiString m_fileName;
 	Int m_currentFilePosition;
 	RecorderModeType m_mode;
@@ -174,6 +189,14 @@ protected:
 	Int m_originalGameMode; // valid in replays
 
 	UnsignedInt m_nextFrame;												///< The Frame that the next message is to be executed on.  This can be -1.
+
+	struct PlaybackCheckpoint;
+	typedef std::list<PlaybackCheckpoint*> PlaybackCheckpointList;
+	PlaybackCheckpointList m_checkpoints;						///< Checkpoints sorted by frame, oldest first.
+	size_t m_checkpointBytes;												///< Memory used by all checkpoints.
+	UnsignedInt m_nextCheckpointFrame;
+	Bool m_isRestoringCheckpoint;
+	UnsignedInt m_crcMismatchFrame;
 };
 
 extern RecorderClass *TheRecorder;
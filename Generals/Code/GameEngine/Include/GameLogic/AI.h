@@ -215,6 +215,7 @@ public:
 
 	Int	 m_infantryPathfindDiameter; // Diameter of path in cells for infantry.
 	Int  m_vehiclePathfindDiameter;  // Diameter of path in cells for vehicles.
+	Int  m_flowFieldMinGroupSize;    // Path requests to the same area that make the units share a flow field, 0 disables flow fields.
 
 	Int  m_rebuildDelaySeconds;  // Seconds to delay rebuilding after a base building is destroyed or captured.
 
@@ -204,9 +204,46 @@ protected:
 // Fits in 4 bits for now
 enum {MAX_WALL_PIECES = 128};
 
+/**
+ * Index over the A* open list, which is sorted by ascending total cost.
+ * It keeps the last cell of every total cost on the list, so that putOnSortedOpenList()
+ * finds the place of a new cell without walking the list. The list order, including the
+ * order of cells with equal cost, is the same as without the index.
+ */
+class PathfindOpenListIndex
+{
+public:
+	static void reset(void);
+	static void startList(void);
+
+	/// get the cell info to insert after (null inserts at the head). returns false if the list has to be walked.
+	static Bool findInsertPosition(const PathfindCellInfo *info, const PathfindCellInfo *head, PathfindCellInfo *&insertAfter);
+	static void insert(PathfindCellInfo *info);		///< call after info has been linked into the list
+	static void remove(PathfindCellInfo *info);		///< call before info is unlinked from the list
+
+protected:
+	enum
+	{
+		COST_COUNT = 65536,
+		WORD_BITS = 32,
+		LEVEL0_WORDS = COST_COUNT / WORD_BITS,
+		LEVEL1_WORDS = LEVEL0_WORDS / WORD_BITS
+	};
+
+	static Int findCostAtOrBelow(Int cost);
+	static void clearCost(Int cost);
+
+	static PathfindCellInfo *s_lastWithCost[COST_COUNT];	///< last cell of every cost on the list, if the cost bit is set
+	static UnsignedInt s_level0[LEVEL0_WORDS];				///< one bit per cost on the list
+	static UnsignedInt s_level1[LEVEL1_WORDS];				///< one bit per non-zero word of s_level0
+	static UnsignedInt s_count;												///< number of indexed cells on the list
+	static Bool s_valid;															///< false if the list has to be walked until it is empty again
+};
+
 class PathfindCellInfo
 {
 	friend class PathfindCell;
+	friend class PathfindOpenListIndex;
 public:
 #if RETAIL_COMPATIBLE_PATHFINDING
 	static void forceCleanPathFindCellInfos(void);
@@ -218,7 +255,12 @@ public:
 	static void releaseACellInfo(PathfindCellInfo *theInfo);
 
 protected:
-	static PathfindCellInfo *s_infoArray;
+	enum { MAX_INFO_CHUNKS = 32 };
+
+	static Bool allocateChunk(void);
+
+	static PathfindCellInfo *s_infoChunks[MAX_INFO_CHUNKS];	///< blocks of CELL_INFOS_TO_ALLOCATE infos
+	static Int s_infoChunkCount;
 	static PathfindCellInfo *s_firstFree;							///<
 
 
@@ -245,6 +287,8 @@ protected:
 	/// @todo Do we need both mark values in this cell?  Can't store a single value and compare it?
 	UnsignedInt m_open:1;													///< place for marking this cell as on the open list
 	UnsignedInt m_closed:1;												///< place for marking this cell as on the closed list
+	UnsignedInt m_onOpenListIndex:1;							///< true if this cell is in the PathfindOpenListIndex
+	UnsignedInt m_openListCost:16;								///< total cost this cell was indexed with. the total cost may change before the cell is removed
 };
 
 /**
@@ -477,6 +521,26 @@ public:
 	Bool getInteractsWithBridge(void) const {return m_interactsWithBridge;}
 	void setInteractsWithBridge(Bool interacts) {m_interactsWithBridge = interacts;}
 
+	Bool isDirty(void) const {return m_dirty;}
+	void setDirty(Bool dirty) {m_dirty = dirty;}
+
+#if !RETAIL_COMPATIBLE_PATHFIND_ZONES
+	zoneStorageType getFirstZone(void) const {return m_firstZone;}
+	UnsignedShort getNumZones(void) const {return m_numZones;}
+
+	/// Two zones of this block or of this block and its left or top neighbor that are equivalent in one of the zone tables.
+	struct ZoneEquivalency
+	{
+		zoneStorageType m_zone1;
+		zoneStorageType m_zone2;
+		UnsignedByte m_table;
+	};
+	void clearEquivalencies(void) {m_numEquivalencies = 0;}
+	void addEquivalency(Int table, zoneStorageType zone1, zoneStorageType zone2);
+	Int getNumEquivalencies(void) const {return m_numEquivalencies;}
+	const ZoneEquivalency &getEquivalency(Int i) const {return m_equivalencies[i];}
+#endif
+
 protected:
 	void allocateZones(void);
 	void freeZones(void);
@@ -495,6 +559,12 @@ protected:
 	zoneStorageType *m_crusherZones;
 	Bool					m_interactsWithBridge;
 	Bool					m_markedPassable;
+	Bool					m_dirty;						///< True if cells changed type since the zones were calculated.
+#if !RETAIL_COMPATIBLE_PATHFIND_ZONES
+	ZoneEquivalency *m_equivalencies;
+	UnsignedShort m_numEquivalencies;
+	UnsignedShort m_equivalenciesAllocated;
+#endif
 };
 typedef ZoneBlock *ZoneBlockP;
 
@@ -510,6 +580,7 @@ class PathfindZoneManager
 {
 public:
 	enum {INITIAL_ZONES = 256};
+	enum {MAX_ZONES = 24000};
 	enum {ZONE_BLOCK_SIZE = 10};	// Zones are calculated in blocks of 20x20.  This way, the raw zone numbers can be used to
 																// compute hierarchically between the 20x20 blocks of cells. jba.
 	PathfindZoneManager();
@@ -520,6 +591,9 @@ public:
 	Bool needToCalculateZones(void) const {return m_needToCalculateZones;} ///< Returns true if the zones need to be recalculated.
 	void markZonesDirty(void) ; ///< Called when the zones need to be recalculated.
 	void calculateZones(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< Does zone calculations.
+	void markBlocksDirty(const IRegion2D &cellBounds);	///< Called when cells in the bounds changed type.
+	void markAllBlocksDirty(void) {m_allBlocksDirty = true;}	///< Called when the next calculation has to cover the whole map.
+	Bool hasDirtyBlocks(void) const {return m_allBlocksDirty || m_numDirtyBlocks > 0;}	///< True if cells changed type since the last calculation.
 	zoneStorageType getEffectiveZone(LocomotorSurfaceTypeMask acceptableSurfaces, Bool crusher, zoneStorageType zone) const;
 	zoneStorageType getEffectiveTerrainZone(zoneStorageType zone) const;
 
@@ -536,6 +610,12 @@ public:
 
 	void setAllPassable(void);
 
+	Int getPassableBlocks(ICoord2D *blocks, Int maxBlocks) const;	///< Returns the passable blocks, or -1 if there are more than maxBlocks.
+	void setPassableBlocks(const ICoord2D *blocks, Int numBlocks);
+
+	UnsignedInt getZoneRevision(void) const {return m_zoneRevision;}	///< Changes whenever zones are recalculated.
+	void xferCheckpoint(Xfer *xfer);	///< Xfers the zone timing of a replay checkpoint.
+
 	void setBridge(Int cellX, Int cellY, Bool bridge);
 	Bool interactsWithBridge(Int cellX, Int cellY) const;
 
@@ -544,6 +624,27 @@ protected:
 	void freeZones(void);
 	void freeBlocks(void);
 
+	void getBlockBounds(Int xBlock, Int yBlock, const IRegion2D &globalBounds, IRegion2D &bounds) const;
+	void clearDirtyBlocks(void);
+
+#if !RETAIL_COMPATIBLE_PATHFIND_ZONES
+	enum ZoneTable
+	{
+		ZONE_TABLE_HIERARCHICAL,
+		ZONE_TABLE_TERRAIN,
+		ZONE_TABLE_CRUSHER,
+		ZONE_TABLE_GROUND_WATER,
+		ZONE_TABLE_GROUND_RUBBLE,
+		ZONE_TABLE_GROUND_CLIFF,
+		ZONE_TABLE_COUNT
+	};
+	Bool calculateDirtyZones(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds);	///< Returns false if the whole map needs calculating.
+	void calculateBlockCellZones(PathfindCell **map, const IRegion2D &bounds, ZoneBlock &block);
+	void calculateBlockEquivalencies(PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds,
+		const IRegion2D &globalBounds, ZoneBlock &block);
+	void resolveBlockEquivalencies(void);
+#endif
+
 protected:
 	ZoneBlock			*m_blockOfZoneBlocks;			///< Zone blocks - Info for hierarchical pathfinding at a "blocky" level.
 	ZoneBlock			**m_zoneBlocks;						///< Zone blocks as a matrix - contains matrix indexing into the map.
@@ -551,6 +652,10 @@ protected:
 
 	UnsignedShort m_maxZone;								///< Max zone used.
 	Bool					m_needToCalculateZones;		///< True if terrain has changed.
+	UnsignedInt		m_zoneRevision;						///< Incremented whenever zones are recalculated.
+	Int						m_numDirtyBlocks;
+	Bool					m_allBlocksDirty;
+	UnsignedShort m_maxZoneAfterFullCalculation;
 	UnsignedShort m_zonesAllocated;
 	zoneStorageType *m_groundCliffZones;
 	zoneStorageType *m_groundWaterZones;
@@ -592,11 +697,29 @@ public:
 
 };
 
+/**
+ * Statistics of the pathfind request queue since the map was loaded.
+ */
+struct PathfindQueueStats
+{
+	UnsignedInt m_requests;					///< requests that were processed
+	UnsignedInt m_playerRequests;		///< processed requests of player commands
+	UnsignedInt m_totalWaitFrames;	///< frames the processed requests spent in the queue
+	UnsignedInt m_maxWaitFrames;
+	UnsignedInt m_totalCells;				///< cells examined by the processed requests
+	UnsignedInt m_maxCells;					///< most cells examined by one request
+	UnsignedInt m_maxQueueDepth;
+	UnsignedInt m_backlogFrames;		///< frames that left requests in the queue
+	UnsignedInt m_sharedCorridorPaths;	///< paths found in the hierarchical corridor of an earlier request
+	UnsignedInt m_flowFieldPaths;		///< paths that followed the flow field of a group
+};
+
 /**
  * The Pathfinding engine itself.
  */
 class Pathfinder : PathfindServicesInterface, public Snapshot
 {
+	friend class PathfindBenchmark;	///< Runs the path find queries offline.
 // The following routines are private, but available through the doPathfind callback to aiInterface. jba.
 private:
 	virtual Path *findPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to);	///< Find a short, valid path between given locations
@@ -629,6 +752,7 @@ public:
 	void crc( Xfer *xfer );
 	void xfer( Xfer *xfer );
 	void loadPostProcess( void );
+	void xferCheckpoint( Xfer *xfer );							///< Xfers the state of a replay checkpoint that the save game does not contain.
 
 	Bool quickDoesPathExist( const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to );  ///< Can we build any path at all between the locations	(terrain & buildings check - fast)
 	Bool slowDoesPathExist( Object *obj, const Coord3D *from,
@@ -636,6 +760,7 @@ public:
 
 	Bool queueForPath(ObjectID id);	 ///< The object wants to request a pathfind, so put it on the list to process.
 	void processPathfindQueue(void); ///< Process some or all of the queued pathfinds.
+	const PathfindQueueStats& getQueueStats(void) const { return m_queueStats; }
 	void forceMapRecalculation( );	///< Force pathfind map recomputation. If region is given, only that area is recomputed
 
 	/** Returns an aircraft path to the goal.  */
@@ -837,6 +962,23 @@ protected:
 
 	bool checkCellOutsideExtents(ICoord2D& cell);
 
+	void moveFirstPlayerRequestToHead(void);	///< Let the first queued request of a player command go next.
+
+#if !RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+	struct SharedCorridor;
+	Bool getSharedCorridorKey(Bool isHuman, LocomotorSurfaceTypeMask surfaces, const Coord3D *from, const Coord3D *to,
+		SharedCorridor &key, ICoord2D &startBlock);
+	Bool useSharedCorridor(Bool isHuman, LocomotorSurfaceTypeMask surfaces, const Coord3D *from, const Coord3D *to);	///< Marks a recent corridor to the same goal block passable.
+	void addSharedCorridor(Bool isHuman, LocomotorSurfaceTypeMask surfaces, const Coord3D *from, const Coord3D *to);	///< Remembers the blocks of the last hierarchical path.
+#endif
+
+#if !RETAIL_COMPATIBLE_FLOW_FIELDS
+	struct FlowField;
+	FlowField *getFlowField(const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to);	///< Returns the flow field of a large group moving to the same area.
+	void integrateFlowField(FlowField &field);	///< Computes the cost to the goal of every cell the field's units can stand on.
+	Path *followFlowField(const FlowField &field, const Object *obj, LocomotorSurfaceTypeMask surfaces, const Coord3D *from, const Coord3D *to);	///< Builds a path down the flow field.
+#endif
+
 #if defined(RTS_DEBUG)
 	void doDebugIcons(void) ;
 #endif
@@ -874,9 +1016,53 @@ private:
 
 	// Pathfind queue
 	ObjectID			m_queuedPathfindRequests[PATHFIND_QUEUE_LEN];
+	UnsignedInt		m_queuedPathfindFrames[PATHFIND_QUEUE_LEN];		///< frame each request was queued on
+	Bool					m_queuedPathfindFromPlayer[PATHFIND_QUEUE_LEN];	///< true if the request is for a player command
+	Int						m_queuedPlayerRequests;
 	Int						m_queuePRHead;
 	Int						m_queuePRTail;
 	Int						m_cumulativeCellsAllocated;
+	PathfindQueueStats m_queueStats;
+
+#if !RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+	// Hierarchical paths of recent requests, shared with requests of units moving to the same area.
+	enum { MAX_SHARED_CORRIDORS = 8, MAX_CORRIDOR_BLOCKS = 512 };
+	struct SharedCorridor
+	{
+		UnsignedInt		m_frame;							///< frame the hierarchical path was computed on
+		UnsignedInt		m_zoneRevision;
+		LocomotorSurfaceTypeMask m_surfaces;
+		Bool					m_isHuman;
+		zoneStorageType m_zone;							///< effective zone of the start and goal cells
+		ICoord2D			m_goalBlock;
+		Int						m_numBlocks;
+		ICoord2D			m_blocks[MAX_CORRIDOR_BLOCKS];	///< zone blocks the hierarchical path marked passable
+	};
+	SharedCorridor m_sharedCorridors[MAX_SHARED_CORRIDORS];
+	Int						m_numSharedCorridors;
+	Int						m_nextSharedCorridor;
+#endif
+
+#if !RETAIL_COMPATIBLE_FLOW_FIELDS
+	// Cost fields of recent destinations, shared by the units of large groups moving there.
+	enum { MAX_FLOW_FIELDS = 4 };
+	struct FlowField
+	{
+		UnsignedInt		m_frame;							///< frame of the last request to the destination
+		UnsignedInt		m_zoneRevision;				///< zone revision the costs were integrated at
+		LocomotorSurfaceTypeMask m_surfaces;
+		Bool					m_isCrusher;
+		Int						m_radius;							///< path radius in cells
+		ICoord2D			m_goalBlock;
+		ICoord2D			m_goalCell;						///< cell the costs are integrated from
+		Int						m_requests;						///< requests to the destination, 0 if the slot is free
+		Bool					m_isIntegrated;				///< true if m_costs are valid for m_zoneRevision and m_extent
+		IRegion2D			m_extent;							///< logical extent the costs were integrated over
+		std::vector<UnsignedShort> m_costs;	///< cost to the goal cell of every cell in m_extent
+	};
+	FlowField			m_flowFields[MAX_FLOW_FIELDS];
+	Int						m_nextFlowField;
+#endif
 };
 
 
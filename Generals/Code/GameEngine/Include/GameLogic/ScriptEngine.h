@@ -110,6 +110,13 @@ typedef ListAsciiStringCoord3D::iterator ListAsciiStringCoord3DIt;
 
 typedef std::map< AsciiString, Int > ObjectTypeCount;
 
+// TheSuperHackers @performance Hash indices of the names that scripts look up every frame. The names are hashed as strings
+// rather than turned into NameKeyTypes, because new name keys during a game are CRC relevant, see NameKeyGenerator::addReservedKey.
+typedef std::hash_map< AsciiString, Int, rts::hash<AsciiString>, rts::equal_to<AsciiString> > ScriptNameIndexMap;
+typedef std::hash_map< ObjectID, Int, rts::hash<ObjectID>, rts::equal_to<ObjectID> > ScriptObjectIndexMap;
+typedef std::hash_map< AsciiString, Script*, rts::hash<AsciiString>, rts::equal_to<AsciiString> > ScriptIndexMap;
+typedef std::hash_map< AsciiString, ScriptGroup*, rts::hash<AsciiString>, rts::equal_to<AsciiString> > ScriptGroupIndexMap;
+
 typedef std::vector<Player *> VectorPlayerPtr;
 typedef VectorPlayerPtr::iterator VectorPlayerPtrIt;
 
@@ -229,6 +236,8 @@ public:
 	void notifyOfTeamDestruction(Team *teamDestroyed);
 	void notifyOfObjectCreationOrDestruction(void);
 	UnsignedInt getFrameObjectCountChanged(void) {return m_frameObjectCountChanged;}
+	void notifyOfObjectRosterChange(void) {++m_objectRosterStamp;}
+	UnsignedInt getObjectRosterStamp(void) const {return m_objectRosterStamp;}
 	void setSequentialTimer(Object *obj, Int frameCount);
 	void setSequentialTimer(Team *team, Int frameCount);
 
@@ -247,6 +256,7 @@ public:
 	virtual void runScript(const AsciiString& scriptName, Team *pThisTeam=nullptr); ///<  Runs a script.
 	virtual void runObjectScript(const AsciiString& scriptName, Object *pThisObject=nullptr); ///<  Runs a script attached to this object.
 	virtual Team *getTeamNamed(const AsciiString& teamName); ///<  Gets the named team.  May be null.
+	Team *getTeamNamed(const Parameter *pTeamParm); ///<  Gets the team of a TEAM parameter, through its bound prototype if any.  May be null.
 	virtual Player *getSkirmishEnemyPlayer(void); ///< Gets the ai's enemy Human player. May be null.
 	virtual Player *getCurrentPlayer(void); ///<  Gets the player that owns the current script.  May be null.
 	virtual Player *getPlayerFromAsciiString(const AsciiString& skirmishPlayerString);
@@ -263,10 +273,12 @@ public:
 	// NOTE NOTE NOTE: do not store of the return value of this call (getObjectTypeList) beyond the life of the
 	// function it will be used in, as it can be deleted from under you if maintenance is performed on the object.
 	virtual ObjectTypes *getObjectTypes(const AsciiString& objectTypeList);
+	ObjectTypes *getObjectTypes(Parameter *pTypeParm); ///< binds the list to the parameter until the object type lists change
 	virtual void doObjectTypeListMaintenance(const AsciiString& objectTypeList, const AsciiString& objectType, Bool addObject);
 
 	/// Return the trigger area with the given name
 	virtual PolygonTrigger *getQualifiedTriggerAreaByName( AsciiString name );
+	PolygonTrigger *getQualifiedTriggerArea( const Parameter *pTriggerParm ); ///< through the bound trigger area if any
 
 	// For other systems to evaluate Conditions, execute Actions, etc.
 
@@ -370,6 +382,12 @@ protected:
 	void executeScript( Script *pScript );
 	Script *findScript(const AsciiString& name);
 	ScriptGroup *findGroup(const AsciiString& name);
+	void buildScriptIndices();
+	void rebuildCounterAndFlagIndices();
+	void addNamedObject(const AsciiString& name, Object *obj);
+	void setNamedObject(Int index, Object *obj);
+	void clearNamedObjects();
+	void rebuildNamedObjectIndices();
 	void setSway( ScriptAction *pAction );
 	void setCounter( ScriptAction *pAction );
 	void addCounter( ScriptAction *pAction );
@@ -384,6 +402,8 @@ protected:
 	void disableScript( ScriptAction *pAction );
 	void callSubroutine( ScriptAction *pAction );
 	void checkConditionsForTeamNames(Script *pScript);
+	void bindParameters(Script *pScript);
+	Team *getTeamNamedImpl(const AsciiString& teamName, TeamPrototype *theTeamProto);
 	Bool evaluateCounter( Condition *pCondition );
 	Bool evaluateFlag( Condition *pCondition );
 	Bool evaluateTimer( Condition *pCondition );
@@ -434,6 +454,13 @@ protected:
 	Team							*m_conditionTeam;				///< Team that is being used to evaluate conditions, used for THIS_TEAM
 	Object						*m_conditionObject;				///< Unit that is being used to evaluate conditions, used for THIS_OBJECT
 	VecNamedRequests	m_namedObjects;
+	ScriptNameIndexMap	m_namedObjectIndex;				///< first entry of every name in m_namedObjects
+	ScriptObjectIndexMap	m_namedObjectIndexByID;	///< first entry of every object in m_namedObjects
+	ScriptNameIndexMap	m_counterIndex;					///< index in m_counters of every counter name
+	ScriptNameIndexMap	m_flagIndex;						///< index in m_flags of every flag name
+	ScriptIndexMap		m_scriptIndex;						///< first script of every name in the sides list
+	ScriptGroupIndexMap	m_scriptGroupIndex;			///< first script group of every name in the sides list
+	Bool							m_scriptIndicesValid;			///< the script indices are built lazily after the sides list changed
 	Bool							m_firstUpdate;
 	Player						*m_currentPlayer;
 	Player						*m_skirmishHumanPlayer;
@@ -449,6 +476,9 @@ protected:
 	Int								m_fadeFramesDecrease;
 
 	UnsignedInt				m_frameObjectCountChanged;
+	// TheSuperHackers @performance Changes whenever an object joins or leaves a team, becomes effectively dead or is
+	// destroyed, or a team is created, activated or deleted. See ScriptConditions::isObjectRosterCondition.
+	UnsignedInt				m_objectRosterStamp;
 
 	ObjectTypeCount		m_objectCounts[MAX_PLAYER_COUNT];
 
@@ -474,6 +504,7 @@ protected:
 
 	Bool							m_freezeByScript;
 	AllObjectTypes		m_allObjectTypeLists;
+	UnsignedInt				m_objectTypeListGeneration;	///< changes whenever an object type list is created or destroyed
 	Bool							m_objectsShouldReceiveDifficultyBonus;
 	Bool							m_ChooseVictimAlwaysUsesNormal;
 
@@ -566,6 +566,7 @@ GlobalData::GlobalData()
 #if defined(RTS_DEBUG)
 	m_wireframe = 0;
 	m_stateMachineDebug = FALSE;
+	m_auditScriptConditions = FALSE;
 	m_useCameraConstraints = TRUE;
 	m_fogOfWarOn = FALSE;
 	m_jabberOn = FALSE;
@@ -627,6 +628,7 @@ GlobalData::GlobalData()
 	m_framesPerSecondLimit = 0;
 	m_chipSetType = 0;
 	m_headless = FALSE;
+	m_headlessClientEffects = FALSE;
 	m_windowed = 0;
 	m_xResolution = DEFAULT_DISPLAY_WIDTH;
 	m_yResolution = DEFAULT_DISPLAY_HEIGHT;
@@ -976,6 +978,26 @@ GlobalData::GlobalData()
 
 	m_simulateReplays.clear();
 	m_simulateReplayJobs = SIMULATE_REPLAYS_SEQUENTIAL;
+	m_replayCheckpointInterval = 0;
+	m_replayCheckpointMemoryMB = 512;
+	m_replayIndexSidecars = FALSE;
+	m_replayCRCReportFileName.clear();
+	m_replayCRCReferenceFileName.clear();
+	m_updateProfileFileName.clear();
+	m_scriptProfileFileName.clear();
+	m_replayBenchFileName.clear();
+	m_replayBenchBaselineFileName.clear();
+	m_replayBenchTolerance = 10.0f;
+	m_pathfindTimeBudgetMicros = 0;
+	m_memoryPoolSizesFileName.clear();
+	m_pathfindBenchMap.clear();
+	m_pathfindBenchQueries = 1000;
+	m_pathfindBenchSeed = 1;
+	m_pathfindBenchFileName.clear();
+	m_pathfindBenchBaselineFileName.clear();
+	m_collisionBenchMap.clear();
+	m_collisionBenchUnits = 2000;
+	m_collisionBenchFrames = 300;
 
 	for (i = LEVEL_FIRST; i <= LEVEL_LAST; ++i)
 		m_healthBonus[i] = 1.0f;
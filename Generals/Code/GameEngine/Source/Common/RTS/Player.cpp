@@ -310,6 +310,7 @@ Player::Player( Int playerIndex )
 	m_ai = nullptr;
 	m_resourceGatheringManager = nullptr;
 	m_defaultTeam = nullptr;
+	m_objectCountsDirty = FALSE;
 	m_radarCount = 0;
 	m_disableProofRadarCount = 0;
 	m_radarDisabled = FALSE;
@@ -977,6 +978,8 @@ void Player::becomingTeamMember(Object *obj, Bool yes)
 	if (!obj)
 		return;
 
+	adjustObjectCount(obj, yes);
+
 	// energy production/consumption hooks, note we ignore things that are UNDER_CONSTRUCTION
 	if( !obj->getStatusBits().test( OBJECT_STATUS_UNDER_CONSTRUCTION ) )
 	{
@@ -1348,6 +1351,8 @@ void Player::addTeamToList(TeamPrototype* team)
 	}
 
 	m_playerTeamPrototypes.push_back(team);
+	invalidateObjectCounts();
+	TheScriptEngine->notifyOfObjectRosterChange();
 }
 
 //=============================================================================
@@ -1359,6 +1364,8 @@ void Player::removeTeamFromList(TeamPrototype* team)
 		if (team == *it)
 		{
 			m_playerTeamPrototypes.erase(it);
+			invalidateObjectCounts();
+			TheScriptEngine->notifyOfObjectRosterChange();
 			return;
 		}
 	}
@@ -1384,6 +1391,100 @@ void Player::iterateObjects( ObjectIterateFunc func, void *userData )
 	}
 }
 
+//=============================================================================
+Int Player::ObjectCount::getCount(Bool ignoreDead, Bool ignoreUnderConstruction) const
+{
+	Int count = 0;
+	for (Int state = 0; state < OBJECT_COUNT_STATE_COUNT; ++state)
+	{
+		if (ignoreDead && (state & OBJECT_COUNT_DEAD))
+			continue;
+
+		if (ignoreUnderConstruction && (state & OBJECT_COUNT_UNDER_CONSTRUCTION))
+			continue;
+
+		count += counts[state];
+	}
+	return count;
+}
+
+//=============================================================================
+Int Player::getObjectCountState(const Object *obj)
+{
+	Int state = 0;
+	if (obj->isEffectivelyDead())
+		state |= OBJECT_COUNT_DEAD;
+	if (obj->getStatusBits().test(OBJECT_STATUS_UNDER_CONSTRUCTION))
+		state |= OBJECT_COUNT_UNDER_CONSTRUCTION;
+	return state;
+}
+
+//=============================================================================
+void Player::addObjectCount(const Object *obj, Int delta) const
+{
+	const ThingTemplate *tmpl = obj->getTemplate();
+	if (!tmpl)
+		return;
+
+	const Int state = getObjectCountState(obj);
+
+	for (ObjectCountVec::iterator it = m_objectCounts.begin(); it != m_objectCounts.end(); ++it)
+	{
+		if (it->thingTemplate == tmpl)
+		{
+			it->total += delta;
+			it->counts[state] += delta;
+			DEBUG_ASSERTCRASH(it->counts[state] >= 0, ("Player::addObjectCount - count of '%s' is negative", tmpl->getName().str()));
+
+			// keep the list down to the templates we actually have
+			if (it->total == 0)
+				m_objectCounts.erase(it);
+			return;
+		}
+	}
+
+	DEBUG_ASSERTCRASH(delta > 0, ("Player::addObjectCount - '%s' was never counted", tmpl->getName().str()));
+	ObjectCount objectCount;
+	objectCount.thingTemplate = tmpl;
+	objectCount.total = delta;
+	for (Int i = 0; i < OBJECT_COUNT_STATE_COUNT; ++i)
+		objectCount.counts[i] = 0;
+	objectCount.counts[state] = delta;
+	m_objectCounts.push_back(objectCount);
+}
+
+//=============================================================================
+/** Teams that change their player and loaded save games change our teams all at once.
+	* We then count our objects once more, before the counts are used again. */
+//=============================================================================
+void Player::rebuildObjectCounts() const
+{
+	m_objectCounts.clear();
+
+	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin();
+			 it != m_playerTeamPrototypes.end(); ++it)
+	{
+		for (DLINK_ITERATOR<Team> iter = (*it)->iterate_TeamInstanceList(); !iter.done(); iter.advance())
+		{
+			for (DLINK_ITERATOR<Object> iterObj = iter.cur()->iterate_TeamMemberList(); !iterObj.done(); iterObj.advance())
+			{
+				addObjectCount(iterObj.cur(), 1);
+			}
+		}
+	}
+
+	m_objectCountsDirty = FALSE;
+}
+
+//=============================================================================
+void Player::adjustObjectCount(const Object *obj, Bool add)
+{
+	if (!obj || m_objectCountsDirty)
+		return;
+
+	addObjectCount(obj, add ? 1 : -1);
+}
+
 //=============================================================================
 void Player::countObjectsByThingTemplate(Int numTmplates, const ThingTemplate* const * things, Bool ignoreDead, Int *counts, Bool ignoreUnderConstruction ) const
 {
@@ -1392,12 +1493,36 @@ void Player::countObjectsByThingTemplate(Int numTmplates, const ThingTemplate* c
 	for (i = 0; i < numTmplates; ++i)
 		counts[i] = 0;
 
+	if (m_objectCountsDirty)
+		rebuildObjectCounts();
+
+	// All objects of a ThingTemplate match the same entry of things.
+	for (ObjectCountVec::const_iterator it = m_objectCounts.begin(); it != m_objectCounts.end(); ++it)
+	{
+		for (i = 0; i < numTmplates; ++i)
+		{
+			if (it->thingTemplate->isEquivalentTo(things[i]))
+			{
+				counts[i] += it->getCount(ignoreDead, ignoreUnderConstruction);
+				break;
+			}
+		}
+	}
+
+#ifdef DEBUG_CRASHING
+	std::vector<Int> checkCounts(numTmplates + 1, 0);
 	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin();
 			 it != m_playerTeamPrototypes.end();
 			 ++it)
 	{
-		(*it)->countObjectsByThingTemplate(numTmplates, things, ignoreDead, counts, ignoreUnderConstruction);
+		(*it)->countObjectsByThingTemplate(numTmplates, things, ignoreDead, &checkCounts[0], ignoreUnderConstruction);
+	}
+	for (i = 0; i < numTmplates; ++i)
+	{
+		DEBUG_ASSERTCRASH(counts[i] == checkCounts[i], ("Player::countObjectsByThingTemplate - counted %d '%s' but there are %d",
+			counts[i], things[i] ? things[i]->getName().str() : "", checkCounts[i]));
 	}
+#endif
 }
 
 //=============================================================================
@@ -1405,11 +1530,25 @@ Int Player::countBuildings(void)
 {
 	int retVal = 0;
 
+	if (m_objectCountsDirty)
+		rebuildObjectCounts();
+
+	for (ObjectCountVec::const_iterator it = m_objectCounts.begin(); it != m_objectCounts.end(); ++it)
+	{
+		if (it->thingTemplate->isKindOf(KINDOF_STRUCTURE))
+			retVal += it->total;
+	}
+
+#ifdef DEBUG_CRASHING
+	int checkVal = 0;
 	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin();
 			 it != m_playerTeamPrototypes.end(); ++it)
 	{
-		retVal += (*it)->countBuildings();
+		checkVal += (*it)->countBuildings();
 	}
+	DEBUG_ASSERTCRASH(retVal == checkVal, ("Player::countBuildings - counted %d but there are %d", retVal, checkVal));
+#endif
+
 	return retVal;
 }
 
@@ -1418,11 +1557,25 @@ Int Player::countObjects(KindOfMaskType setMask, KindOfMaskType clearMask)
 {
 	int retVal = 0;
 
+	if (m_objectCountsDirty)
+		rebuildObjectCounts();
+
+	for (ObjectCountVec::const_iterator it = m_objectCounts.begin(); it != m_objectCounts.end(); ++it)
+	{
+		if (it->thingTemplate->isKindOfMulti(setMask, clearMask))
+			retVal += it->total;
+	}
+
+#ifdef DEBUG_CRASHING
+	int checkVal = 0;
 	for (PlayerTeamList::const_iterator it = m_playerTeamPrototypes.begin();
 			 it != m_playerTeamPrototypes.end(); ++it)
 	{
-		retVal += (*it)->countObjects(setMask, clearMask);
+		checkVal += (*it)->countObjects(setMask, clearMask);
 	}
+	DEBUG_ASSERTCRASH(retVal == checkVal, ("Player::countObjects - counted %d but there are %d", retVal, checkVal));
+#endif
+
 	return retVal;
 }
 
@@ -3664,6 +3817,8 @@ void Player::xfer( Xfer *xfer )
 
 		}
 
+		invalidateObjectCounts();
+
 	}
 
 	// build list info
@@ -1334,6 +1334,7 @@ Team::Team(TeamPrototype *proto, TeamID id ) :
 		AsciiString teamName = proto->getName();
 		teamName.concat(" - creating team instance.");
 		TheScriptEngine->AppendDebugMessage(teamName, false);
+		TheScriptEngine->notifyOfObjectRosterChange();
 	}
 
 	for (Int i = 0; i < MAX_GENERIC_SCRIPTS; ++i)
@@ -1350,6 +1351,7 @@ Team::~Team()
 //	DEBUG_ASSERTCRASH(getFirstItemIn_TeamMemberList() == nullptr, ("Team still has members in existence"));
 
 	TheScriptEngine->notifyOfTeamDestruction(this);
+	TheScriptEngine->notifyOfObjectRosterChange();
 
 	// Tell the players a team is going away.
 	Int i;
@@ -1511,6 +1513,16 @@ void Team::setTeamTargetObject(const Object *target)
 	}
 }
 
+// ------------------------------------------------------------------------
+void Team::setActive(void)
+{
+	if (!m_active) {
+		m_created = true;
+		m_active = true;
+		TheScriptEngine->notifyOfObjectRosterChange();
+	}
+}
+
 // ------------------------------------------------------------------------
 Object *Team::getTeamTargetObject(void)
 {
@@ -1829,26 +1841,53 @@ void Team::updateState(void)
 		m_prevSeeEnemy = m_seeEnemy;
 		m_seeEnemy = false;
 		Bool anyAliveInTeam = false; // If we're all dead, don't do all clear.
-		// only consider enemies.
+
+		// TheSuperHackers @performance The members share one pass over the partition cells
+		// instead of scanning the cells around every member on its own. The filters have no state,
+		// so the result is the same as stopping at the first member that sees an enemy.
+		std::vector<PartitionFilterRelationship> filterTeams;
+		std::vector<PartitionFilterSameMapStatus> filterMapStatuses;
+		std::vector<PartitionQuery> queries;
 		for (DLINK_ITERATOR<Object> iter = iterate_TeamMemberList(); !iter.done(); iter.advance())
 		{
 			if (iter.cur()->isEffectivelyDead())
 				continue;
 
-			PartitionFilterRelationship	filterTeam(iter.cur(), PartitionFilterRelationship::ALLOW_ENEMIES);
+			// only consider enemies.
+			filterTeams.push_back(PartitionFilterRelationship(iter.cur(), PartitionFilterRelationship::ALLOW_ENEMIES));
+			filterMapStatuses.push_back(PartitionFilterSameMapStatus(iter.cur()));
+
+			PartitionQuery query;
+			query.obj = iter.cur();
+			query.maxDist = iter.cur()->getVisionRange();
+			query.dc = FROM_CENTER_2D;
+			queries.push_back(query);
+			anyAliveInTeam = true;
+		}
 
+		if (!queries.empty())
+		{
 			// and only stuff that is not dead
 			PartitionFilterAlive filterAlive;
-			PartitionFilterSameMapStatus filterMapStatus(iter.cur());
+			std::vector<PartitionFilter *> filters(queries.size() * 4);
+			for (size_t i = 0; i < queries.size(); ++i)
+			{
+				PartitionFilter **memberFilters = &filters[i * 4];
+				memberFilters[0] = &filterTeams[i];
+				memberFilters[1] = &filterAlive;
+				memberFilters[2] = &filterMapStatuses[i];
+				memberFilters[3] = nullptr;
+				queries[i].filters = memberFilters;
+			}
 
-			PartitionFilter *filters[] = { &filterTeam, &filterAlive, &filterMapStatus, nullptr };
-			Real visionRange = iter.cur()->getVisionRange();
-			anyAliveInTeam = true;
-			Object *pObj = ThePartitionManager->getClosestObject( iter.cur(), visionRange,
-				FROM_CENTER_2D, filters );
-			if (pObj) {
-				m_seeEnemy = true;
-				break;
+			ThePartitionManager->getClosestObjectsBatch(&queries[0], (Int)queries.size());
+
+			for (size_t i = 0; i < queries.size(); ++i)
+			{
+				if (queries[i].closestObj) {
+					m_seeEnemy = true;
+					break;
+				}
 			}
 		}
 		if (anyAliveInTeam) {
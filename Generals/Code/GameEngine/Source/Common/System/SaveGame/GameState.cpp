@@ -42,6 +42,7 @@
 #include "Common/Team.h"
 #include "Common/WellKnownKeys.h"
 #include "Common/XferLoad.h"
+#include "Common/XferMemory.h"
 #include "Common/XferSave.h"
 #include "GameClient/CampaignManager.h"
 #include "GameClient/GadgetListBox.h"
@@ -640,6 +641,109 @@ SaveCode GameState::missionSave( void )
 
 }
 
+// ------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature Save the current state of the engine into a memory buffer. This is
+	* used for replay checkpoints and touches neither the disk nor the user facing save game information.
+	* The snapshots also xfer the state a regular save game recomputes on load, see XO_REPLAY_CHECKPOINT. */
+// ------------------------------------------------------------------------------------------------
+SaveCode GameState::saveGameToMemory( XferBuffer *buffer )
+{
+
+	// the save writes the save game info, so give it a neutral copy and keep the one of the user
+	SaveGameInfo checkpointInfo = m_gameInfo;
+	checkpointInfo.description.clear();
+	checkpointInfo.saveFileType = SAVE_FILE_TYPE_NORMAL;
+	checkpointInfo.missionMapName.clear();
+	LatchRestore<SaveGameInfo> restoreGameInfo(m_gameInfo, checkpointInfo);
+
+	XferSaveMemory xferSave( buffer );
+	xferSave.open( "MemorySave" );
+	xferSave.setOptions( XO_REPLAY_CHECKPOINT );
+
+	try
+	{
+		xferSaveData( &xferSave, SNAPSHOT_SAVELOAD );
+	}
+	catch( ... )
+	{
+		DEBUG_LOG(( "GameState::saveGameToMemory - Error saving game" ));
+		xferSave.close();
+		buffer->clear();
+		return SC_ERROR;
+	}
+
+	xferSave.close();
+
+	return SC_OK;
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature Load the game from a memory buffer written by saveGameToMemory. */
+// ------------------------------------------------------------------------------------------------
+SaveCode GameState::loadGameFromMemory( const XferBuffer *buffer )
+{
+
+	if( buffer == nullptr || buffer->empty() )
+		return SC_INVALID_DATA;
+
+	// the map is embedded in the save data and extracted to the save directory on load
+	CreateDirectory( getSaveDirectory().str(), nullptr );
+	TheGameStateMap->clearScratchPadMaps();
+
+	XferLoadMemory xferLoad( buffer );
+	xferLoad.open( "MemorySave" );
+	xferLoad.setOptions( XO_REPLAY_CHECKPOINT );
+
+	// clear out the game engine
+	TheGameEngine->reset();
+
+	// lock creation of new ghost objects
+	TheGhostObjectManager->saveLockGhostObjects( TRUE );
+
+	LatchRestore<Bool> inLoadGame(m_isInLoadGame, TRUE);
+
+	// load the save data
+	Bool error = FALSE;
+	try
+	{
+		xferSaveData( &xferLoad, SNAPSHOT_SAVELOAD );
+	}
+	catch( ... )
+	{
+		error = TRUE;
+	}
+
+	xferLoad.close();
+
+	// un-savelock the ghost objects
+	TheGhostObjectManager->saveLockGhostObjects( FALSE );
+
+	try
+	{
+		// do the post-process from a save game load
+		gameStatePostProcessLoad();
+	}
+	catch (...)
+	{
+		error = TRUE;
+	}
+
+	if( error == TRUE )
+	{
+		DEBUG_LOG(( "GameState::loadGameFromMemory - Error loading game" ));
+
+		if (TheGameLogic->isInGame())
+			TheGameLogic->clearGameData( FALSE );
+		TheGameEngine->reset();
+
+		return SC_INVALID_DATA;
+	}
+
+	return SC_OK;
+
+}
+
 // ------------------------------------------------------------------------------------------------
 /** Load the save game pointed to by filename */
 // ------------------------------------------------------------------------------------------------
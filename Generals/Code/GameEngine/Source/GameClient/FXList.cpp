@@ -804,6 +804,12 @@ void FXList::clear()
 //-------------------------------------------------------------------------------------------------
 void FXList::doFXPos(const Coord3D *primary, const Matrix3D* primaryMtx, const Real primarySpeed, const Coord3D *secondary, const Real overrideRadius ) const
 {
+	// TheSuperHackers @performance Nothing draws or plays the FX in headless mode. The nuggets only use the
+	// client random generator and are already skipped under the shroud of the local player, so the logic
+	// does not depend on them.
+	if (TheGlobalData->isLogicOnly())
+		return;
+
 	const Int playerIndex = rts::getObservedOrLocalPlayer()->getPlayerIndex();
 
 	if (ThePartitionManager->getShroudStatusForPlayer(playerIndex, primary) != CELLSHROUD_CLEAR)
@@ -818,6 +824,10 @@ void FXList::doFXPos(const Coord3D *primary, const Matrix3D* primaryMtx, const R
 //-------------------------------------------------------------------------------------------------
 void FXList::doFXObj(const Object* primary, const Object* secondary) const
 {
+	// TheSuperHackers @performance Nothing draws or plays the FX in headless mode.
+	if (TheGlobalData->isLogicOnly())
+		return;
+
 	const Int playerIndex = rts::getObservedOrLocalPlayer()->getPlayerIndex();
 
 	if (primary && primary->getShroudedStatus(playerIndex) > OBJECTSHROUD_PARTIAL_CLEAR)
@@ -5042,6 +5042,10 @@ void InGameUI::buildRegion( const ICoord2D *anchor, const ICoord2D *dest, IRegio
 //-------------------------------------------------------------------------------------------------
 void InGameUI::addFloatingText(const UnicodeString& text,const Coord3D *pos, Color color)
 {
+	// TheSuperHackers @performance Floating texts are only removed by the client update, which headless mode skips.
+	if( TheGlobalData->isLogicOnly() )
+		return;
+
 	if( TheGameLogic->getDrawIconUI() )
 	{
 		FloatingTextData *newFTD = newInstance( FloatingTextData );
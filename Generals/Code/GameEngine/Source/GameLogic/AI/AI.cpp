@@ -186,6 +186,7 @@ static const FieldParse TheAIFieldParseTable[] =
 
  	{ "InfantryPathfindDiameter",		INI::parseInt,nullptr,			offsetof( TAiData, m_infantryPathfindDiameter ) },
  	{ "VehiclePathfindDiameter",		INI::parseInt,nullptr,			offsetof( TAiData, m_vehiclePathfindDiameter ) },
+ 	{ "FlowFieldMinGroupSize",		INI::parseInt,nullptr,			offsetof( TAiData, m_flowFieldMinGroupSize ) },
  	{ "RebuildDelayTimeSeconds",		INI::parseInt,nullptr,			offsetof( TAiData, m_rebuildDelaySeconds ) },
  	{ "SupplyCenterSafeRadius",			INI::parseReal,nullptr,			offsetof( TAiData, m_supplyCenterSafeRadius ) },
 
@@ -935,6 +936,7 @@ m_minDistanceForGroup(100),
 m_minClumpDensity(0.5f),
 m_infantryPathfindDiameter(6),
 m_vehiclePathfindDiameter(6),
+m_flowFieldMinGroupSize(0),
 m_supplyCenterSafeRadius(250),
 m_rebuildDelaySeconds(10),
 m_distanceRequiresGroup(0.0f),
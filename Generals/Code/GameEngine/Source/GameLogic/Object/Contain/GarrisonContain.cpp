@@ -193,7 +193,8 @@ void GarrisonContain::putObjectAtGarrisonPoint( Object *obj,
 	//
 	static const ThingTemplate *muzzle = TheThingFactory->findTemplate( "GarrisonGun" );
 	DEBUG_ASSERTCRASH( muzzle, ("Warning, Object 'GarrisonGun' not found and is need for Garrison gun effects") );
-	if( muzzle )
+	// TheSuperHackers @performance The gun barrel is only for show, so headless mode does not create it.
+	if( muzzle && !TheGlobalData->isLogicOnly() )
 	{
 		Drawable *draw = TheThingFactory->newDrawable( muzzle );
 		if( draw )
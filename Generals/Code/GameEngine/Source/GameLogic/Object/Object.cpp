@@ -722,6 +722,9 @@ void Object::setGeometryInfoZ( Real newZ )
 {
 	// A Z change only does not need to un/register with the PartitionManager
 	m_geometryInfo.setMaxHeightAbovePosition( newZ );
+	// but the bounding radius in its packed data may change.
+	if (m_partitionData)
+		m_partitionData->updatePackedData();
 
 	if (m_drawable)
 		m_drawable->reactToGeometryChange();
@@ -802,6 +805,9 @@ void Object::setOrRestoreTeam( Team* team, Bool restoring )
 	// Switch //////////////////////////
 	m_team = team;
 
+	if (TheScriptEngine)
+		TheScriptEngine->notifyOfObjectRosterChange();
+
 	// After Switch //////////////////////////
 	if (m_team)
 	{
@@ -864,11 +870,21 @@ void Object::setStatus( ObjectStatusMaskType objectStatus, Bool set )
 {
 	ObjectStatusMaskType oldStatus = m_status;
 
+	// TheSuperHackers @performance The player counts objects under construction separately.
+	Player* countingPlayer = nullptr;
+	if (m_team && objectStatus.test( OBJECT_STATUS_UNDER_CONSTRUCTION ) && oldStatus.test( OBJECT_STATUS_UNDER_CONSTRUCTION ) != set)
+		countingPlayer = m_team->getControllingPlayer();
+	if (countingPlayer)
+		countingPlayer->adjustObjectCount(this, false);
+
 	if (set)
 		m_status.set( objectStatus );
 	else
 		m_status.clear( objectStatus );
 
+	if (countingPlayer)
+		countingPlayer->adjustObjectCount(this, true);
+
 	if (m_status != oldStatus)
 	{
 		if( set && objectStatus.test( OBJECT_STATUS_REPULSOR ) && m_repulsorHelper != nullptr )
@@ -1648,6 +1664,11 @@ void Object::reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* oldPo
   	m_drawable->setTransformMatrix( this->getTransformMatrix() );
 	}
 
+	// TheSuperHackers @performance Keep the packed positions of the partition cells exact, even for moves
+	// too small to update the cells, because getClosestObjects rejects objects by them.
+	if (m_partitionData)
+		m_partitionData->updatePackedData();
+
 	Bool posDiff = isPosDifferent(oldPos, getPosition());
 	Bool angDiff = isAngleDifferent(oldAngle, getOrientation());
 
@@ -1813,11 +1834,24 @@ void Object::healCompletely()
 //-------------------------------------------------------------------------------------------------
 void Object::setEffectivelyDead(Bool dead)
 {
+	// TheSuperHackers @performance The player counts dead objects separately.
+	Player* countingPlayer = nullptr;
+	if (m_team && isEffectivelyDead() != dead)
+		countingPlayer = m_team->getControllingPlayer();
+	if (countingPlayer)
+		countingPlayer->adjustObjectCount(this, false);
+
 	if (dead)
 		BitSet(m_privateStatus, EFFECTIVELY_DEAD);
 	else
 		BitClear(m_privateStatus, EFFECTIVELY_DEAD);
 
+	if (countingPlayer)
+		countingPlayer->adjustObjectCount(this, true);
+
+	if (TheScriptEngine)
+		TheScriptEngine->notifyOfObjectRosterChange();
+
 	if (dead)
 	{
 		if( m_radarData )
@@ -3606,6 +3640,13 @@ void Object::xfer( Xfer *xfer )
 	// internal name
 	xfer->xferAsciiString( &m_name );
 
+	// the player counts objects by their status, see Player::adjustObjectCount
+	Player* countingPlayer = nullptr;
+	if( xfer->getXferMode() == XFER_LOAD && m_team )
+		countingPlayer = m_team->getControllingPlayer();
+	if( countingPlayer )
+		countingPlayer->adjustObjectCount( this, false );
+
 	// status
 	if( version >= 8 )
 	{
@@ -3637,6 +3678,9 @@ void Object::xfer( Xfer *xfer )
 	// private status
 	xfer->xferUnsignedByte( &m_privateStatus );
 
+	if( countingPlayer )
+		countingPlayer->adjustObjectCount( this, true );
+
 	// OK, now that we have xferred our status bits, it's safe to set the team...
 	if( xfer->getXferMode() == XFER_LOAD )
 	{
@@ -111,6 +111,9 @@ const Real HUGE_DIST_SQR = (HUGE_DIST*HUGE_DIST);
 //-----------------------------------------------------------------------------
 static PartitionContactList* TheContactList = nullptr;
 
+//-----------------------------------------------------------------------------
+static UnsignedInt ThePackedDataRevision = 0;		///< counts the changes of the packed positions of all cells
+
 //-----------------------------------------------------------------------------
 //         Local Types
 //-----------------------------------------------------------------------------
@@ -293,6 +296,10 @@ inline Real calcSqrDist_3D(const Coord3D *dist)
 	return sqr(dist->x) + sqr(dist->y) + sqr(dist->z);
 }
 
+//-----------------------------------------------------------------------------
+static const Real PACKED_REACH_SCALE = 1.001f;		///< margins that keep the range tests on the packed cell arrays conservative
+static const Real PACKED_REACH_SLOP = 1.0f;
+
 //-----------------------------------------------------------------------------
 inline Int absInt(Int a)
 {
@@ -988,6 +995,7 @@ public:
 	PartitionData*								m_obj;			///< one object that is possibly colliding
 	PartitionData*								m_other;		///< the other object (or null for collisions with the terrain)
 	Int														m_hashValue;///< index into hash table
+	Bool													m_apart;		///< the bounding circles were apart when the pair was added
 };
 
 inline PartitionContactListNode::~PartitionContactListNode() { }
@@ -1011,6 +1019,8 @@ private:
 
 	PartitionContactListNode* m_contactHash[PartitionContactList_SOCKET_COUNT];
 	PartitionContactListNode* m_contactList;
+	UnsignedInt m_contactCount;
+	UnsignedInt m_collisionCount;
 
 public:
 
@@ -1018,6 +1028,8 @@ public:
 	{
 		memset(m_contactHash, 0, sizeof(m_contactHash));
 		m_contactList = nullptr;
+		m_contactCount = 0;
+		m_collisionCount = 0;
 	}
 
 	~PartitionContactList()
@@ -1031,7 +1043,7 @@ public:
 		Note that it is OK for other==null (this indicates a collisions with
 		the ground) but it is not OK for obj==null.
 	*/
-	void addToContactList(PartitionData *obj, PartitionData *other);
+	void addToContactList(PartitionData *obj, PartitionData *other, Bool apart = FALSE);
 
 	/**
 		process all pairs in the contact list: first, determine if they
@@ -1050,6 +1062,9 @@ public:
 	*/
 	void removeSpecificPartitionData(PartitionData* data);
 
+	UnsignedInt getContactCount() const { return m_contactCount; }			///< pairs added to the contact list that are not apart
+	UnsignedInt getCollisionCount() const { return m_collisionCount; }	///< pairs that collided in processContactList
+
 };
 
 //-----------------------------------------------------------------------------
@@ -1129,6 +1144,7 @@ CellAndObjectIntersection::CellAndObjectIntersection()
 	m_module = nullptr;
 	m_prevCoi = nullptr;
 	m_nextCoi = nullptr;
+	m_packedIndex = -1;
 }
 
 //-----------------------------------------------------------------------------
@@ -1460,6 +1476,13 @@ void PartitionCell::friend_addToCellList(CellAndObjectIntersection *coi)
 	{
 		coi->friend_addToCellList(&m_firstCoiInCell);
 		++m_coiCount;
+
+		// the position is filled in by PartitionData::updatePackedData once all cells are touched.
+		coi->friend_setPackedIndex((Int)m_packedCoi.size());
+		m_packedX.push_back(0.0f);
+		m_packedY.push_back(0.0f);
+		m_packedRadius.push_back(0.0f);
+		m_packedCoi.push_back(coi);
 	}
 }
 
@@ -1470,9 +1493,37 @@ void PartitionCell::friend_removeFromCellList(CellAndObjectIntersection *coi)
 	{
 		coi->friend_removeFromCellList(&m_firstCoiInCell);
 		--m_coiCount;
+
+		// move the last entry into the hole. The packed arrays are not in list order.
+		const Int index = coi->friend_getPackedIndex();
+		const Int last = (Int)m_packedCoi.size() - 1;
+		DEBUG_ASSERTCRASH(index >= 0 && index <= last && m_packedCoi[index] == coi, ("packed COI mismatch"));
+		if (index != last)
+		{
+			m_packedX[index] = m_packedX[last];
+			m_packedY[index] = m_packedY[last];
+			m_packedRadius[index] = m_packedRadius[last];
+			m_packedCoi[index] = m_packedCoi[last];
+			m_packedCoi[index]->friend_setPackedIndex(index);
+		}
+		m_packedX.pop_back();
+		m_packedY.pop_back();
+		m_packedRadius.pop_back();
+		m_packedCoi.pop_back();
+		coi->friend_setPackedIndex(-1);
 	}
 }
 
+//-----------------------------------------------------------------------------
+void PartitionCell::setPackedData(const CellAndObjectIntersection *coi, Real x, Real y, Real radius)
+{
+	const Int index = coi->friend_getPackedIndex();
+	DEBUG_ASSERTCRASH(index >= 0 && index < (Int)m_packedCoi.size() && m_packedCoi[index] == coi, ("packed COI mismatch"));
+	m_packedX[index] = x;
+	m_packedY[index] = y;
+	m_packedRadius[index] = radius;
+}
+
 //-----------------------------------------------------------------------------
 void PartitionCell::getCellCenterPos(Real& x, Real& y)
 {
@@ -1950,6 +2001,7 @@ void PartitionData::addPossibleCollisions(PartitionContactList *ctList)
 		if (cell->getCoiCount() < 2)
 			continue;
 
+#if RETAIL_COMPATIBLE_COLLISION_BROADPHASE
 		for (CellAndObjectIntersection *coi = cell->getFirstCoiInCell(); coi; coi = coi->getNextCoi())
 		{
 			PartitionData *that = coi->getModule();
@@ -1958,6 +2010,31 @@ void PartitionData::addPossibleCollisions(PartitionContactList *ctList)
 				ctList->addToContactList(this, that);
 			}
 		}
+#else
+		// TheSuperHackers @performance Mark the pairs whose bounding circles are apart, so that processContactList does not
+		// test them. The packed positions are current, because every transform change updates them. The pairs are still
+		// added in list order, so the contact list is the same as before.
+		const Real *packedX = cell->getPackedX();
+		const Real *packedY = cell->getPackedY();
+		const Real *packedRadius = cell->getPackedRadius();
+		const Int myIndex = myCoi->friend_getPackedIndex();
+		const Real myX = packedX[myIndex];
+		const Real myY = packedY[myIndex];
+		const Real myRadius = packedRadius[myIndex];
+
+		for (CellAndObjectIntersection *coi = cell->getFirstCoiInCell(); coi; coi = coi->getNextCoi())
+		{
+			PartitionData *that = coi->getModule();
+			if (this != that)
+			{
+				const Int k = coi->friend_getPackedIndex();
+				const Real dx = packedX[k] - myX;
+				const Real dy = packedY[k] - myY;
+				const Real reach = (packedRadius[k] + myRadius) * PACKED_REACH_SCALE + PACKED_REACH_SLOP;
+				ctList->addToContactList(this, that, dx * dx + dy * dy > reach * reach);
+			}
+		}
+#endif
 	}
 }
 
@@ -2091,6 +2168,8 @@ void PartitionData::updateCellsTouched()
 		};
 	}
 
+	updatePackedData();
+
 	Int currentCellIndexX, currentCellIndexY;
 	ThePartitionManager->worldToCell( pos.x, pos.y, &currentCellIndexX, &currentCellIndexY );
 	const PartitionCell *currentCell = ThePartitionManager->getCellAt( currentCellIndexX, currentCellIndexY );
@@ -2122,6 +2201,41 @@ void PartitionData::updateCellsTouched()
 
 }
 
+//-----------------------------------------------------------------------------
+void PartitionData::updatePackedData()
+{
+	if (m_coiInUseCount == 0)
+		return;
+
+	Coord3D pos;
+	Real radius;
+	const Object *obj = getObject();
+	if (obj)
+	{
+		pos = *obj->getPosition();
+		const GeometryInfo& geom = obj->getGeometryInfo();
+		radius = maxReal(geom.getBoundingCircleRadius(), geom.getBoundingSphereRadius());
+	}
+	else if (m_ghostObject)
+	{
+		// getClosestObjects skips COIs without an Object, any position will do.
+		pos = *m_ghostObject->getParentPosition();
+		radius = m_ghostObject->getGeometryMajorRadius();
+	}
+	else
+	{
+		return;
+	}
+
+	CellAndObjectIntersection *coi = m_coiArray;
+	for (Int i = m_coiInUseCount; i > 0; --i, ++coi)
+	{
+		if (coi->getCell())
+			coi->getCell()->setPackedData(coi, pos.x, pos.y, radius);
+	}
+	++ThePackedDataRevision;
+}
+
 //-----------------------------------------------------------------------------
 void PartitionData::invalidateShroudedStatusForPlayer(Int playerIndex)
 {
@@ -2376,7 +2490,7 @@ inline UnsignedInt hash2ints(Int a, Int b)
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void PartitionContactList::addToContactList( PartitionData *obj, PartitionData *other )
+void PartitionContactList::addToContactList( PartitionData *obj, PartitionData *other, Bool apart )
 {
 	if (obj == other || obj == nullptr || other == nullptr)
 		return;
@@ -2397,6 +2511,7 @@ void PartitionContactList::addToContactList( PartitionData *obj, PartitionData *
 				(cd->m_obj == other && cd->m_other == obj))
 		{
 			// already noted
+			DEBUG_ASSERTCRASH(cd->m_apart == apart, ("the bounding circles of a pair must be apart from both sides"));
 			return;
 		}
 	}
@@ -2406,6 +2521,7 @@ void PartitionContactList::addToContactList( PartitionData *obj, PartitionData *
 	ncd->m_obj = obj;
 	ncd->m_other = other;
 	ncd->m_hashValue = hashValue;
+	ncd->m_apart = apart;
 
 	// add to hash table
 	ncd->m_nextHash = m_contactHash[ hashValue ];
@@ -2414,6 +2530,8 @@ void PartitionContactList::addToContactList( PartitionData *obj, PartitionData *
 	// add to list of contacts for this frame
 	ncd->m_next = m_contactList;
 	m_contactList = ncd;
+	if (!apart)
+		++m_contactCount;
 
 
 #if 0
@@ -2495,6 +2613,7 @@ void PartitionContactList::resetContactList()
 //-----------------------------------------------------------------------------
 void PartitionContactList::processContactList()
 {
+	const UnsignedInt packedDataRevision = ThePackedDataRevision;
 	for (PartitionContactListNode* cd = m_contactList; cd; cd = cd->m_next)
 	{
 		if (cd->m_obj == nullptr || cd->m_other == nullptr)
@@ -2503,6 +2622,17 @@ void PartitionContactList::processContactList()
 		// we know that their partitions overlap; determine if they REALLY collide
 		// before proceeding...
 		CollideLocAndNormal cinfo;
+
+		// TheSuperHackers @performance A pair whose bounding circles were apart cannot collide, as long as nothing
+		// moved since. If an earlier collision moved anything, test the pair like any other.
+		if (cd->m_apart && ThePackedDataRevision == packedDataRevision)
+		{
+			DEBUG_ASSERTCRASH(!cd->m_obj->friend_collidesWith(cd->m_other, &cinfo),
+				("skipped a colliding pair of %s and %s", cd->m_obj->getObject()->getTemplate()->getName().str(),
+				cd->m_other->getObject()->getTemplate()->getName().str()));
+			continue;
+		}
+
 		if (!cd->m_obj->friend_collidesWith(cd->m_other, &cinfo))
 			continue;
 
@@ -2516,6 +2646,8 @@ void PartitionContactList::processContactList()
 		DEBUG_ASSERTCRASH(!(obj->isKindOf(KINDOF_IMMOBILE) && other->isKindOf(KINDOF_IMMOBILE)),
 			("we should never have collisions between two immobile things reported"));
 
+		++m_collisionCount;
+
 		// the onCollide() calls can remove the object(s) from the partition mgr,
 		// thus destroying the partitiondata for 'em. go ahead and null these out here
 		// so we won't be tempted to use 'em (since they might be bogus).
@@ -2690,6 +2822,7 @@ void PartitionManager::reset()
 #endif
 
 	resetPendingUndoShroudRevealQueue();
+	memset(&m_collisionStats, 0, sizeof(m_collisionStats));
 
 	shutdown();
 	//init();
@@ -2728,6 +2861,7 @@ void PartitionManager::shutdown()
 	m_totalCellCount = 0;
 	m_worldExtents.lo.zero();
 	m_worldExtents.hi.zero();
+	memset(&m_collisionStats, 0, sizeof(m_collisionStats));
 }
 
 //-----------------------------------------------------------------------------
@@ -2777,6 +2911,9 @@ void PartitionManager::update()
 		}
 
 		ctList.processContactList();
+		m_collisionStats.m_updates++;
+		m_collisionStats.m_contacts += ctList.getContactCount();
+		m_collisionStats.m_collisions += ctList.getCollisionCount();
 #ifdef INTENSE_DEBUG
 		DEBUG_ASSERTLOG(cc==0,("updated partition info for %d objects",cc));
 #endif
@@ -3220,6 +3357,197 @@ void PartitionManager::calcRadiusVec()
 #endif
 
 //-----------------------------------------------------------------------------
+#ifdef FASTER_GCO
+/**
+	The state of one getClosestObjects query while it scans the cells around it.
+*/
+struct PartitionManager::ClosestObjectsScan
+{
+	const Object *obj;											///< object the query is around, never returned
+	const Coord3D *objPos;
+	const Object *objToUse;									///< obj, or null for queries around a position
+	DistCalcProc distProc;
+	PartitionFilter **filters;
+	SimpleObjectIterator *iter;							///< if nonnull, receives all objects in range
+	Int iterFlag;														///< done flag of the query, or 0 to remember the visited objects in seenModules
+	std::vector<PartitionData*> *seenModules;	///< visited objects that touch more than one cell
+	Real originX;
+	Real originY;
+	Real objRadius;													///< bounding radius of objToUse for the packed test
+	Real packedRadiusScale;									///< 1 if the packed radii count for the distance, 0 otherwise
+	Object *closestObj;
+	Real closestDistSqr;
+	Coord3D closestVec;
+	Int maxRadiusLimit;											///< last cell radius the query scans
+	Bool foundAny;
+};
+
+//-----------------------------------------------------------------------------
+void PartitionManager::initClosestObjectsScan(
+	ClosestObjectsScan& scan,
+	const Object *obj,
+	const Coord3D *objPos,
+	const Object *objToUse,
+	Real maxDist,
+	DistanceCalculationType dc,
+	PartitionFilter **filters,
+	SimpleObjectIterator *iter
+)
+{
+	scan.obj = obj;
+	scan.objPos = objPos;
+	scan.objToUse = objToUse;
+	scan.distProc = theDistCalcProcs[dc];
+	scan.filters = filters;
+	scan.iter = iter;
+	scan.iterFlag = 0;
+	scan.seenModules = nullptr;
+	scan.originX = objPos->x;
+	scan.originY = objPos->y;
+
+	// the packed radii of the cells only count for the boundary distances.
+	const Bool useRadius = (dc == FROM_BOUNDINGSPHERE_2D || dc == FROM_BOUNDINGSPHERE_3D);
+	scan.packedRadiusScale = useRadius ? 1.0f : 0.0f;
+	scan.objRadius = 0.0f;
+	if (useRadius && objToUse)
+	{
+		const GeometryInfo& geom = objToUse->getGeometryInfo();
+		scan.objRadius = maxReal(geom.getBoundingCircleRadius(), geom.getBoundingSphereRadius());
+	}
+
+	scan.closestObj = nullptr;
+	scan.closestDistSqr = maxDist * maxDist;	// if it's not closer than this, we shouldn't consider it anyway...
+	scan.closestVec.x = maxDist;
+	scan.closestVec.y = maxDist;
+	scan.closestVec.z = maxDist;
+	scan.foundAny = false;
+
+	Int maxRadius = m_maxGcoRadius;
+	if (maxDist < HUGE_DIST)
+	{
+		// don't go outwards any farther than necessary.
+		maxRadius = minInt(m_maxGcoRadius, worldToCellDist(maxDist));
+	}
+#if defined(INTENSE_DEBUG)
+	/*
+		Note, if you ever enable this code, be forewarned that it can give
+		you "false positives" for objects that are located just off the map... (srj)
+	*/
+	scan.maxRadiusLimit = maxRadius + 3;
+	if (scan.maxRadiusLimit > m_maxGcoRadius) scan.maxRadiusLimit = m_maxGcoRadius;
+#else
+	scan.maxRadiusLimit = maxRadius;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void PartitionManager::scanCellForClosestObjects(PartitionCell *thisCell, Int curRadius, ClosestObjectsScan& scan)
+{
+	// TheSuperHackers @performance Reject the objects out of range from the packed positions of the cell before
+	// touching the COIs and their objects. The reach is a bit larger than the exact distance test of
+	// scanClosestObjectCandidate, so this never rejects an object that test accepts.
+	const Real *packedX = thisCell->getPackedX();
+	const Real *packedY = thisCell->getPackedY();
+	const Real *packedRadius = thisCell->getPackedRadius();
+	const Int count = thisCell->getCoiCount();
+	Real reach = sqrtf(scan.closestDistSqr) * PACKED_REACH_SCALE + PACKED_REACH_SLOP + scan.objRadius;
+	Int numInReach = 0;
+	Int lastInReach = -1;
+	for (Int p = 0; p < count; ++p)
+	{
+		const Real dx = packedX[p] - scan.originX;
+		const Real dy = packedY[p] - scan.originY;
+		const Real r = reach + packedRadius[p] * scan.packedRadiusScale;
+		if (dx*dx + dy*dy <= r*r)
+		{
+			++numInReach;
+			lastInReach = p;
+		}
+	}
+
+	if (numInReach == 0)
+		return;
+
+	if (numInReach == 1)
+	{
+		scanClosestObjectCandidate(thisCell->getPackedCoi()[lastInReach], curRadius, scan);
+		return;
+	}
+
+	// the packed arrays are not in list order, but ties between objects at the same distance go to the first
+	// one in list order, so walk the list for the others. The reach only shrinks while the query finds objects.
+	for (CellAndObjectIntersection *thisCoi = thisCell->getFirstCoiInCell(); thisCoi; thisCoi = thisCoi->getNextCoi())
+	{
+		const Int p = thisCoi->friend_getPackedIndex();
+		const Real dx = packedX[p] - scan.originX;
+		const Real dy = packedY[p] - scan.originY;
+		const Real r = reach + packedRadius[p] * scan.packedRadiusScale;
+		if (dx*dx + dy*dy > r*r)
+			continue;
+
+		scanClosestObjectCandidate(thisCoi, curRadius, scan);
+		reach = sqrtf(scan.closestDistSqr) * PACKED_REACH_SCALE + PACKED_REACH_SLOP + scan.objRadius;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void PartitionManager::scanClosestObjectCandidate(CellAndObjectIntersection *thisCoi, Int curRadius, ClosestObjectsScan& scan)
+{
+	PartitionData *thisMod = thisCoi->getModule();
+	Object *thisObj = thisMod->getObject();
+
+	// never compare against ourself.
+	if (thisObj == scan.obj || thisObj == nullptr)
+		return;
+
+	// since an object can exist in multiple COIs, we use this to avoid processing
+	// the same one more than once.
+	if (scan.iterFlag != 0)
+	{
+		if (thisMod->friend_getDoneFlag() == scan.iterFlag)
+			return;
+		thisMod->friend_setDoneFlag(scan.iterFlag);
+	}
+	else if (thisMod->friend_getCoiInUseCount() > 1)
+	{
+		if (std::find(scan.seenModules->begin(), scan.seenModules->end(), thisMod) != scan.seenModules->end())
+			return;
+		scan.seenModules->push_back(thisMod);
+	}
+
+	Real thisDistSqr;
+	Coord3D distVec;
+	if (!(*scan.distProc)(scan.objPos, scan.objToUse, thisObj->getPosition(), thisObj, thisDistSqr, distVec, scan.closestDistSqr))
+		return;
+
+	if (!filtersAllow(scan.filters, thisObj))
+		return;
+
+	// ok, this is within the range, and the filters allow it.
+	// add it to the iter, if we have one....
+	if (scan.iter)
+	{
+		scan.iter->insert(thisObj, thisDistSqr);
+	}
+	else
+	{
+		// hey, this is the new closest object! cool.
+		// (note that we can't break out now 'cuz we have to finish examining the
+		// rest of curRadius)
+		scan.closestObj = thisObj;
+		scan.closestDistSqr = thisDistSqr;
+		scan.closestVec = distVec;
+
+		if (!scan.foundAny)
+		{
+			// if not adding to iterArg, we want to stop once we have the closest object.
+			scan.maxRadiusLimit = curRadius;
+		}
+		scan.foundAny = true;
+	}
+}
+#endif
+
 //DECLARE_PERF_TIMER(getClosestObjects)
 Object *PartitionManager::getClosestObjects(
 	const Object *obj,
@@ -3256,8 +3584,6 @@ Object *PartitionManager::getClosestObjects(
 
 	DEBUG_ASSERTCRASH((obj==nullptr) != (pos == nullptr), ("either obj or pos must be null"));
 
-	DistCalcProc distProc = theDistCalcProcs[dc];
-
 	const Coord3D *objPos;
 	const Object *objToUse;
 	if (pos)
@@ -3284,33 +3610,18 @@ Object *PartitionManager::getClosestObjects(
 
 #ifdef FASTER_GCO
 
-	Int maxRadius = m_maxGcoRadius;
-	if (maxDist < HUGE_DIST)
-	{
-		// don't go outwards any farther than necessary.
-		maxRadius = minInt(m_maxGcoRadius, worldToCellDist(maxDist));
-	}
-#if defined(INTENSE_DEBUG)
-	/*
-		Note, if you ever enable this code, be forewarned that it can give
-		you "false positives" for objects that are located just off the map... (srj)
-	*/
-	Int maxRadiusLimit = maxRadius + 3;
-	if (maxRadiusLimit > m_maxGcoRadius) maxRadiusLimit = m_maxGcoRadius;
-#else
-	Int maxRadiusLimit = maxRadius;
-#endif
-
-	Bool foundAny = false;
-
 	static Int theIterFlag = 1;	// nonzero, thanks
 	++theIterFlag;
 
+	ClosestObjectsScan scan;
+	initClosestObjectsScan(scan, obj, objPos, objToUse, maxDist, dc, filters, iterArg);
+	scan.iterFlag = theIterFlag;
+
 	/*
 		m_radiusVec[curRadius] contains a list of the cells (foo) that could
 		contain objects that are <= (curRadius * cellSize) distance away from cell (0,0).
 	*/
-  for (Int curRadius = 0; curRadius <= maxRadiusLimit; ++curRadius)
+  for (Int curRadius = 0; curRadius <= scan.maxRadiusLimit; ++curRadius)
   {
     const OffsetVec& offsets = m_radiusVec[curRadius];
 		if (offsets.empty())
@@ -3318,61 +3629,22 @@ Object *PartitionManager::getClosestObjects(
     for (OffsetVec::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
 		{
 			PartitionCell* thisCell = getCellAt(cellCenterX + it->x, cellCenterY + it->y);
-			if (thisCell == nullptr)
+			if (thisCell == nullptr || thisCell->getCoiCount() == 0)
 				continue;
 
-			for (CellAndObjectIntersection *thisCoi = thisCell->getFirstCoiInCell(); thisCoi; thisCoi = thisCoi->getNextCoi())
-			{
-				PartitionData *thisMod = thisCoi->getModule();
-				Object *thisObj = thisMod->getObject();
-
-				// never compare against ourself.
-				if (thisObj == obj || thisObj == nullptr)
-					continue;
-
-				// since an object can exist in multiple COIs, we use this to avoid processing
-				// the same one more than once.
-				if (thisMod->friend_getDoneFlag() == theIterFlag)
-					continue;
-				thisMod->friend_setDoneFlag(theIterFlag);
-
-				Real thisDistSqr;
-				Coord3D distVec;
-				if (!(*distProc)(objPos, objToUse, thisObj->getPosition(), thisObj, thisDistSqr, distVec, closestDistSqr))
-					continue;
-
-				if (!filtersAllow(filters, thisObj))
-					continue;
-
-				// ok, this is within the range, and the filters allow it.
-				// add it to the iter, if we have one....
-				if (iterArg)
-				{
-					iterArg->insert(thisObj, thisDistSqr);
-				}
-				else
-				{
-					// hey, this is the new closest object! cool.
-					// (note that we can't break out now 'cuz we have to finish examining the
-					// rest of curRadius)
-					closestObj = thisObj;
-					closestDistSqr = thisDistSqr;
-					closestVec = distVec;
-
-					if (!foundAny)
-					{
-						// if not adding to iterArg, we want to stop once we have the closest object.
-						maxRadiusLimit = curRadius;
-					}
-					foundAny = true;
-				}
-
-			}
+			scanCellForClosestObjects(thisCell, curRadius, scan);
 		}
   }
 
+	closestObj = scan.closestObj;
+	closestDistSqr = scan.closestDistSqr;
+	if (scan.foundAny)
+		closestVec = scan.closestVec;
+
 #else // not FASTER_GCO
 
+	DistCalcProc distProc = theDistCalcProcs[dc];
+
 	CellOutwardIterator iter(this, cellCenterX, cellCenterY);
 	if (maxDist < HUGE_DIST)
 	{
@@ -3497,6 +3769,103 @@ Object *PartitionManager::getClosestObject(
 	return getClosestObjects(nullptr, pos, maxDist, dc, filters, nullptr, closestDist, closestDistVec);
 }
 
+//-----------------------------------------------------------------------------
+#ifdef FASTER_GCO
+struct BatchQueryCell
+{
+	Int cellX;
+	Int cellY;
+	Int query;
+
+	Bool operator<(const BatchQueryCell& other) const
+	{
+		if (cellY != other.cellY)
+			return cellY < other.cellY;
+		if (cellX != other.cellX)
+			return cellX < other.cellX;
+		return query < other.query;
+	}
+};
+#endif
+
+//-----------------------------------------------------------------------------
+void PartitionManager::getClosestObjectsBatch(PartitionQuery *queries, Int numQueries)
+{
+#ifdef FASTER_GCO
+	// TheSuperHackers @performance Queries around the same cell walk the same cells outwards, so they scan
+	// each cell together while its packed arrays are in the cache. Every query still visits its cells in the
+	// same order as getClosestObjects, so the results are the same as those of sequential calls.
+	std::vector<BatchQueryCell> order(numQueries);
+	std::vector<ClosestObjectsScan> scans(numQueries);
+	std::vector< std::vector<PartitionData*> > seenModules(numQueries);
+	Int i;
+	for (i = 0; i < numQueries; ++i)
+	{
+		PartitionQuery& query = queries[i];
+		DEBUG_ASSERTCRASH((query.obj==nullptr) != (query.pos == nullptr), ("either obj or pos must be null"));
+		const Coord3D *objPos = query.pos ? query.pos : query.obj->getPosition();
+		const Object *objToUse = query.pos ? nullptr : query.obj;
+
+		initClosestObjectsScan(scans[i], query.obj, objPos, objToUse, query.maxDist, query.dc, query.filters, query.iter);
+		scans[i].seenModules = &seenModules[i];
+
+		worldToCell(objPos->x, objPos->y, &order[i].cellX, &order[i].cellY);
+		order[i].query = i;
+	}
+	std::sort(order.begin(), order.end());
+
+	Int groupBegin = 0;
+	while (groupBegin < numQueries)
+	{
+		const Int cellCenterX = order[groupBegin].cellX;
+		const Int cellCenterY = order[groupBegin].cellY;
+		Int groupEnd = groupBegin + 1;
+		while (groupEnd < numQueries && order[groupEnd].cellX == cellCenterX && order[groupEnd].cellY == cellCenterY)
+			++groupEnd;
+
+		for (Int curRadius = 0; ; ++curRadius)
+		{
+			// the queries stop at different radii, and the ones that found their closest object stop early.
+			Int groupRadiusLimit = -1;
+			for (i = groupBegin; i < groupEnd; ++i)
+				groupRadiusLimit = maxInt(groupRadiusLimit, scans[order[i].query].maxRadiusLimit);
+			if (curRadius > groupRadiusLimit)
+				break;
+
+			const OffsetVec& offsets = m_radiusVec[curRadius];
+			for (OffsetVec::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
+			{
+				PartitionCell* thisCell = getCellAt(cellCenterX + it->x, cellCenterY + it->y);
+				if (thisCell == nullptr || thisCell->getCoiCount() == 0)
+					continue;
+
+				for (i = groupBegin; i < groupEnd; ++i)
+				{
+					ClosestObjectsScan& scan = scans[order[i].query];
+					if (curRadius <= scan.maxRadiusLimit)
+						scanCellForClosestObjects(thisCell, curRadius, scan);
+				}
+			}
+		}
+
+		groupBegin = groupEnd;
+	}
+
+	for (i = 0; i < numQueries; ++i)
+	{
+		queries[i].closestObj = scans[i].closestObj;
+		queries[i].closestDist = (Real)sqrtf(scans[i].closestDistSqr);
+		queries[i].closestVec = scans[i].closestVec;
+	}
+#else
+	for (Int i = 0; i < numQueries; ++i)
+	{
+		PartitionQuery& query = queries[i];
+		query.closestObj = getClosestObjects(query.obj, query.pos, query.maxDist, query.dc, query.filters, query.iter, &query.closestDist, &query.closestVec);
+	}
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void PartitionManager::getVectorTo(const Object *obj, const Object *otherObj, DistanceCalculationType dc, Coord3D& vec)
 {
@@ -5026,6 +5026,22 @@ void AIUpdateInterface::xfer( Xfer *xfer )
 		xfer->xferInt(&repulsorCountdown);
 	}
 
+	// TheSuperHackers @bugfix A replay checkpoint must continue exactly like the recorded game, so it also
+	// keeps the path timing and blocking state that a save game gets away with recomputing.
+	if (xfer->getOptions() & XO_REPLAY_CHECKPOINT)
+	{
+		xfer->xferUnsignedInt(&m_pathTimestamp);
+		xfer->xferInt(&m_blockedFrames);
+		xfer->xferReal(&m_curMaxBlockedSpeed);
+		xfer->xferReal(&m_bumpSpeedLimit);
+		xfer->xferInt(&m_nextGoalPathIndex);
+		xfer->xferBool(&m_isMoving);
+		xfer->xferBool(&m_isBlocked);
+		xfer->xferBool(&m_isBlockedAndStuck);
+		xfer->xferBool(&m_retryPath);
+		xfer->xferBool(&m_allowedToChase);
+	}
+
 }
 
 // ------------------------------------------------------------------------------------------------
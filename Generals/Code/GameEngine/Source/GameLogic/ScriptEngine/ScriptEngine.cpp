@@ -54,6 +54,7 @@
 #include "GameLogic/ScriptActions.h"
 #include "GameLogic/ScriptConditions.h"
 #include "GameLogic/ScriptEngine.h"
+#include "GameLogic/ScriptProfiler.h"
 #include "GameLogic/SidesList.h"
 
 
@@ -379,9 +380,12 @@ m_conditionTeam(nullptr),
 m_conditionObject(nullptr),
 m_currentPlayer(nullptr),
 m_skirmishHumanPlayer(nullptr),
+m_scriptIndicesValid(false),
+m_objectTypeListGeneration(1),
 m_fade(FADE_NONE),
 m_freezeByScript(FALSE),
 m_frameObjectCountChanged(0),
+m_objectRosterStamp(0),
 m_closeWindowTimer(0),
 m_curFadeFrame(0),
 m_curFadeValue(0.0f),
@@ -433,6 +437,9 @@ ScriptEngine::~ScriptEngine()
 #endif
 
 	reset(); // just in case.
+
+	delete TheScriptProfiler;
+	TheScriptProfiler = nullptr;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -471,6 +478,10 @@ void ScriptEngine::init( void )
 	_initVTune();
 #endif
 
+	if (TheGlobalData->m_scriptProfileFileName.isNotEmpty() && TheScriptProfiler == nullptr) {
+		TheScriptProfiler = NEW ScriptProfiler;
+	}
+
 #ifdef SPECIAL_SCRIPT_PROFILING
 #ifdef DEBUG_LOGGING
 	m_numFrames=0;
@@ -4582,6 +4593,9 @@ void ScriptEngine::reset( void )
 		m_flags[i].value = false;
 		m_flags[i].name.clear();
 	}
+	m_counterIndex.clear();
+	m_flagIndex.clear();
+	m_scriptIndicesValid = false;
 
 	m_breezeInfo.m_direction = PI/3;
 	m_breezeInfo.m_directionVec.x = Sin(m_breezeInfo.m_direction);
@@ -4596,6 +4610,16 @@ void ScriptEngine::reset( void )
 	m_objectsShouldReceiveDifficultyBonus = TRUE;
 	m_ChooseVictimAlwaysUsesNormal = false;
 
+	// TheSuperHackers @feature Write the script profile of all maps so far at the end of every map.
+	if (TheScriptProfiler && TheScriptProfiler->hasData()) {
+		if (TheScriptProfiler->writeReport(TheGlobalData->m_scriptProfileFileName)) {
+			printf("Script profile written to \"%s\"\n", TheGlobalData->m_scriptProfileFileName.str());
+		} else {
+			printf("Cannot write script profile \"%s\"\n", TheGlobalData->m_scriptProfileFileName.str());
+		}
+		TheScriptProfiler->printTopOffenders(stdout, 10);
+	}
+
 #ifdef SPECIAL_SCRIPT_PROFILING
 #ifdef DEBUG_LOGGING
 	if (m_numFrames > 1) {
@@ -4672,12 +4696,13 @@ void ScriptEngine::reset( void )
 		}
 	}
 	DEBUG_ASSERTCRASH( m_allObjectTypeLists.empty() == TRUE, ("ScriptEngine::reset - m_allObjectTypeLists should be empty but is not!") );
+	++m_objectTypeListGeneration;
 
 	// reset all the reveals that have taken place.
 	m_namedReveals.clear();
 
 	// Clear the named objects list.
- 	m_namedObjects.clear();
+	clearNamedObjects();
 
 	m_completedVideo.clear();
 	m_testingSpeech.clear();
@@ -4724,6 +4749,9 @@ void ScriptEngine::newMap( void )
 		m_flags[i].value = false;
 		m_flags[i].name.clear();
 	}
+	m_counterIndex.clear();
+	m_flagIndex.clear();
+	m_scriptIndicesValid = false;
 	m_endGameTimer = -1;
 	m_closeWindowTimer = -1;
 #ifdef SPECIAL_SCRIPT_PROFILING
@@ -4755,11 +4783,13 @@ void ScriptEngine::newMap( void )
 		Script *pScr;
 		for (pScr = pSL->getScript(); pScr; pScr=pScr->getNext()) {
 			checkConditionsForTeamNames(pScr);
+			bindParameters(pScr);
 		}
 		ScriptGroup *pGroup;
 		for (pGroup = pSL->getScriptGroup(); pGroup; pGroup=pGroup->getNext()) {
 			for (pScr = pGroup->getScript(); pScr; pScr=pScr->getNext()) {
 				checkConditionsForTeamNames(pScr);
+				bindParameters(pScr);
 			}
 		}
 	}
@@ -5050,12 +5080,9 @@ void ScriptEngine::clearFlag(const AsciiString &name)
 	for (j=0; j<MAX_PLAYER_COUNT; j++) {
 		AsciiString modName;
 		modName.format("%s%d", name.str(), j);
-		// Note - flags start at 1.  0 means not assigned.
-		Int i;
-		for (i=1; i<m_numFlags; i++) {
-			if ((modName==m_flags[i].name)) {
-				m_flags[i].value = FALSE;
-			}
+		ScriptNameIndexMap::const_iterator it = m_flagIndex.find(modName);
+		if (it != m_flagIndex.end()) {
+			m_flags[it->second].value = FALSE;
 		}
 	}
 }
@@ -5173,6 +5200,17 @@ ObjectTypes *ScriptEngine::getObjectTypes(const AsciiString& objectTypeList)
 	return nullptr;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** The list is bound to the parameter, and looked up again only after a list was created or destroyed. */
+//-------------------------------------------------------------------------------------------------
+ObjectTypes *ScriptEngine::getObjectTypes(Parameter *pTypeParm)
+{
+	if (pTypeParm->getBoundObjectTypesGeneration() != m_objectTypeListGeneration) {
+		pTypeParm->friend_bindObjectTypes(getObjectTypes(pTypeParm->getString()), m_objectTypeListGeneration);
+	}
+	return pTypeParm->getBoundObjectTypes();
+}
+
 //-------------------------------------------------------------------------------------------------
 /** doObjectTypeListMaintenance */
 /** If addObject is false, remove the object. If it is true, add the object. */
@@ -5185,6 +5223,7 @@ void ScriptEngine::doObjectTypeListMaintenance(const AsciiString& objectTypeList
 	if (!currentObjectTypeVec) {
 		ObjectTypes *newVec = newInstance(ObjectTypes)(objectTypeList);
 		m_allObjectTypeLists.push_back(newVec);
+		++m_objectTypeListGeneration;
 		currentObjectTypeVec = newVec;
 	}
 
@@ -5247,12 +5286,41 @@ PolygonTrigger *ScriptEngine::getQualifiedTriggerAreaByName( AsciiString name )
 	return trig;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Returns the bound trigger area of the parameter. Skirmish perimeters depend on the current
+	* player and missing trigger areas need their warning, so they are looked up by name. */
+//-------------------------------------------------------------------------------------------------
+PolygonTrigger *ScriptEngine::getQualifiedTriggerArea( const Parameter *pTriggerParm )
+{
+	PolygonTrigger *trig = pTriggerParm->getBoundTriggerArea();
+	if (trig) {
+		return trig;
+	}
+	return getQualifiedTriggerAreaByName(pTriggerParm->getString());
+}
+
 
 
 //-------------------------------------------------------------------------------------------------
 /** getTeamNamed */
 //-------------------------------------------------------------------------------------------------
 Team * ScriptEngine::getTeamNamed(const AsciiString& teamName)
+{
+	return getTeamNamedImpl(teamName, nullptr);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** getTeamNamed */
+//-------------------------------------------------------------------------------------------------
+Team * ScriptEngine::getTeamNamed(const Parameter *pTeamParm)
+{
+	return getTeamNamedImpl(pTeamParm->getString(), pTeamParm->getBoundTeamPrototype());
+}
+
+//-------------------------------------------------------------------------------------------------
+/** If theTeamProto is not null, it is the prototype of teamName, bound by bindParameters. */
+//-------------------------------------------------------------------------------------------------
+Team * ScriptEngine::getTeamNamedImpl(const AsciiString& teamName, TeamPrototype *theTeamProto)
 {
 	if (teamName == THIS_TEAM) {
 		if (m_callingTeam)
@@ -5265,7 +5333,9 @@ Team * ScriptEngine::getTeamNamed(const AsciiString& teamName)
 	if (m_conditionTeam && m_conditionTeam->getName() == teamName) {
 		return m_conditionTeam;
 	}
-	TeamPrototype *theTeamProto = TheTeamFactory->findTeamPrototype( teamName );
+	if (theTeamProto == nullptr) {
+		theTeamProto = TheTeamFactory->findTeamPrototype( teamName );
+	}
 	if (theTeamProto == nullptr) return nullptr;
 	if (theTeamProto->getIsSingleton()) {
 		Team *theTeam = theTeamProto->getFirstItemIn_TeamInstanceList();
@@ -5298,10 +5368,9 @@ Object * ScriptEngine::getUnitNamed(const AsciiString& unitName)
 		return m_conditionObject;
 	}
 
-	for (VecNamedRequestsIt it = m_namedObjects.begin(); it != m_namedObjects.end(); ++it) {
-		if (unitName == (it->first)) {
-			return it->second;
-		}
+	ScriptNameIndexMap::const_iterator it = m_namedObjectIndex.find(unitName);
+	if (it != m_namedObjectIndex.end()) {
+		return m_namedObjects[it->second].second;
 	}
 	return nullptr;
 }
@@ -5311,10 +5380,9 @@ Object * ScriptEngine::getUnitNamed(const AsciiString& unitName)
 //-------------------------------------------------------------------------------------------------
 Bool ScriptEngine::didUnitExist(const AsciiString& unitName)
 {
-	for (VecNamedRequestsIt it = m_namedObjects.begin(); it != m_namedObjects.end(); ++it) {
-		if (unitName == (it->first)) {
-			return (it->second == nullptr);
-		}
+	ScriptNameIndexMap::const_iterator it = m_namedObjectIndex.find(unitName);
+	if (it != m_namedObjectIndex.end()) {
+		return (m_namedObjects[it->second].second == nullptr);
 	}
 	return false;
 }
@@ -5427,16 +5495,16 @@ Int ScriptEngine::allocateCounter( const AsciiString& name)
 {
 	Int i;
 	// Note - counters start at 1.  0 means not assigned.
-	for (i=1; i<m_numCounters; i++) {
-		if (name==m_counters[i].name) {
-			return i;
-		}
+	ScriptNameIndexMap::const_iterator it = m_counterIndex.find(name);
+	if (it != m_counterIndex.end()) {
+		return it->second;
 	}
 	DEBUG_ASSERTCRASH(m_numCounters<MAX_COUNTERS, ("Too many counters, failed to make '%s'.", name.str()));
 	if (m_numCounters < MAX_COUNTERS) {
 		m_counters[m_numCounters].name = name;
 		i = m_numCounters;
 		m_numCounters++;
+		m_counterIndex[name] = i;
 		return(i);
 	}
 	return 0; // Shouldn't ever happen.
@@ -5447,13 +5515,10 @@ Int ScriptEngine::allocateCounter( const AsciiString& name)
 //-------------------------------------------------------------------------------------------------
 const TCounter *ScriptEngine::getCounter(const AsciiString& counterName)
 {
-	Int i;
-	for (i=1; i<m_numCounters; i++)
+	ScriptNameIndexMap::const_iterator it = m_counterIndex.find(counterName);
+	if (it != m_counterIndex.end())
 	{
-		if (counterName == m_counters[i].name)
-		{
-			return &(m_counters[i]);
-		}
+		return &(m_counters[it->second]);
 	}
 	return nullptr;
 }
@@ -5565,36 +5630,48 @@ Int ScriptEngine::allocateFlag( const AsciiString& name)
 {
 	Int i;
 	// Note - flags start at 1.  0 means not assigned.
-	for (i=1; i<m_numFlags; i++) {
-		if ((name==m_flags[i].name)) {
-			return i;
-		}
+	ScriptNameIndexMap::const_iterator it = m_flagIndex.find(name);
+	if (it != m_flagIndex.end()) {
+		return it->second;
 	}
 	DEBUG_ASSERTCRASH(m_numFlags < MAX_FLAGS, ("Too many flags, failed to make '%s'..", name.str()));
 	if (m_numFlags < MAX_FLAGS) {
 		m_flags[m_numFlags].name = name;
 		i = m_numFlags;
 		m_numFlags++;
+		m_flagIndex[name] = i;
 		return(i);
 	}
 	return 0; // Shouldn't ever happen.
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Rebuilds the counter and flag indices after the counters and flags were loaded. */
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::rebuildCounterAndFlagIndices()
+{
+	Int i;
+	m_counterIndex.clear();
+	for (i=1; i<m_numCounters; i++) {
+		m_counterIndex.insert(ScriptNameIndexMap::value_type(m_counters[i].name, i));
+	}
+	m_flagIndex.clear();
+	for (i=1; i<m_numFlags; i++) {
+		m_flagIndex.insert(ScriptNameIndexMap::value_type(m_flags[i].name, i));
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Locates a group by name. */
 //-------------------------------------------------------------------------------------------------
 ScriptGroup  *ScriptEngine::findGroup(const AsciiString& name)
 {
-	Int i;
-	for (i=0; i<TheSidesList->getNumSides(); i++) {
-		ScriptList *pSL = TheSidesList->getSideInfo(i)->getScriptList();
-		if (pSL==nullptr) continue;
-		ScriptGroup *pGroup;
-		for (pGroup = pSL->getScriptGroup(); pGroup; pGroup=pGroup->getNext()) {
-			if (pGroup->getName() == name) {
-				return pGroup;
-			}
-		}
+	if (!m_scriptIndicesValid) {
+		buildScriptIndices();
+	}
+	ScriptGroupIndexMap::const_iterator it = m_scriptGroupIndex.find(name);
+	if (it != m_scriptGroupIndex.end()) {
+		return it->second;
 	}
 	return nullptr; // Shouldn't ever happen.
 }
@@ -5604,26 +5681,43 @@ ScriptGroup  *ScriptEngine::findGroup(const AsciiString& name)
 //-------------------------------------------------------------------------------------------------
 Script  *ScriptEngine::findScript(const AsciiString& name)
 {
+	if (!m_scriptIndicesValid) {
+		buildScriptIndices();
+	}
+	ScriptIndexMap::const_iterator it = m_scriptIndex.find(name);
+	if (it != m_scriptIndex.end()) {
+		return it->second;
+	}
+	return nullptr; // Shouldn't ever happen.
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Indexes the scripts and script groups of the sides list by name. The sides, and the scripts
+	* of a side before the scripts in its groups, are visited in the order the lookups used to scan
+	* them, and the first one of a name is kept. */
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::buildScriptIndices()
+{
+	m_scriptIndex.clear();
+	m_scriptGroupIndex.clear();
+	m_scriptIndicesValid = true;
+
 	Int i;
 	for (i=0; i<TheSidesList->getNumSides(); i++) {
 		ScriptList *pSL = TheSidesList->getSideInfo(i)->getScriptList();
 		if (pSL==nullptr) continue;
 		Script *pScr;
 		for (pScr = pSL->getScript(); pScr; pScr=pScr->getNext()) {
-			if ((name==pScr->getName())) {
-				return pScr;
-			}
+			m_scriptIndex.insert(ScriptIndexMap::value_type(pScr->getName(), pScr));
 		}
 		ScriptGroup *pGroup;
 		for (pGroup = pSL->getScriptGroup(); pGroup; pGroup=pGroup->getNext()) {
+			m_scriptGroupIndex.insert(ScriptGroupIndexMap::value_type(pGroup->getName(), pGroup));
 			for (pScr = pGroup->getScript(); pScr; pScr=pScr->getNext()) {
-				if ((name==pScr->getName())) {
-					return pScr;
-				}
+				m_scriptIndex.insert(ScriptIndexMap::value_type(pScr->getName(), pScr));
 			}
 		}
 	}
-	return nullptr; // Shouldn't ever happen.
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -6003,6 +6097,7 @@ void ScriptEngine::removeObjectTypes(ObjectTypes *typesToRemove)
 
 	// remove it from the main array of stuff
 	m_allObjectTypeLists.erase(it);
+	++m_objectTypeListGeneration;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -6237,6 +6332,45 @@ void ScriptEngine::checkConditionsForTeamNames(Script *pScript)
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Binds the names in the condition parameters of the script to the trigger areas, team
+	* prototypes and thing templates they refer to, so that the conditions do not look them up
+	* every time they are evaluated. These do not come and go during a game. Names that cannot
+	* be bound, like THIS_TEAM or the skirmish perimeters, are still looked up by name. */
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::bindParameters(Script *pScript)
+{
+	OrCondition *pOr;
+	for (pOr = pScript->getOrCondition(); pOr; pOr = pOr->getNextOrCondition()) {
+		Condition *pCondition;
+		for (pCondition = pOr->getFirstAndCondition(); pCondition; pCondition = pCondition->getNext()) {
+			Int i;
+			for (i=0; i<pCondition->getNumParameters(); i++) {
+				Parameter *pParm = pCondition->getParameter(i);
+				const AsciiString& name = pParm->getString();
+				if (name.isEmpty()) continue;
+				switch (pParm->getParameterType()) {
+					case Parameter::TRIGGER_AREA:
+						if (name == MY_INNER_PERIMETER || name == MY_OUTER_PERIMETER ||
+								name == ENEMY_INNER_PERIMETER || name == ENEMY_OUTER_PERIMETER) {
+							break;
+						}
+						pParm->friend_bindTriggerArea(TheTerrainLogic->getTriggerAreaByName(name));
+						break;
+					case Parameter::TEAM:
+						pParm->friend_bindTeamPrototype(TheTeamFactory->findTeamPrototype(name));
+						break;
+					case Parameter::OBJECT_TYPE:
+						pParm->friend_bindThingTemplate(TheThingFactory->findTemplate(name, FALSE));
+						break;
+					default:
+						break;
+				}
+			}
+		}
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Executes a script. */
 //-------------------------------------------------------------------------------------------------
@@ -6267,6 +6401,12 @@ void ScriptEngine::executeScript( Script *pScript )
 	if (delaySeconds>0) {
 		pScript->setFrameToEvaluate(TheGameLogic->getFrame()+delaySeconds*LOGICFRAMES_PER_SECOND);
 	}
+	UnsignedInt64 profileStartCycles = 0;
+	Bool fired = false;
+	if (TheScriptProfiler) {
+		TheScriptProfiler->beginScript();
+		profileStartCycles = ScriptProfiler::getCycles();
+	}
 #ifdef DEBUG_LOGGING
 #ifdef SPECIAL_SCRIPT_PROFILING
 	__int64 startTime64;
@@ -6291,6 +6431,7 @@ void ScriptEngine::executeScript( Script *pScript )
 			m_conditionTeam = iter.cur();
 			// If conditions evaluate to true, execute actions.
 			if (evaluateConditions(pScript)) {
+				fired = true;
 				// Script Debug window
 				if (pScript->getAction()) {
 					_appendMessage(pScript->getName());
@@ -6314,6 +6455,7 @@ void ScriptEngine::executeScript( Script *pScript )
 		m_conditionTeam = nullptr;
 		// If conditions evaluate to true, execute actions.
 		if (evaluateConditions(pScript)) {
+			fired = true;
 			if (pScript->getAction()) {
 				// Script Debug window
 				_appendMessage(pScript->getName());
@@ -6342,6 +6484,9 @@ void ScriptEngine::executeScript( Script *pScript )
 	pScript->setCurTime(timeToEvaluate);
 #endif
 #endif
+	if (TheScriptProfiler) {
+		TheScriptProfiler->endScript(pScript, ScriptProfiler::getCycles() - profileStartCycles, fired);
+	}
 
 	m_conditionTeam = pSavConditionTeam;
 }
@@ -6394,35 +6539,38 @@ void ScriptEngine::addObjectToCache(Object* pNewObject)
 		return;
 	}
 
-	for (VecNamedRequestsIt it = m_namedObjects.begin(); it != m_namedObjects.end(); ++it) {
-		if (it->first == objName) {
-			if (it->second == nullptr) {
-				AsciiString newNameForDead;
-				newNameForDead.format("Reassigning dead object's name '%s' to object (%d) of type '%s'", objName.str(), pNewObject->getID(), pNewObject->getTemplate()->getName().str());
-				AppendDebugMessage(newNameForDead, FALSE);
-				DEBUG_LOG((newNameForDead.str()));
-				it->second = pNewObject;
-				return;
-			} else {
-				DEBUG_CRASH(("Attempting to assign the name '%s' to object (%d) of type '%s',"
-										 " but object (%d) of type '%s' already has that name",
-										 objName.str(), pNewObject->getID(), pNewObject->getTemplate()->getName().str(),
-										 it->second->getID(), it->second->getTemplate()->getName().str()));
-				return;
-			}
-		}
-
-		if (pNewObject == (it->second)) {
-			it->first = objName;
+	// The first entry with either the name or the object is the one that changes.
+	ScriptNameIndexMap::const_iterator nameIt = m_namedObjectIndex.find(objName);
+	ScriptObjectIndexMap::const_iterator objIt = m_namedObjectIndexByID.find(pNewObject->getID());
+	const Int nameIndex = (nameIt != m_namedObjectIndex.end()) ? nameIt->second : -1;
+	const Int objIndex = (objIt != m_namedObjectIndexByID.end()) ? objIt->second : -1;
+
+	if (nameIndex >= 0 && (objIndex < 0 || nameIndex <= objIndex)) {
+		Object *namedObj = m_namedObjects[nameIndex].second;
+		if (namedObj == nullptr) {
+			AsciiString newNameForDead;
+			newNameForDead.format("Reassigning dead object's name '%s' to object (%d) of type '%s'", objName.str(), pNewObject->getID(), pNewObject->getTemplate()->getName().str());
+			AppendDebugMessage(newNameForDead, FALSE);
+			DEBUG_LOG((newNameForDead.str()));
+			setNamedObject(nameIndex, pNewObject);
+			return;
+		} else {
+			DEBUG_CRASH(("Attempting to assign the name '%s' to object (%d) of type '%s',"
+									 " but object (%d) of type '%s' already has that name",
+									 objName.str(), pNewObject->getID(), pNewObject->getTemplate()->getName().str(),
+									 namedObj->getID(), namedObj->getTemplate()->getName().str()));
 			return;
 		}
 	}
 
-	NamedRequest req;
-	req.first = objName;
-	req.second = pNewObject;
+	if (objIndex >= 0) {
+		// Renaming a cached object is rare, so the name index is simply rebuilt.
+		m_namedObjects[objIndex].first = objName;
+		rebuildNamedObjectIndices();
+		return;
+	}
 
-	m_namedObjects.push_back(req);
+	addNamedObject(objName, pNewObject);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -6430,10 +6578,66 @@ void ScriptEngine::addObjectToCache(Object* pNewObject)
 //-------------------------------------------------------------------------------------------------
 void ScriptEngine::removeObjectFromCache( Object* pDeadObject )
 {
-	for (VecNamedRequestsIt it = m_namedObjects.begin(); it != m_namedObjects.end(); ++it) {
-		if (pDeadObject == (it->second)) {
-			it->second = nullptr;	// Don't remove it, cause we want to check whether we ever knew a name later
-			break;
+	ScriptObjectIndexMap::const_iterator it = m_namedObjectIndexByID.find(pDeadObject->getID());
+	if (it != m_namedObjectIndexByID.end() && m_namedObjects[it->second].second == pDeadObject) {
+		setNamedObject(it->second, nullptr);	// Don't remove it, cause we want to check whether we ever knew a name later
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Appends an entry to the named object cache. The name and object indices keep their first entry. */
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::addNamedObject( const AsciiString& name, Object *obj )
+{
+	const Int index = (Int)m_namedObjects.size();
+	m_namedObjects.push_back(NamedRequest(name, obj));
+	m_namedObjectIndex.insert(ScriptNameIndexMap::value_type(name, index));
+	if (obj) {
+		m_namedObjectIndexByID.insert(ScriptObjectIndexMap::value_type(obj->getID(), index));
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Changes the object of an entry of the named object cache. */
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::setNamedObject( Int index, Object *obj )
+{
+	NamedRequest& req = m_namedObjects[index];
+	if (req.second) {
+		ScriptObjectIndexMap::iterator it = m_namedObjectIndexByID.find(req.second->getID());
+		if (it != m_namedObjectIndexByID.end() && it->second == index) {
+			m_namedObjectIndexByID.erase(it);
+		}
+	}
+	req.second = obj;
+	if (obj) {
+		ScriptObjectIndexMap::iterator it = m_namedObjectIndexByID.find(obj->getID());
+		if (it == m_namedObjectIndexByID.end()) {
+			m_namedObjectIndexByID.insert(ScriptObjectIndexMap::value_type(obj->getID(), index));
+		} else if (index < it->second) {
+			it->second = index;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::clearNamedObjects( void )
+{
+	m_namedObjects.clear();
+	m_namedObjectIndex.clear();
+	m_namedObjectIndexByID.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+void ScriptEngine::rebuildNamedObjectIndices( void )
+{
+	m_namedObjectIndex.clear();
+	m_namedObjectIndexByID.clear();
+	for (Int i = 0; i < (Int)m_namedObjects.size(); ++i) {
+		const NamedRequest& req = m_namedObjects[i];
+		m_namedObjectIndex.insert(ScriptNameIndexMap::value_type(req.first, i));
+		if (req.second) {
+			m_namedObjectIndexByID.insert(ScriptObjectIndexMap::value_type(req.second->getID(), i));
 		}
 	}
 }
@@ -6463,26 +6667,22 @@ void ScriptEngine::transferObjectName( const AsciiString& unitName, Object *pNew
 
 	pNewObject->setName(unitName); // make sure it has the correct name.
 
-	//Loop through the cached list and find the string entry. If found, change the object
+	//Find the string entry in the cached list. If found, change the object
 	//so it's pointing to the new one.
-	for( VecNamedRequestsIt it = m_namedObjects.begin(); it != m_namedObjects.end(); ++it )
+	ScriptNameIndexMap::const_iterator it = m_namedObjectIndex.find( unitName );
+	if( it != m_namedObjectIndex.end() )
 	{
-		if( !unitName.compare( it->first ) )
+		Object* pOldObj = m_namedObjects[ it->second ].second;
+		if( pOldObj )
 		{
-			Object* pOldObj = it->second;
-			if( pOldObj )
-			{
-				// if you are transferring your name, you should also transfer any custom indicator color you have.
-				if (pOldObj->hasCustomIndicatorColor())
-					pNewObject->setCustomIndicatorColor(pOldObj->getIndicatorColor());
-				else
-					pNewObject->removeCustomIndicatorColor();
-			}
-
-			it->second = pNewObject;
-
-			return;
+			// if you are transferring your name, you should also transfer any custom indicator color you have.
+			if (pOldObj->hasCustomIndicatorColor())
+				pNewObject->setCustomIndicatorColor(pOldObj->getIndicatorColor());
+			else
+				pNewObject->removeCustomIndicatorColor();
 		}
+
+		setNamedObject( it->second, pNewObject );
 	}
 
 }
@@ -6880,6 +7080,7 @@ Bool ScriptEngine::evaluateConditions( Script *pScript, Team *thisTeam, Player *
 	LatchRestore<Player*> latch2(m_currentPlayer, player);
 	OrCondition *pConditionHead = pScript->getOrCondition();
 	Bool testValue = false;
+	const UnsignedInt64 profileStartCycles = TheScriptProfiler ? ScriptProfiler::getCycles() : 0;
 
 #ifdef DEBUG_LOGGING
 #define COLLECT_CONDITION_EVAL_TIMES
@@ -6897,7 +7098,15 @@ Bool ScriptEngine::evaluateConditions( Script *pScript, Team *thisTeam, Player *
 		if (!pCondition) continue; // No conditions, so go to the next or.
 		Bool andTerm = true;
 		while (pCondition && andTerm) {
-			if (!evaluateCondition(pCondition)) {
+			Bool result;
+			if (TheScriptProfiler == nullptr) {
+				result = evaluateCondition(pCondition);
+			} else {
+				const UnsignedInt64 conditionStartCycles = ScriptProfiler::getCycles();
+				result = evaluateCondition(pCondition);
+				TheScriptProfiler->addCondition(pCondition, ScriptProfiler::getCycles() - conditionStartCycles, result);
+			}
+			if (!result) {
 				andTerm = false;
 				break; // Short circuit the and evauation - after the first false, we can quit.
 			}
@@ -6914,6 +7123,9 @@ Bool ScriptEngine::evaluateConditions( Script *pScript, Team *thisTeam, Player *
 	pScript->incrementConditionCount();
 	pScript->addToConditionTime(timeToEvaluate);
 #endif
+	if (TheScriptProfiler) {
+		TheScriptProfiler->addConditions(pScript, ScriptProfiler::getCycles() - profileStartCycles);
+	}
 
 	return testValue; // If none of the or's fired, then it is false.
 }
@@ -6928,6 +7140,7 @@ void ScriptEngine::executeActions( ScriptAction *pActionHead )
 	ScriptAction *pCurAction;
 	UnicodeString uStr1;
 	for (pCurAction = pActionHead; pCurAction; pCurAction = pCurAction->getNext()) {
+		const UnsignedInt64 profileStartCycles = TheScriptProfiler ? ScriptProfiler::getCycles() : 0;
 		switch (pCurAction->getActionType()) {
 			default: if (TheScriptActions) TheScriptActions->executeAction(pCurAction); break;
 			case ScriptAction::SET_COUNTER: setCounter(pCurAction);	break;
@@ -6961,6 +7174,9 @@ void ScriptEngine::executeActions( ScriptAction *pActionHead )
 
 			case ScriptAction::NO_OP: /* just break. */; break;
 		}
+		if (TheScriptProfiler) {
+			TheScriptProfiler->addAction(pCurAction, ScriptProfiler::getCycles() - profileStartCycles);
+		}
 	}
 }
 
@@ -7009,7 +7225,7 @@ const ConditionTemplate * ScriptEngine::getConditionTemplate( Int ndx )
 //-------------------------------------------------------------------------------------------------
 void ScriptEngine::createNamedCache( void )
 {
-	m_namedObjects.clear();
+	clearNamedObjects();
 
 	if( !TheGameLogic )
 	{
@@ -7019,10 +7235,7 @@ void ScriptEngine::createNamedCache( void )
 
 	while (pObj) {
 		if (!pObj->getName().isEmpty()) {
-			NamedRequest req;
-			req.first = pObj->getName();
-			req.second = pObj;
-			m_namedObjects.push_back(req);
+			addNamedObject(pObj->getName(), pObj);
 		}
 		pObj = pObj->getNextObject();
 	}
@@ -8246,6 +8459,9 @@ void ScriptEngine::xfer( Xfer *xfer )
 	// num flags
 	xfer->xferInt( &m_numFlags );
 
+	if( xfer->getXferMode() == XFER_LOAD )
+		rebuildCounterAndFlagIndices();
+
 	// attack priority info
 	UnsignedShort attackPriorityInfoSize = m_numAttackInfo;
 	xfer->xferUnsignedShort( &attackPriorityInfoSize );
@@ -8299,13 +8515,12 @@ void ScriptEngine::xfer( Xfer *xfer )
 	}
 	else
 	{
-		NamedRequest req;
 
 		//
 		// list should be empty, it is legal for it to not be empty at this point
 		// according to John M., so we're clearing it now
 		//
-		m_namedObjects.clear();
+		clearNamedObjects();
 
 		// read each element
 		for( UnsignedShort i = 0; i < namedObjectsCount; ++i )
@@ -8326,9 +8541,7 @@ void ScriptEngine::xfer( Xfer *xfer )
 			}
 
 			// assign
-			req.first = namedObjectName;
-			req.second = obj;
-			m_namedObjects.push_back( req );
+			addNamedObject( namedObjectName, obj );
 
 		}
 
@@ -8573,6 +8786,7 @@ void ScriptEngine::xfer( Xfer *xfer )
 
 				// put on list
 				m_allObjectTypeLists.push_back( objectTypes );
+				++m_objectTypeListGeneration;
 
 			}
 
@@ -8621,6 +8835,9 @@ void ScriptEngine::xfer( Xfer *xfer )
 void ScriptEngine::loadPostProcess( void )
 {
 
+	// the scripts of the sides list were loaded too
+	m_scriptIndicesValid = false;
+
 	// Now that we've loaded everything, go through and set them all back in sync with what we
 	// currently think they should be.
 	TheScriptActions->doEnableOrDisableObjectDifficultyBonuses(m_objectsShouldReceiveDifficultyBonus);
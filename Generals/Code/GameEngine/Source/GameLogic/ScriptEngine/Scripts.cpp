@@ -1729,6 +1729,7 @@ void Parameter::setCoord3D(const Coord3D *pLoc)
 void Parameter::qualify(const AsciiString& qualifier,
 			const AsciiString& playerTemplateName, const AsciiString& newPlayerName)
 {
+	unbind();
 	AsciiString tmpString;
 	switch (m_paramType) {
 		case SIDE:
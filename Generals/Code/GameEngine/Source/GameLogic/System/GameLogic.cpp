@@ -93,6 +93,7 @@
 #include "GameLogic/ScriptConditions.h"
 #include "GameLogic/ScriptEngine.h"
 #include "GameLogic/SidesList.h"
+#include "GameLogic/UpdateProfiler.h"
 #include "GameLogic/VictoryConditions.h"
 #include "GameLogic/Weapon.h"
 #include "GameLogic/GhostObject.h"
@@ -433,10 +434,6 @@ void GameLogic::reset( void )
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	m_normalUpdates.clear();
 #endif
-	for (std::vector<UpdateModulePtr>::iterator it = m_sleepyUpdates.begin(); it != m_sleepyUpdates.end(); ++it)
-	{
-		(*it)->friend_setIndexInLogic(-1);
-	}
 	m_sleepyUpdates.clear();
 	m_curUpdateModule = nullptr;
 
@@ -2205,9 +2202,9 @@ void GameLogic::processDestroyList( void )
 		UpdateModulePtr sleepyUpdatesForThisObject[MAX_SUO];
 		Int numSUO = 0;
 
-		for (std::vector<UpdateModulePtr>::iterator it2 = m_sleepyUpdates.begin(); it2 != m_sleepyUpdates.end(); ++it2)
+		for (Int i2 = 0; i2 < m_sleepyUpdates.size(); ++i2)
 		{
-			UpdateModulePtr u = *it2;
+			UpdateModulePtr u = m_sleepyUpdates.getAt(i2);
 			if (u->friend_getObject() == currentObject && numSUO < MAX_SUO)
 			{
 				sleepyUpdatesForThisObject[numSUO++] = u;
@@ -2216,10 +2213,8 @@ void GameLogic::processDestroyList( void )
 
 		for (--numSUO; numSUO >= 0; --numSUO)
 		{
-			// have to re-get idx each time since each call to erase might change others.
-			Int idx = sleepyUpdatesForThisObject[numSUO]->friend_getIndexInLogic();
-			DEBUG_ASSERTCRASH(m_sleepyUpdates[idx] == sleepyUpdatesForThisObject[numSUO], ("Hmm, expected update mismatch here"));
-			eraseSleepyUpdate(idx);
+			DEBUG_ASSERTCRASH(m_sleepyUpdates.contains(sleepyUpdatesForThisObject[numSUO]), ("Hmm, expected update mismatch here"));
+			eraseSleepyUpdate(sleepyUpdatesForThisObject[numSUO]);
 			DEBUG_ASSERTCRASH(sleepyUpdatesForThisObject[numSUO]->friend_getIndexInLogic() == -1, ("Hmm, expected index to be -1 here"));
 		}
 
@@ -2427,193 +2422,38 @@ inline void GameLogic::validateSleepyUpdate() const
 	#define SLEEPY_DEBUG
 #endif
 #ifdef SLEEPY_DEBUG
-	int sz = m_sleepyUpdates.size();
-	if (sz == 0)
-		return;
-
-	int i;
-	//DEBUG_LOG(("\n"));
-	//for (i = 0; i < sz; ++i)
-	//{
-	//	DEBUG_LOG(("u %04d: %08lx %08lx",i,m_sleepyUpdates[i],m_sleepyUpdates[i]->friend_getNextCallFrame()));
-	//}
-	for (i = 0; i < sz; ++i)
-	{
-		DEBUG_ASSERTCRASH(m_sleepyUpdates[i]->friend_getIndexInLogic() == i, ("index mismatch: expected %d, got %d",i,m_sleepyUpdates[i]->friend_getIndexInLogic()));
-		UnsignedInt pri = m_sleepyUpdates[i]->friend_getPriority();
-		if (i > 0)
-		{
-			Int i0 = (i+1)/2-1;
-			UnsignedInt pri0 = m_sleepyUpdates[i0]->friend_getPriority();
-			DEBUG_ASSERTCRASH(pri >= pri0, ("sleepyUpdates are munged (0)"));
-		}
-		Int i1 = 2*(i+1)-1;
-		Int i2 = 2*(i+1);
-		if (i1 < sz)
-		{
-			UnsignedInt pri1 = m_sleepyUpdates[i1]->friend_getPriority();
-			DEBUG_ASSERTCRASH(pri <= pri1, ("sleepyUpdates are munged (1)"));
-		}
-		if (i2 < sz)
-		{
-			UnsignedInt pri2 = m_sleepyUpdates[i2]->friend_getPriority();
-			DEBUG_ASSERTCRASH(pri <= pri2, ("sleepyUpdates are munged (2)"));
-		}
-	}
+	DEBUG_ASSERTCRASH(m_sleepyUpdates.validate(), ("sleepyUpdates are munged"));
 #endif
 }
 
 // ------------------------------------------------------------------------------------------------
-void GameLogic::eraseSleepyUpdate(Int i)
+void GameLogic::eraseSleepyUpdate(UpdateModulePtr u)
 {
 	USE_PERF_TIMER(SleepyMaintenance)
 
-	DEBUG_ASSERTCRASH(i >= 0 && i < m_sleepyUpdates.size(), ("bad sleepy idx"));
-
-	// swap with the final item, toss the final item, then rebalance
-	m_sleepyUpdates[i]->friend_setIndexInLogic(-1);
-
-	Int final = m_sleepyUpdates.size() - 1;
-	if (i < final)
-	{
-		m_sleepyUpdates[i] = m_sleepyUpdates[final];
-		m_sleepyUpdates[i]->friend_setIndexInLogic(i);
-		m_sleepyUpdates.pop_back();
-		rebalanceSleepyUpdate(i);
-	}
-	else
-	{
-		m_sleepyUpdates.pop_back();
-	}
-}
+	DEBUG_ASSERTCRASH(m_sleepyUpdates.contains(u), ("bad sleepy idx"));
 
-// ------------------------------------------------------------------------------------------------
-inline Bool isLowerPriority(const UpdateModulePtr a, const UpdateModulePtr b)
-{
-	// return true iff a is lower pri than b.
-	// remember: lower ordinal value means higher priority.
-	// therefore, higher ordinal value means lower priority.
-	DEBUG_ASSERTCRASH(a && b, ("these may no longer be null"));
-	UnsignedInt f1 = a->friend_getPriority();
-	UnsignedInt f2 = b->friend_getPriority();
-	return f1 > f2;
+	m_sleepyUpdates.erase(u);
 }
 
 // ------------------------------------------------------------------------------------------------
-Int GameLogic::rebalanceParentSleepyUpdate(Int i)
+void GameLogic::rescheduleSleepyUpdate(UpdateModulePtr u)
 {
 	USE_PERF_TIMER(SleepyMaintenance)
 
-	DEBUG_ASSERTCRASH(i >= 0 && i < m_sleepyUpdates.size(), ("bad sleepy idx"));
-
-	Int parent = ((i+1)>>1)-1;
-	while (parent >= 0 && isLowerPriority(m_sleepyUpdates[parent], m_sleepyUpdates[i]))
-	{
-		UpdateModulePtr a = m_sleepyUpdates[parent];
-		UpdateModulePtr b = m_sleepyUpdates[i];
+	DEBUG_ASSERTCRASH(m_sleepyUpdates.contains(u), ("bad sleepy idx"));
 
-		m_sleepyUpdates[i] = a;
-		m_sleepyUpdates[parent] = b;
-
-		a->friend_setIndexInLogic(i);
-		b->friend_setIndexInLogic(parent);
-
-		i = parent;
-		parent = ((parent+1)>>1)-1;
-	}
-
-	return i;
+	m_sleepyUpdates.reschedule(u);
 }
 
 // ------------------------------------------------------------------------------------------------
-Int GameLogic::rebalanceChildSleepyUpdate(Int i)
+void GameLogic::reschedulePeekedSleepyUpdate(UpdateModulePtr u)
 {
 	USE_PERF_TIMER(SleepyMaintenance)
 
-	DEBUG_ASSERTCRASH(i >= 0 && i < m_sleepyUpdates.size(), ("bad sleepy idx"));
-
-// this function gets the brunt of the work (we frequently
-// balance down, not up), so this one is hand-unrolled for
-// max efficiency. I have left the pristine non-unrolled
-// version present for clarity. (Yes, this is worth doing.) (srj)
-#if 1
-	UpdateModulePtr* pI = &m_sleepyUpdates[i];
-
-	// our children are i*2 and i*2+1
-  Int child = ((i)<<1)+1;
-	UpdateModulePtr* pChild = &m_sleepyUpdates[0] + child;
-	UpdateModulePtr* pSZ = &m_sleepyUpdates[0] + m_sleepyUpdates.size();	// yes, this is off the end.
-
-  while (pChild < pSZ)
-	{
-		// choose the higher-priority of the two children; we must be higher-pri than that.
-		if (pChild < pSZ-1 && isLowerPriority(*pChild, *(pChild+1)))
-		{
-      ++pChild;
-			++child;
-		}
-
-		// if we're higher-pri than our children, we're done.
-		if (!isLowerPriority(*pI, *pChild))
-		{
-			break;
-		}
-
-		// doh. swap with the highest-pri child we have.
-		UpdateModulePtr a = *pChild;
-		UpdateModulePtr b = *pI;
-
-		*pI = a;
-		*pChild = b;
-
-		a->friend_setIndexInLogic(i);
-		b->friend_setIndexInLogic(child);
-
-		i = child;
-		pI = pChild;
-
-		child = ((i)<<1)+1;
-		pChild = &m_sleepyUpdates[0] + child;
-  }
-#else
-	// our children are i*2 and i*2+1
-	Int sz = m_sleepyUpdates.size();
-  Int child = ((i)<<1)+1;
-  while (child < sz)
-	{
-		// choose the higher-priority of the two children; we must be higher-pri than that.
-		if (child < sz-1 && isLowerPriority(m_sleepyUpdates[child], m_sleepyUpdates[child+1]))
-      ++child;
-
-		// if we're higher-pri than our children, we're done.
-		if (!isLowerPriority(m_sleepyUpdates[i], m_sleepyUpdates[child]))
-		{
-			break;
-		}
-
-		// doh. swap with the highest-pri child we have.
-		UpdateModulePtr a = m_sleepyUpdates[child];
-		UpdateModulePtr b = m_sleepyUpdates[i];
+	DEBUG_ASSERTCRASH(m_sleepyUpdates.contains(u), ("bad sleepy idx"));
 
-		m_sleepyUpdates[i] = a;
-		m_sleepyUpdates[child] = b;
-
-		a->friend_setIndexInLogic(i);
-		b->friend_setIndexInLogic(child);
-		i = child;
-		child = ((i)<<1)+1;
-  }
-#endif
-	return i;
-}
-
-// ------------------------------------------------------------------------------------------------
-void GameLogic::rebalanceSleepyUpdate(Int i)
-{
-	USE_PERF_TIMER(SleepyMaintenance)
-
-	i = rebalanceParentSleepyUpdate(i);
-	i = rebalanceChildSleepyUpdate(i);
+	m_sleepyUpdates.reschedulePeeked(u);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2621,14 +2461,7 @@ void GameLogic::remakeSleepyUpdate()
 {
 	USE_PERF_TIMER(SleepyMaintenance)
 
-	Int parent = m_sleepyUpdates.size() / 2;
-  while (true)
-	{
-    rebalanceChildSleepyUpdate(parent);
-    if (parent == 0)
-			break;
-    --parent;
-  }
+	m_sleepyUpdates.remake();
 
 	validateSleepyUpdate();
 }
@@ -2640,10 +2473,7 @@ void GameLogic::pushSleepyUpdate(UpdateModulePtr u)
 
 	DEBUG_ASSERTCRASH(u != nullptr, ("You may not pass null for sleepy update info"));
 
-	m_sleepyUpdates.push_back(u);
-	u->friend_setIndexInLogic(m_sleepyUpdates.size() - 1);
-
-	rebalanceParentSleepyUpdate(m_sleepyUpdates.size()-1);
+	m_sleepyUpdates.push(u);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2651,37 +2481,11 @@ UpdateModulePtr GameLogic::peekSleepyUpdate() const
 {
 	USE_PERF_TIMER(SleepyMaintenance)
 
-	UpdateModulePtr u = m_sleepyUpdates.front();
-	DEBUG_ASSERTCRASH(u->friend_getIndexInLogic() == 0, ("index mismatch: expected %d, got %d",0,u->friend_getIndexInLogic()));
+	UpdateModulePtr u = m_sleepyUpdates.peek();
+	DEBUG_ASSERTCRASH(m_sleepyUpdates.contains(u), ("index mismatch: got %d",u->friend_getIndexInLogic()));
 	return u;
 }
 
-// ------------------------------------------------------------------------------------------------
-void GameLogic::popSleepyUpdate()
-{
-	USE_PERF_TIMER(SleepyMaintenance)
-
-	Int sz = m_sleepyUpdates.size();
-	if (sz == 0)
-	{
-		DEBUG_CRASH(("should not happen"));
-		return;
-	}
-
-	m_sleepyUpdates[0]->friend_setIndexInLogic(-1);
-	if (sz > 1)
-	{
-		m_sleepyUpdates[0] = m_sleepyUpdates[sz-1];
-		m_sleepyUpdates[0]->friend_setIndexInLogic(0);
-		m_sleepyUpdates.pop_back();
-		rebalanceChildSleepyUpdate(0);
-	}
-	else
-	{
-		m_sleepyUpdates.pop_back();
-	}
-}
-
 // ------------------------------------------------------------------------------------------------
 // this should be called only by UpdateModule, thanks.
 // ------------------------------------------------------------------------------------------------
@@ -2714,13 +2518,7 @@ void GameLogic::friend_awakenUpdateModule(Object* obj, UpdateModulePtr u, Unsign
 	Int idx = u->friend_getIndexInLogic();
 	if (obj->isInList(&m_objList))
 	{
-		if (idx < 0 || idx >= m_sleepyUpdates.size())
-		{
-			RELEASE_CRASH("fatal error! sleepy update module illegal index.");
-			return;
-		}
-
-		if (m_sleepyUpdates[idx] != u)
+		if (!m_sleepyUpdates.contains(u))
 		{
 			RELEASE_CRASH("fatal error! sleepy update module index mismatch.");
 			return;
@@ -2730,7 +2528,7 @@ void GameLogic::friend_awakenUpdateModule(Object* obj, UpdateModulePtr u, Unsign
 		u->friend_setNextCallFrame(whenToWakeUp);
 
 		// rebalance.
-		rebalanceSleepyUpdate(idx);
+		rescheduleSleepyUpdate(u);
 
 		// validate. (harmless except in debug mode)
 		validateSleepyUpdate();
@@ -3232,7 +3030,19 @@ void GameLogic::update( void )
 				//DEBUG_LOG(("calling update %08lx (%d %d)...",update,update->friend_getNextCallFrame(),update->friend_getNextCallPhase()));
 				m_curUpdateModule = u;
 
-				sleepLen = u->update();
+				if (TheUpdateProfiler == nullptr)
+				{
+					sleepLen = u->update();
+				}
+				else
+				{
+					const NameKeyType moduleNameKey = u->getModuleNameKey();
+					const ThingTemplate* thingTemplate = u->friend_getObject()->getTemplate();
+					const UnsignedInt64 startCycles = UpdateProfiler::getCycles();
+					sleepLen = u->update();
+					const UnsignedInt64 cycles = UpdateProfiler::getCycles() - startCycles;
+					TheUpdateProfiler->addUpdate(moduleNameKey, thingTemplate, cycles, sleepLen <= UPDATE_SLEEP_NONE);
+				}
 				DEBUG_ASSERTCRASH(sleepLen > 0, ("you may not return 0 from update"));
 				if (sleepLen < 1)
 					sleepLen = UPDATE_SLEEP_NONE;
@@ -3243,7 +3053,7 @@ void GameLogic::update( void )
 
 			// else defer it till next frame and re-push it
 			u->friend_setNextCallFrame(now + sleepLen);
-			rebalanceSleepyUpdate(0);
+			reschedulePeekedSleepyUpdate(u);
 		}
 	}
 
@@ -3294,6 +3104,10 @@ void GameLogic::update( void )
 	{
 		m_frame++;
 		m_hasUpdated = TRUE;
+
+		// TheSuperHackers @feature The end of the frame is the only place where the whole game can be saved consistently.
+		if (TheRecorder->isPlaybackMode())
+			TheRecorder->updatePlaybackCheckpoints();
 	}
 }
 
@@ -3455,6 +3269,7 @@ void GameLogic::destroyObject( Object *obj )
 
 	// mark object as destroyed
 	obj->setStatus( MAKE_OBJECT_STATUS_MASK( OBJECT_STATUS_DESTROYED ) );
+	TheScriptEngine->notifyOfObjectRosterChange();
 
 	// We desperately need to stop here, or else the destructor of the statemachine will try to do
 	// stopping logic, which uses virtual functions and deleted modules, which will crash us.
@@ -4167,6 +3982,9 @@ void GameLogic::xferObjectTOC( Xfer *xfer )
 void GameLogic::prepareLogicForObjectLoad( void )
 {
 
+	// only a replay checkpoint fills this in again, see xferSleepyUpdateOrder
+	m_loadedSleepyUpdateOrder.clear();
+
 	//
 	// this is a band-aid :(
 	// when loading from a map file, objects were created for the bridges, towers, walls etc.
@@ -4562,6 +4380,67 @@ void GameLogic::xfer( Xfer *xfer )
 		xfer->xferInt(&m_rankPointsToAddAtGameStart);
 	}
 
+	// TheSuperHackers @bugfix Modules that wake on the same frame run in the order of the sleepy update heap.
+	// A regular load rebuilds the heap, which can change that order, so replay checkpoints keep it as it was.
+	if (xfer->getOptions() & XO_REPLAY_CHECKPOINT)
+		xferSleepyUpdateOrder( xfer );
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Save/load the sleepy update heap as the object ID and update module number of each entry. On
+	* load, loadPostProcess puts the modules back into the heap in this order. */
+// ------------------------------------------------------------------------------------------------
+void GameLogic::xferSleepyUpdateOrder( Xfer *xfer )
+{
+	Int count = m_sleepyUpdates.size();
+	xfer->xferInt( &count );
+
+	if( xfer->getXferMode() == XFER_LOAD )
+	{
+		m_loadedSleepyUpdateOrder.clear();
+		m_loadedSleepyUpdateOrder.reserve( count );
+	}
+
+	for( Int i = 0; i < count; ++i )
+	{
+		ObjectID objectID = INVALID_ID;
+		Int moduleNumber = -1;
+		if( xfer->getXferMode() == XFER_SAVE )
+		{
+			UpdateModulePtr u = m_sleepyUpdates.getAt( i );
+			objectID = u->friend_getObject()->getID();
+			moduleNumber = 0;
+			for( BehaviorModule** b = u->friend_getObject()->getBehaviorModules(); *b; ++b, ++moduleNumber )
+			{
+				if( (UpdateModulePtr)((*b)->getUpdate()) == u )
+					break;
+			}
+		}
+
+		xfer->xferObjectID( &objectID );
+		xfer->xferInt( &moduleNumber );
+
+		if( xfer->getXferMode() == XFER_LOAD )
+		{
+			Object *obj = findObjectByID( objectID );
+			UpdateModulePtr u = nullptr;
+			if( obj != nullptr && moduleNumber >= 0 )
+			{
+				BehaviorModule** b = obj->getBehaviorModules();
+				for( Int m = 0; *b != nullptr && m < moduleNumber; ++m )
+					++b;
+				if( *b != nullptr )
+					u = (UpdateModulePtr)((*b)->getUpdate());
+			}
+
+			if( u == nullptr )
+			{
+				DEBUG_CRASH(( "GameLogic::xferSleepyUpdateOrder - No update module %d on object %d", moduleNumber, objectID ));
+				throw SC_INVALID_DATA;
+			}
+			m_loadedSleepyUpdateOrder.push_back( u );
+		}
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -4585,10 +4464,6 @@ void GameLogic::loadPostProcess( void )
 			m_nextObjID = (ObjectID)((UnsignedInt)obj->getID() + 1);
 
 	// blow away the sleepy update and normal update module lists
-	for (std::vector<UpdateModulePtr>::iterator it = m_sleepyUpdates.begin(); it != m_sleepyUpdates.end(); ++it)
-	{
-		(*it)->friend_setIndexInLogic(-1);
-	}
 	m_sleepyUpdates.clear();
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	m_normalUpdates.clear();
@@ -4631,8 +4506,7 @@ void GameLogic::loadPostProcess( void )
 				u->friend_setNextCallFrame(now);
 #endif
 			{
-				m_sleepyUpdates.push_back(u);
-				u->friend_setIndexInLogic(m_sleepyUpdates.size() - 1);
+				m_sleepyUpdates.pushUnsorted(u);
 			}
 
 		}
@@ -4642,4 +4516,37 @@ void GameLogic::loadPostProcess( void )
 	// re-sort the priority queue all at once now that all modules are on it
 	remakeSleepyUpdate();
 
+	// TheSuperHackers @bugfix A replay checkpoint restores the exact heap, so modules that wake on the same
+	// frame keep their order. It must hold the same modules as the heap rebuilt above.
+	if( !m_loadedSleepyUpdateOrder.empty() )
+	{
+		if( (Int)m_loadedSleepyUpdateOrder.size() != m_sleepyUpdates.size() )
+		{
+			DEBUG_CRASH(( "GameLogic::loadPostProcess - The checkpoint has %d sleepy updates, but the objects have %d",
+										(Int)m_loadedSleepyUpdateOrder.size(), m_sleepyUpdates.size() ));
+			m_loadedSleepyUpdateOrder.clear();
+			throw SC_INVALID_DATA;
+		}
+
+		m_sleepyUpdates.clear();
+		for( size_t i = 0; i < m_loadedSleepyUpdateOrder.size(); ++i )
+		{
+			UpdateModulePtr u = m_loadedSleepyUpdateOrder[i];
+			if( u->friend_getIndexInLogic() != -1 )
+			{
+				DEBUG_CRASH(( "GameLogic::loadPostProcess - A sleepy update is twice in the checkpoint" ));
+				m_loadedSleepyUpdateOrder.clear();
+				throw SC_INVALID_DATA;
+			}
+			m_sleepyUpdates.pushUnsorted( u );
+		}
+		m_loadedSleepyUpdateOrder.clear();
+
+		if( !m_sleepyUpdates.validate() )
+		{
+			DEBUG_CRASH(( "GameLogic::loadPostProcess - The sleepy updates of the checkpoint are not a heap" ));
+			throw SC_INVALID_DATA;
+		}
+	}
+
 }
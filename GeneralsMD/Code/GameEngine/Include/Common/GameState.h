@@ -34,6 +34,7 @@
 #include "Common/Snapshot.h"
 #include "Common/SubsystemInterface.h"
 #include "Common/UnicodeString.h"
+#include "Common/XferMemory.h"
 #include "GameNetwork/NetworkDefs.h"
 
 // FORWARD REFERENCES /////////////////////////////////////////////////////////////////////////////
@@ -162,6 +163,8 @@ public:
 										 SnapshotType which = SNAPSHOT_SAVELOAD  );  ///< save a game
 	SaveCode missionSave( void );																	 ///< do a in between mission save
 	SaveCode loadGame( AvailableGameInfo gameInfo );							 ///< load a save file
+	SaveCode saveGameToMemory( XferBuffer *buffer );							 ///< save the game into a memory buffer
+	SaveCode loadGameFromMemory( const XferBuffer *buffer );			 ///< load the game from a memory buffer
 	SaveGameInfo *getSaveGameInfo( void ) { return &m_gameInfo; }
 
 	// snapshot interaction
@@ -36,6 +36,7 @@
 #include "Common/ObjectStatusTypes.h"
 #include "GameNetwork/NetworkDefs.h"
 #include "GameLogic/Module/UpdateModule.h"	// needed for DIRECT_UPDATEMODULE_ACCESS
+#include "GameLogic/SleepyUpdateQueue.h"
 
 /*
 	At one time, we distinguished between sleepy and nonsleepy
@@ -279,11 +280,9 @@ private:
 
 	void pushSleepyUpdate(UpdateModulePtr u);
 	UpdateModulePtr peekSleepyUpdate() const;
-	void popSleepyUpdate();
-	void eraseSleepyUpdate(Int i);
-	void rebalanceSleepyUpdate(Int i);
-	Int rebalanceParentSleepyUpdate(Int i);
-	Int rebalanceChildSleepyUpdate(Int i);
+	void eraseSleepyUpdate(UpdateModulePtr u);
+	void rescheduleSleepyUpdate(UpdateModulePtr u);
+	void reschedulePeekedSleepyUpdate(UpdateModulePtr u);
 	void remakeSleepyUpdate();
 	void validateSleepyUpdate() const;
 
@@ -336,11 +335,12 @@ private:
 //	ObjectPtrHash m_objHash;																///< Used for ObjectID lookups
 	ObjectPtrVector m_objVector;
 
-	// this is a vector, but is maintained as a priority queue.
+	// this is a priority queue, see SleepyUpdateQueue.h.
 	// never modify it directly; please use the proper access methods.
 	// (for an excellent discussion of priority queues, please see:
 	// http://dogma.net/markn/articles/pq_stl/priority.htm)
-	std::vector<UpdateModulePtr> m_sleepyUpdates;
+	typedef SleepyUpdateHeap<UpdateModulePtr> SleepyUpdateQueue;
+	SleepyUpdateQueue m_sleepyUpdates;
 
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	// this is a plain old list, not a pq.
@@ -404,6 +404,9 @@ private:
 	ObjectTOCEntry *findTOCEntryById( UnsignedShort id );		///< find ObjectTOC by id
 	void xferObjectTOC( Xfer *xfer );												///< save/load object TOC for current state of map
 	void prepareLogicForObjectLoad( void );									///< prepare engine for object data from game file
+	void xferSleepyUpdateOrder( Xfer *xfer );								///< save/load the order of the sleepy update heap for replay checkpoints
+
+	std::vector<UpdateModulePtr> m_loadedSleepyUpdateOrder;	///< the sleepy update heap of a loaded replay checkpoint, in heap order
 
 };
 
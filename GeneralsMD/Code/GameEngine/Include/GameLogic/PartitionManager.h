@@ -191,6 +191,7 @@ private:
 	PartitionCell							*m_cell;									///< the cell being touched
 	PartitionData							*m_module;								///< the module (and thus, Object) touching
 	CellAndObjectIntersection *m_prevCoi, *m_nextCoi;		///< if in use, next/prev in this cell. if not in use, next/prev free in this module.
+	Int												m_packedIndex;						///< if in use, index of this COI in the packed arrays of the cell.
 
 public:
 
@@ -234,6 +235,8 @@ public:
 	// only for use by PartitionCell.
 	void friend_addToCellList(CellAndObjectIntersection **pListHead);
 	void friend_removeFromCellList(CellAndObjectIntersection **pListHead);
+	Int friend_getPackedIndex() const { return m_packedIndex; }
+	void friend_setPackedIndex(Int index) { m_packedIndex = index; }
 };
 
 /**
@@ -304,6 +307,14 @@ private:
 	Short													m_cellX;						///< x-coord of this cell within the Partition Mgr coords (NOT in world coords)
 	Short													m_cellY;						///< y-coord of this cell within the Partition Mgr coords (NOT in world coords)
 
+	// TheSuperHackers @performance Packed copies of the position and bounding radius of the objects of the COIs in this
+	// cell, so that getClosestObjects can reject the objects out of range without touching them. The arrays are not in
+	// the order of the COI list, each COI knows its index.
+	std::vector<Real>												m_packedX;
+	std::vector<Real>												m_packedY;
+	std::vector<Real>												m_packedRadius;
+	std::vector<CellAndObjectIntersection*>	m_packedCoi;
+
 public:
 
 	// Note, we allocate these in arrays, thus we must have a default ctor (and NOT descend from MPO)
@@ -350,6 +361,13 @@ public:
 
 	CellAndObjectIntersection *getFirstCoiInCell() { return m_firstCoiInCell; }
 
+	// The packed arrays have getCoiCount() entries.
+	const Real *getPackedX() const { return &m_packedX[0]; }
+	const Real *getPackedY() const { return &m_packedY[0]; }
+	const Real *getPackedRadius() const { return &m_packedRadius[0]; }
+	CellAndObjectIntersection * const *getPackedCoi() const { return &m_packedCoi[0]; }
+	void setPackedData(const CellAndObjectIntersection *coi, Real x, Real y, Real radius);
+
 	#ifdef RTS_DEBUG
 	void validateCoiList();
 	#endif
@@ -542,6 +560,7 @@ public:
 
 	void friend_removeAllTouchedCells() { removeAllTouchedCells(); }	///< this is only for use by PartitionManager
 	void friend_updateCellsTouched()	{ updateCellsTouched(); } ///< this is only for use by PartitionManager
+	void updatePackedData(); ///< copy the position and bounding radius of the object to the packed arrays of the cells it touches
 	Int friend_getCoiInUseCount() { return m_coiInUseCount; } ///< this is only for use by PartitionManager
 	Bool friend_collidesWith(const PartitionData *that, CollideLocAndNormal *cinfo) const { return collidesWith(that, cinfo); }	///< this is only for use by PartitionContactList
 
@@ -1218,6 +1237,46 @@ protected:
 #endif
 };
 
+//=====================================
+/**
+	One query of PartitionManager::getClosestObjectsBatch. Either obj or pos must be set.
+	The filters must not change any state, because the batch runs them for the queries
+	in an interleaved order.
+*/
+//=====================================
+struct PartitionQuery
+{
+	PartitionQuery() :
+		obj(nullptr), pos(nullptr), maxDist(HUGE_DIST), dc(FROM_CENTER_2D), filters(nullptr), iter(nullptr),
+		closestObj(nullptr), closestDist(0.0f)
+	{
+		closestVec.zero();
+	}
+
+	const Object *obj;								///< query around this object (never returned)
+	const Coord3D *pos;								///< or around this position
+	Real maxDist;
+	DistanceCalculationType dc;
+	PartitionFilter **filters;
+	SimpleObjectIterator *iter;				///< if nonnull, receives ALL satisfactory objects, unsorted
+
+	Object *closestObj;								///< result: the closest satisfactory object, if iter is null
+	Real closestDist;
+	Coord3D closestVec;
+};
+
+//=====================================
+/**
+	Statistics of the collision detection of PartitionManager::update since the map was loaded.
+*/
+//=====================================
+struct PartitionCollisionStats
+{
+	UnsignedInt m_updates;
+	UnsignedInt m_contacts;						///< pairs of objects that were tested for a collision
+	UnsignedInt m_collisions;					///< pairs that collided
+};
+
 //=====================================
 /**
 	PartitionManager is the singleton class that manages the entire partition/collision
@@ -1245,12 +1304,19 @@ private:
 	PartitionCell*	m_cells;					///< array of cells
 	PartitionData*	m_dirtyModules;
 	Bool						m_updatedSinceLastReset;	///< Used to force a return of OBJECTSHROUD_INVALID before update has been called.
+	PartitionCollisionStats	m_collisionStats;
 
 	std::queue<SightingInfo *> m_pendingUndoShroudReveals;	///< Anything can queue up an Undo to happen later. This is a queue, because "later" is a constant
 
 #ifdef FASTER_GCO
 	Int							m_maxGcoRadius;
 	RadiusVec				m_radiusVec;
+
+	struct ClosestObjectsScan;
+	void initClosestObjectsScan(ClosestObjectsScan& scan, const Object *obj, const Coord3D *objPos, const Object *objToUse,
+		Real maxDist, DistanceCalculationType dc, PartitionFilter **filters, SimpleObjectIterator *iter);
+	static void scanCellForClosestObjects(PartitionCell *thisCell, Int curRadius, ClosestObjectsScan& scan);
+	static void scanClosestObjectCandidate(CellAndObjectIntersection *thisCoi, Int curRadius, ClosestObjectsScan& scan);
 #endif
 
 protected:
@@ -1322,6 +1388,7 @@ public:
 	void loadPostProcess( void );
 
 	Bool getUpdatedSinceLastReset( void ) const { return m_updatedSinceLastReset; }
+	const PartitionCollisionStats& getCollisionStats( void ) const { return m_collisionStats; }
 
 	void registerObject( Object *object );				///< add thing to system
 	void unRegisterObject( Object *object );			///< remove thing from system
@@ -1380,6 +1447,13 @@ public:
 		Coord3D *closestDistVec = nullptr
 	);
 
+	/**
+		Run several getClosestObject or iterateObjectsInRange queries at once. The queries around
+		the same cell share the walk over the cells. The results are the same as those of calling
+		getClosestObjects for each query in turn.
+	*/
+	void getClosestObjectsBatch(PartitionQuery *queries, Int numQueries);
+
 	Real getRelativeAngle2D( const Object *obj, const Object *otherObj );
 	Real getRelativeAngle2D( const Object *obj, const Coord3D *pos );
 
@@ -82,6 +82,10 @@ protected:
 	Player *playerFromParam(Parameter *pSideParm);			// Gets a player from a parameter.
 	void objectTypesFromParam(Parameter *pTypeParm, ObjectTypes *outObjectTypes);		// Must pass in a valid objectTypes for outObjectTypes
 
+	Bool isObjectRosterCondition(Condition *pCondition);		// Does the result only depend on which objects a fixed player or team has?
+	Bool isObjectRosterResultValid(Condition *pCondition);
+	Bool cacheObjectRosterResult(Condition *pCondition, Bool result);
+
 	Bool evaluateAllDestroyed(Parameter *pSideParm);
 	Bool evaluateAllBuildFacilitiesDestroyed(Parameter *pSideParm);
 	Bool evaluateIsDestroyed(Parameter *pTeamParm);
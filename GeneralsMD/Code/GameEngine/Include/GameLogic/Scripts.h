@@ -68,8 +68,12 @@
 #define INNER_PERIMETER "InnerPerimeter"
 #define OUTER_PERIMETER "OuterPerimeter"
 
+class ObjectTypes;
 class Parameter;
+class PolygonTrigger;
 class Script;
+class TeamPrototype;
+class ThingTemplate;
 class OrCondition;
 class Condition;
 class DataChunkInput;
@@ -798,6 +802,7 @@ public:
 		m_real(0)
 	{
 		m_coord.x=0;m_coord.y=0;m_coord.z=0;
+		unbind();
 	}
 
 private:
@@ -809,11 +814,28 @@ private:
 	Coord3D				m_coord;
 	ObjectStatusMaskType m_objectStatus;
 
+	// TheSuperHackers @performance Handles that the string resolves to, bound by ScriptEngine::bindParameters at newMap
+	// so that conditions do not look up the names every frame. Null if the name was not bound.
+	PolygonTrigger*				m_boundTriggerArea;
+	TeamPrototype*				m_boundTeamPrototype;
+	const ThingTemplate*	m_boundThingTemplate;
+	ObjectTypes*					m_boundObjectTypes;
+	UnsignedInt						m_boundObjectTypesGeneration;	///< object type lists can come and go, see ScriptEngine::getObjectTypes
+
+	void unbind()
+	{
+		m_boundTriggerArea = nullptr;
+		m_boundTeamPrototype = nullptr;
+		m_boundThingTemplate = nullptr;
+		m_boundObjectTypes = nullptr;
+		m_boundObjectTypesGeneration = 0;
+	}
+
 protected:
 	void setInt(Int i) {m_int = i;}
 	void setReal(Real r) {m_real = r;}
 	void setCoord3D(const Coord3D *pLoc);
-	void setString(AsciiString s) {m_string = s;}
+	void setString(AsciiString s) {m_string = s; unbind();}
 	void setStatus( ObjectStatusMaskType objectStatus ) { m_objectStatus.set( objectStatus ); }
 
 public:
@@ -826,7 +848,18 @@ public:
 	void friend_setInt(Int i) {m_int = i;}
 	void friend_setReal(Real r) {m_real = r;}
 	void friend_setCoord3D(const Coord3D *pLoc) { setCoord3D(pLoc); }
-	void friend_setString(AsciiString s) {m_string = s;}
+	void friend_setString(AsciiString s) {m_string = s; unbind();}
+
+	PolygonTrigger *getBoundTriggerArea(void) const {return m_boundTriggerArea;}
+	TeamPrototype *getBoundTeamPrototype(void) const {return m_boundTeamPrototype;}
+	const ThingTemplate *getBoundThingTemplate(void) const {return m_boundThingTemplate;}
+	ObjectTypes *getBoundObjectTypes(void) const {return m_boundObjectTypes;}
+	UnsignedInt getBoundObjectTypesGeneration(void) const {return m_boundObjectTypesGeneration;}
+
+	void friend_bindTriggerArea(PolygonTrigger *pTrig) {m_boundTriggerArea = pTrig;}
+	void friend_bindTeamPrototype(TeamPrototype *pProto) {m_boundTeamPrototype = pProto;}
+	void friend_bindThingTemplate(const ThingTemplate *pTemplate) {m_boundThingTemplate = pTemplate;}
+	void friend_bindObjectTypes(ObjectTypes *pTypes, UnsignedInt generation) {m_boundObjectTypes = pTypes; m_boundObjectTypesGeneration = generation;}
 
 	void qualify(const AsciiString& qualifier,const AsciiString& playerTemplateName,const AsciiString& newPlayerName);
 
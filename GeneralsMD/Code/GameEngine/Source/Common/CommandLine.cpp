@@ -417,6 +417,12 @@ Int parseHeadless(char *args[], int num)
 	return 1;
 }
 
+Int parseHeadlessClientEffects(char *args[], int num)
+{
+	TheWritableGlobalData->m_headlessClientEffects = TRUE;
+	return 1;
+}
+
 Int parseReplay(char *args[], int num)
 {
 	if (num > 1)
@@ -443,6 +449,215 @@ Int parseReplay(char *args[], int num)
 	return 1;
 }
 
+Int parseReplayCheckpoints(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayCheckpointInterval = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayCheckpointMemory(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayCheckpointMemoryMB = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayIndex(char *args[], int num)
+{
+	TheWritableGlobalData->m_replayIndexSidecars = TRUE;
+	return 1;
+}
+
+Int parseReplayCRCReport(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayCRCReportFileName = args[1];
+		// The report rewinds to a checkpoint before the mismatch, so make sure there are some.
+		if (TheWritableGlobalData->m_replayCheckpointInterval == 0)
+			TheWritableGlobalData->m_replayCheckpointInterval = 60*LOGICFRAMES_PER_SECOND;
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayCRCReference(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayCRCReferenceFileName = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseProfileUpdates(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_updateProfileFileName = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseProfileScripts(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_scriptProfileFileName = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayBench(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayBenchFileName = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayBenchBaseline(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayBenchBaselineFileName = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayBenchTolerance(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayBenchTolerance = (Real)atof(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindTimeBudget(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindTimeBudgetMicros = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseMemoryPoolSizes(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_memoryPoolSizesFileName = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBench(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchMap = args[1];
+		ConvertShortMapPathToLongMapPath(TheWritableGlobalData->m_pathfindBenchMap);
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_afterIntro = TRUE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBenchQueries(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchQueries = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBenchSeed(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchSeed = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBenchResults(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchFileName = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parsePathfindBenchBaseline(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_pathfindBenchBaselineFileName = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseCollisionBench(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_collisionBenchMap = args[1];
+		ConvertShortMapPathToLongMapPath(TheWritableGlobalData->m_collisionBenchMap);
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_afterIntro = TRUE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		return 2;
+	}
+	return 1;
+}
+
+Int parseCollisionBenchUnits(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_collisionBenchUnits = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseCollisionBenchFrames(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_collisionBenchFrames = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
 Int parseJobs(char *args[], int num)
 {
 	if (num > 1)
@@ -615,6 +830,13 @@ Int parseStateMachineDebug(char *args[], int)
 	return 1;
 }
 
+Int parseAuditScriptConditions(char *args[], int)
+{
+	TheWritableGlobalData->m_auditScriptConditions = TRUE;
+
+	return 1;
+}
+
 Int parseJabber(char *args[], int)
 {
 	TheWritableGlobalData->m_jabberOn = TRUE;
@@ -1152,6 +1374,10 @@ static CommandLineParam paramsForStartup[] =
 	// This runs the game without a window, graphics, input and audio. You can combine this with -replay
 	{ "-headless", parseHeadless },
 
+	// TheSuperHackers @feature Keep creating FX, floating texts and client-only drawables in headless mode.
+	// Compare the replay CRCs with and without it to audit the logic-only headless simulation.
+	{ "-headlessClientEffects", parseHeadlessClientEffects },
+
 	// TheSuperHackers @feature helmutbuhler 13/04/2025
 	// Play back a replay. Pass the filename including .rep afterwards.
 	// You can pass this multiple times to play back multiple replays.
@@ -1162,7 +1388,75 @@ static CommandLineParam paramsForStartup[] =
 	// Simulate each replay in a separate process and use 1..N processes at the same time.
 	// (If you have 4 cores, call it with -jobs 4)
 	// If you do not call this, all replays will be simulated in sequence in the same process.
+	// The options that write one file for all replays, like -profileUpdates or -replayCRCReport, are rejected with -jobs.
 	{ "-jobs", parseJobs },
+
+	// TheSuperHackers @feature Keep an in-memory checkpoint of the game every N logic frames during
+	// replay playback, so that seeking in the replay resumes from the nearest checkpoint.
+	// Optionally limit the memory used for the checkpoints in megabytes with -replayCheckpointMemory.
+	{ "-replayCheckpoints", parseReplayCheckpoints },
+	{ "-replayCheckpointMemory", parseReplayCheckpointMemory },
+
+	// TheSuperHackers @feature Store the command index of every played back replay in a .idx file next to it.
+	// Later playbacks of the same replay read the index from there instead of scanning the replay again.
+	{ "-replayIndex", parseReplayIndex },
+
+	// TheSuperHackers @feature Write a CRC report when a simulated replay mismatches. The replay is rewound
+	// to the last checkpoint before the mismatch and simulated again with a CRC in every frame, followed by
+	// CRCs of every save game block, object and module on the last frame.
+	// With -replayCRCReference, the report covers the frames of a report written by another build and
+	// names the first diverging frame, object and module. Both options take a file name.
+	{ "-replayCRCReport", parseReplayCRCReport },
+	{ "-replayCRCReference", parseReplayCRCReference },
+
+	// TheSuperHackers @feature Profile the update modules while simulating replays in this process.
+	// Writes the cycles, calls and UPDATE_SLEEP_NONE counts per module class and thing template to the
+	// given file when all replays are done. A file name ending with .json gives a Chrome trace.
+	{ "-profileUpdates", parseProfileUpdates },
+
+	// TheSuperHackers @feature Profile the scripts. Writes the cycles and calls per script, condition type and
+	// action type to the given file at the end of every map, and prints the top offenders. Works in the game
+	// and with replays simulated in this process.
+	{ "-profileScripts", parseProfileScripts },
+
+	// TheSuperHackers @feature Benchmark the simulated replays. Every replay reports its logic frames per second,
+	// mean and 99th percentile GameLogic::UPDATE time, peak memory pool usage and final CRC. -replayBench writes
+	// these results to a CSV file. -replayBenchBaseline compares them with such a file and fails if a replay
+	// ends with another CRC or regressed by more than -replayBenchTolerance percent (default 10).
+	{ "-replayBench", parseReplayBench },
+	{ "-replayBenchBaseline", parseReplayBenchBaseline },
+	{ "-replayBenchTolerance", parseReplayBenchTolerance },
+
+	// TheSuperHackers @performance Process the queued pathfinds for the given number of microseconds per frame
+	// instead of a fixed number of pathfind cells. This smooths out large group moves, but time is not deterministic:
+	// the option is ignored in multiplayer games, in games that are recorded to a replay and in replay playback.
+	{ "-pathfindTimeBudget", parsePathfindTimeBudget },
+
+	// TheSuperHackers @performance Record the peak usage and the overflow blobs of every memory pool and write
+	// suggested initial pool sizes to the given file on exit, in the format of Data\INI\MemoryPools.ini.
+	// The usage recorded in an existing file is merged in, so one file can cover several sessions or
+	// replay batches. Cannot be combined with -jobs.
+	{ "-memoryPoolSizes", parseMemoryPoolSizes },
+
+	// TheSuperHackers @feature Benchmark the pathfinder on the given map and exit. Times Pathfinder::classifyMap and runs
+	// -pathfindBenchQueries (default 1000) seeded findPath, findClosestPath, findAttackPath and isLinePassable queries for
+	// one unit of every locomotor type. Reports the latency percentiles, examined cells and a checksum of the paths.
+	// -pathfindBenchResults writes the results to a CSV file. -pathfindBenchBaseline compares them with such a file and
+	// fails if a query finds other paths or its mean latency regressed by more than -replayBenchTolerance percent.
+	// Combine it with -headless.
+	{ "-pathfindBench", parsePathfindBench },
+	{ "-pathfindBenchQueries", parsePathfindBenchQueries },
+	{ "-pathfindBenchSeed", parsePathfindBenchSeed },
+	{ "-pathfindBenchResults", parsePathfindBenchResults },
+	{ "-pathfindBenchBaseline", parsePathfindBenchBaseline },
+
+	// TheSuperHackers @feature Benchmark the collision detection on the given map and exit. Packs -collisionBenchUnits
+	// (default 2000) infantry units into an overlapping blob, moves them for -collisionBenchFrames (default 300) frames and
+	// reports the latency percentiles of the partition manager update and the tested and colliding pairs per frame.
+	// Combine it with -headless.
+	{ "-collisionBench", parseCollisionBench },
+	{ "-collisionBenchUnits", parseCollisionBenchUnits },
+	{ "-collisionBenchFrames", parseCollisionBenchFrames },
 };
 
 // These Params are parsed during Engine Init before INI data is loaded
@@ -1270,6 +1564,7 @@ static CommandLineParam paramsForEngineInit[] =
 	{ "-noShowClientPhysics", parseNoShowClientPhysics },
 	{ "-showTerrainNormals", parseShowTerrainNormals },
 	{ "-stateMachineDebug", parseStateMachineDebug },
+	{ "-auditScriptConditions", parseAuditScriptConditions },
 	{ "-jabber", parseJabber },
 	{ "-munkee", parseMunkee },
 	{ "-displayDebug", parseDisplayDebug },
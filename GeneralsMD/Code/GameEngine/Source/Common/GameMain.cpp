@@ -28,8 +28,10 @@
 
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 
+#include "Common/CollisionBenchmark.h"
 #include "Common/FramePacer.h"
 #include "Common/GameEngine.h"
+#include "Common/PathfindBenchmark.h"
 #include "Common/ReplaySimulation.h"
 
 
@@ -49,12 +51,25 @@ Int GameMain()
 	{
 		exitcode = ReplaySimulation::simulateReplays(TheGlobalData->m_simulateReplays, TheGlobalData->m_simulateReplayJobs);
 	}
+	else if (TheGlobalData->m_pathfindBenchMap.isNotEmpty())
+	{
+		exitcode = PathfindBenchmark::run(TheGlobalData->m_pathfindBenchMap);
+	}
+	else if (TheGlobalData->m_collisionBenchMap.isNotEmpty())
+	{
+		exitcode = CollisionBenchmark::run(TheGlobalData->m_collisionBenchMap);
+	}
 	else
 	{
 		// run it
 		TheGameEngine->execute();
 	}
 
+	if (TheGlobalData->m_memoryPoolSizesFileName.isNotEmpty())
+	{
+		TheMemoryPoolFactory->writePoolSizes(TheGlobalData->m_memoryPoolSizesFileName.str());
+	}
+
 	// since execute() returned, we are exiting the game
 	delete TheFramePacer;
 	TheFramePacer = nullptr;
@@ -31,7 +31,11 @@
 #include "Common/Player.h"
 #include "Common/GlobalData.h"
 #include "Common/GameEngine.h"
+#include "Common/GameState.h"
+#include "Common/XferMemory.h"
+#include "Common/LatchRestore.h"
 #include "GameClient/ClientInstance.h"
+#include "GameClient/GameClient.h"
 #include "GameClient/GameWindow.h"
 #include "GameClient/GameWindowManager.h"
 #include "GameClient/InGameUI.h"
@@ -42,6 +46,8 @@
 #include "GameNetwork/GameMessageParser.h"
 #include "GameNetwork/GameSpy/PeerDefs.h"
 #include "GameNetwork/networkutil.h"
+#include "GameLogic/AI.h"
+#include "GameLogic/AIPathfind.h"
 #include "GameLogic/GameLogic.h"
 #include "Common/RandomValue.h"
 #include "Common/CRCDebug.h"
@@ -49,7 +55,6 @@
 #include "Common/version.h"
 
 constexpr const char s_genrep[] = "GENREP";
-constexpr const UnsignedInt replayBufferBytes = 8192;
 
 Int REPLAY_CRC_INTERVAL = 100;
 
@@ -368,10 +373,15 @@ RecorderClass::RecorderClass()
 	m_file = nullptr;
 	m_fileName.clear();
 	m_currentFilePosition = 0;
+	m_playbackCommandsOffset = 0;
 	m_doingAnalysis = FALSE;
 	m_archiveReplays = FALSE;
 	m_nextFrame = 0;
 	m_wasDesync = FALSE;
+	m_checkpointBytes = 0;
+	m_nextCheckpointFrame = 0;
+	m_isRestoringCheckpoint = FALSE;
+	m_crcMismatchFrame = 0;
 	init(); // just for the heck of it.
 }
 
@@ -379,6 +389,7 @@ RecorderClass::RecorderClass()
  * Destructor
  */
 RecorderClass::~RecorderClass() {
+	clearPlaybackCheckpoints();
 }
 
 /**
@@ -413,10 +424,19 @@ void RecorderClass::init() {
  * Reset the recorder to the "initialized state."
  */
 void RecorderClass::reset() {
+	// TheSuperHackers @feature Restoring a playback checkpoint resets the engine, but the playback continues.
+	if (m_isRestoringCheckpoint)
+		return;
+
+	clearPlaybackCheckpoints();
+
 	if (m_file != nullptr) {
 		m_file->close();
 		m_file = nullptr;
 	}
+	m_playbackFile.close();
+	m_playbackFrameIndex.clear();
+	m_playbackCommandsOffset = 0;
 	m_fileName.clear();
 
 	init();
@@ -470,10 +490,7 @@ void RecorderClass::updatePlayback() {
  * reaching the end of the playback file.
  */
 void RecorderClass::stopPlayback() {
-	if (m_file != nullptr) {
-		m_file->close();
-		m_file = nullptr;
-	}
+	m_playbackFile.close();
 	m_fileName.clear();
 
 	if (!m_doingAnalysis)
@@ -874,18 +891,15 @@ void RecorderClass::writeArgument(GameMessageArgumentDataType type, const GameMe
 
 /**
  * Read in a replay header, for (1) populating a replay listbox or (2) starting playback.  In
- * case (2), set FILE *m_file.
+ * case (2), keep m_playbackFile open.
  */
 Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 {
 	AsciiString filepath = getReplayDir();
 	filepath.concat(header.filename.str());
 
-	// TheSuperHackers @performance More buffered data reduces disk overhead and will improve fast forward playback
-	const UnsignedInt buffersize = header.forPlayback ? replayBufferBytes : File::BUFFERSIZE;
-	m_file = TheFileSystem->openFile(filepath.str(), File::READ | File::BINARY, buffersize);
-
-	if (m_file == nullptr)
+	// TheSuperHackers @performance The replay is mapped into memory and decoded from there.
+	if (!m_playbackFile.open(filepath))
 	{
 		DEBUG_LOG(("Can't open %s (%s)", filepath.str(), header.filename.str()));
 		return FALSE;
@@ -893,66 +907,63 @@ Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 
 	// Read the GENREP header.
 	char genrep[sizeof(s_genrep) - 1] = {0};
-	m_file->read( &genrep, sizeof(s_genrep) - 1 );
+	m_playbackFile.read( &genrep, sizeof(s_genrep) - 1 );
 	if ( strncmp(genrep, s_genrep, sizeof(s_genrep) - 1 ) != 0 ) {
 		DEBUG_LOG(("RecorderClass::readReplayHeader - replay file did not have GENREP at the start."));
-		m_file->close();
-		m_file = nullptr;
+		m_playbackFile.close();
 		return FALSE;
 	}
 
 	// read in some stats
 	replay_time_t tmp;
-	m_file->read(&tmp, sizeof(tmp));
+	m_playbackFile.read(tmp);
 	header.startTime = tmp;
-	m_file->read(&tmp, sizeof(tmp));
+	m_playbackFile.read(tmp);
 	header.endTime = tmp;
 
-	m_file->read(&header.frameCount, sizeof(header.frameCount));
+	m_playbackFile.read(header.frameCount);
 
-	m_file->read(&header.desyncGame, sizeof(header.desyncGame));
-	m_file->read(&header.quitEarly, sizeof(header.quitEarly));
+	m_playbackFile.read(header.desyncGame);
+	m_playbackFile.read(header.quitEarly);
 	for (Int i=0; i<MAX_SLOTS; ++i)
 	{
-		m_file->read(&(header.playerDiscons[i]), sizeof(Bool));
+		m_playbackFile.read(header.playerDiscons[i]);
 	}
 
 	// Read the Replay Name.  We don't actually do anything with it.  Oh well.
-	header.replayName = readUnicodeString();
+	header.replayName = m_playbackFile.readUnicodeString();
 
 	// Read the date and time.  We don't really do anything with this either. Oh well.
-	m_file->read(&header.timeVal, sizeof(header.timeVal));
+	m_playbackFile.read(header.timeVal);
 
 	// Read in the Version info
-	header.versionString = readUnicodeString();
-	header.versionTimeString = readUnicodeString();
-	m_file->read(&header.versionNumber, sizeof(header.versionNumber));
-	m_file->read(&header.exeCRC, sizeof(header.exeCRC));
-	m_file->read(&header.iniCRC, sizeof(header.iniCRC));
+	header.versionString = m_playbackFile.readUnicodeString();
+	header.versionTimeString = m_playbackFile.readUnicodeString();
+	m_playbackFile.read(header.versionNumber);
+	m_playbackFile.read(header.exeCRC);
+	m_playbackFile.read(header.iniCRC);
 
 	// Read in the GameInfo
-	header.gameOptions = readAsciiString();
+	header.gameOptions = m_playbackFile.readAsciiString();
 	m_gameInfo.reset();
 	m_gameInfo.enterGame();
 	DEBUG_LOG(("RecorderClass::readReplayHeader - GameInfo = %s", header.gameOptions.str()));
 	if (!ParseAsciiStringToGameInfo(&m_gameInfo, header.gameOptions))
 	{
 		DEBUG_LOG(("RecorderClass::readReplayHeader - replay file did not have a valid GameInfo string."));
-		m_file->close();
-		m_file = nullptr;
+		m_playbackFile.close();
 		return FALSE;
 	}
 	m_gameInfo.startGame(0);
 
-	AsciiString playerIndex = readAsciiString();
+	AsciiString playerIndex = m_playbackFile.readAsciiString();
 	header.localPlayerIndex = atoi(playerIndex.str());
 	if (header.localPlayerIndex < -1 || header.localPlayerIndex >= MAX_SLOTS)
 	{
 		DEBUG_LOG(("RecorderClass::readReplayHeader - invalid local slot number."));
 		m_gameInfo.endGame();
 		m_gameInfo.reset();
-		m_file->close();
-		m_file = nullptr;
+		m_playbackFile.close();
 		return FALSE;
 	}
 	if (header.localPlayerIndex >= 0)
@@ -965,8 +976,7 @@ Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 	{
 		m_gameInfo.endGame();
 		m_gameInfo.reset();
-		m_file->close();
-		m_file = nullptr;
+		m_playbackFile.close();
 	}
 
 	return TRUE;
@@ -984,7 +994,21 @@ Bool RecorderClass::simulateReplay(AsciiString filename)
 Bool RecorderClass::analyzeReplay( AsciiString filename )
 {
 	m_doingAnalysis = TRUE;
-	return playbackFile(filename);
+	if (!playbackFile(filename))
+		return FALSE;
+
+	// Note that we use printf here like the other replay tools.
+	const ReplayFrameIndex& frameIndex = getPlaybackFrameIndex();
+	ReplayFrameIndex::CommandStatsList stats;
+	frameIndex.getCommandStats(stats);
+	printf("Replay \"%s\": %u commands up to frame %u\n", filename.str(), (UnsignedInt)frameIndex.getCommands().size(), frameIndex.getLastCommandFrame());
+	for (size_t i = 0; i < stats.size(); ++i)
+	{
+		printf("  %-40s %8u commands from frame %u to %u\n",
+			GameMessage::getCommandTypeAsString((GameMessage::Type)stats[i].type), stats[i].count, stats[i].firstFrame, stats[i].lastFrame);
+	}
+	fflush(stdout);
+	return TRUE;
 }
 
 
@@ -1080,6 +1104,221 @@ UnsignedInt CRCInfo::readCRC(void)
 	return val;
 }
 
+// TheSuperHackers @feature A snapshot of the whole game and the playback state at the end of a logic frame.
+struct RecorderClass::PlaybackCheckpoint
+{
+	PlaybackCheckpoint() : frame(0), filePosition(0), nextFrame(0), crcInfo(0, FALSE), crcMismatchFrame(0), crc(0) {}
+
+	size_t size() const { return saveData.size() + pathfinderData.size(); }
+
+	UnsignedInt frame;
+	Int filePosition;
+	UnsignedInt nextFrame;
+	CRCInfo crcInfo;
+	UnsignedInt crcMismatchFrame;
+	GameLogicRandomState randomState;
+	UnsignedInt crc;						///< logic CRC of the frame, a restore must reproduce it
+	XferBuffer saveData;
+	XferBuffer pathfinderData;	///< state of the pathfinder, which the save data does not contain
+};
+
+static Bool hasLogicCRCMessage(GameMessageList *messageList)
+{
+	for (GameMessage *msg = messageList->getFirstMessage(); msg != nullptr; msg = msg->next())
+	{
+		if (msg->getType() == GameMessage::MSG_LOGIC_CRC)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+void RecorderClass::updatePlaybackCheckpoints()
+{
+	const UnsignedInt interval = TheGlobalData->m_replayCheckpointInterval;
+	if (interval == 0 || m_doingAnalysis || !m_playbackFile.isOpen() || !isPlaybackInProgress())
+		return;
+
+	const UnsignedInt frame = TheGameLogic->getFrame();
+	if (frame < m_nextCheckpointFrame)
+		return;
+
+	// A local CRC message that is still on its way to the logic is not part of the save data.
+	// Postpone the checkpoint to the next frame, otherwise the CRC queue would not line up after a restore.
+	if (hasLogicCRCMessage(TheCommandList) || hasLogicCRCMessage(TheMessageStream))
+		return;
+
+	m_nextCheckpointFrame = frame + interval;
+
+	PlaybackCheckpoint *checkpoint = NEW PlaybackCheckpoint;
+	checkpoint->frame = frame;
+	checkpoint->filePosition = m_playbackFile.position();
+	checkpoint->nextFrame = m_nextFrame;
+	checkpoint->crcInfo = *m_crcInfo;
+	checkpoint->crcMismatchFrame = m_crcMismatchFrame;
+	GetGameLogicRandomState(&checkpoint->randomState);
+	checkpoint->crc = TheGameLogic->getCRC(CRC_RECALC);
+
+	if (TheGameState->saveGameToMemory(&checkpoint->saveData) != SC_OK)
+	{
+		DEBUG_LOG(("RecorderClass::updatePlaybackCheckpoints - Failed to take checkpoint on frame %d", frame));
+		delete checkpoint;
+		return;
+	}
+
+	XferSaveMemory xferPathfinder(&checkpoint->pathfinderData);
+	xferPathfinder.open("PathfinderCheckpoint");
+	TheAI->pathfinder()->xferCheckpoint(&xferPathfinder);
+	xferPathfinder.close();
+
+	m_checkpoints.push_back(checkpoint);
+	m_checkpointBytes += checkpoint->size();
+
+	// Evict the oldest checkpoints when over budget, but always keep the newest one.
+	const size_t budgetBytes = (size_t)TheGlobalData->m_replayCheckpointMemoryMB * 1024 * 1024;
+	while (m_checkpointBytes > budgetBytes && m_checkpoints.size() > 1)
+	{
+		PlaybackCheckpoint *oldest = m_checkpoints.front();
+		m_checkpoints.pop_front();
+		m_checkpointBytes -= oldest->size();
+		delete oldest;
+	}
+
+	DEBUG_LOG(("RecorderClass::updatePlaybackCheckpoints - Checkpoint on frame %d with %u bytes, %u checkpoints use %u bytes",
+		frame, (UnsignedInt)checkpoint->size(), (UnsignedInt)m_checkpoints.size(), (UnsignedInt)m_checkpointBytes));
+}
+
+Bool RecorderClass::restorePlaybackCheckpoint(UnsignedInt frame)
+{
+	if (!m_playbackFile.isOpen() || !isPlaybackMode())
+		return FALSE;
+
+	PlaybackCheckpoint *checkpoint = nullptr;
+	for (PlaybackCheckpointList::reverse_iterator it = m_checkpoints.rbegin(); it != m_checkpoints.rend(); ++it)
+	{
+		if ((*it)->frame <= frame)
+		{
+			checkpoint = *it;
+			break;
+		}
+	}
+
+	if (checkpoint == nullptr)
+		return FALSE;
+
+	SaveCode result;
+	{
+		LatchRestore<Bool> restoring(m_isRestoringCheckpoint, TRUE);
+		result = TheGameState->loadGameFromMemory(&checkpoint->saveData);
+	}
+
+	if (result != SC_OK)
+	{
+		DEBUG_CRASH(("RecorderClass::restorePlaybackCheckpoint - Failed to restore checkpoint on frame %d", checkpoint->frame));
+		return FALSE;
+	}
+
+	XferLoadMemory xferPathfinder(&checkpoint->pathfinderData);
+	xferPathfinder.open("PathfinderCheckpoint");
+	TheAI->pathfinder()->xferCheckpoint(&xferPathfinder);
+	xferPathfinder.close();
+
+	// The recorder was not reset during the load, so the playback file is still open.
+	m_playbackFile.seek(checkpoint->filePosition);
+	m_nextFrame = checkpoint->nextFrame;
+	*m_crcInfo = checkpoint->crcInfo;
+	m_crcMismatchFrame = checkpoint->crcMismatchFrame;
+	SetGameLogicRandomState(&checkpoint->randomState);
+	TheCommandList->reset();
+
+	// TheSuperHackers @bugfix Any state the checkpoint misses shows up in the CRC of its frame. A restore that
+	// does not reproduce it would not play like the recorded game, and the other checkpoints would not either.
+	const UnsignedInt crc = TheGameLogic->getCRC(CRC_RECALC);
+	if (crc != checkpoint->crc)
+	{
+		DEBUG_LOG(("RecorderClass::restorePlaybackCheckpoint - Checkpoint on frame %d restored with CRC %8.8X instead of %8.8X",
+			checkpoint->frame, crc, checkpoint->crc));
+		clearPlaybackCheckpoints();
+		return FALSE;
+	}
+
+	m_nextCheckpointFrame = checkpoint->frame + TheGlobalData->m_replayCheckpointInterval;
+
+	DEBUG_LOG(("RecorderClass::restorePlaybackCheckpoint - Restored checkpoint on frame %d", checkpoint->frame));
+	return TRUE;
+}
+
+Bool RecorderClass::seekPlayback(UnsignedInt frame)
+{
+	// Analysis does not run the logic, so it can jump straight to the commands of the frame.
+	if (m_doingAnalysis)
+		return skipPlaybackToFrame(frame);
+
+	if (!restorePlaybackCheckpoint(frame))
+		return FALSE;
+
+	// During regular playback the caller continues the playback up to the requested frame,
+	// for example with fast forward. Without graphics we can simulate there right away.
+	if (m_mode == RECORDERMODETYPE_SIMULATION_PLAYBACK)
+	{
+		while (isPlaybackInProgress() && TheGameLogic->getFrame() < frame)
+		{
+			TheGameClient->updateHeadless();
+			TheGameLogic->UPDATE();
+		}
+	}
+
+	return TRUE;
+}
+
+const ReplayFrameIndex& RecorderClass::getPlaybackFrameIndex()
+{
+	if (m_playbackFrameIndex.isValid() || !m_playbackFile.isOpen() || m_playbackCommandsOffset == 0)
+		return m_playbackFrameIndex;
+
+	AsciiString replayPath = getReplayDir();
+	replayPath.concat(m_currentReplayFilename);
+	const AsciiString sidecarFilename = ReplayFrameIndex::getSidecarFilename(replayPath);
+	const Bool useSidecar = TheGlobalData->m_replayIndexSidecars;
+
+	if (useSidecar && m_playbackFrameIndex.readSidecar(sidecarFilename, m_playbackFile, m_playbackCommandsOffset))
+		return m_playbackFrameIndex;
+
+	if (!m_playbackFrameIndex.build(m_playbackFile, m_playbackCommandsOffset))
+	{
+		DEBUG_LOG(("RecorderClass::getPlaybackFrameIndex - %s ends with an incomplete command after frame %u",
+			m_currentReplayFilename.str(), m_playbackFrameIndex.getLastCommandFrame()));
+	}
+
+	if (useSidecar && !m_playbackFrameIndex.writeSidecar(sidecarFilename))
+	{
+		DEBUG_LOG(("RecorderClass::getPlaybackFrameIndex - Failed to write %s", sidecarFilename.str()));
+	}
+
+	return m_playbackFrameIndex;
+}
+
+Bool RecorderClass::skipPlaybackToFrame(UnsignedInt frame)
+{
+	if (!m_doingAnalysis || !isPlaybackInProgress())
+		return FALSE;
+
+	const ReplayFrameIndex& index = getPlaybackFrameIndex();
+	if (!index.isValid() || !m_playbackFile.seek(index.getOffsetForFrame(frame)))
+		return FALSE;
+
+	readNextFrame();
+	return TRUE;
+}
+
+void RecorderClass::clearPlaybackCheckpoints()
+{
+	for (PlaybackCheckpointList::iterator it = m_checkpoints.begin(); it != m_checkpoints.end(); ++it)
+		delete *it;
+	m_checkpoints.clear();
+	m_checkpointBytes = 0;
+	m_nextCheckpointFrame = 0;
+}
+
 Bool RecorderClass::sawCRCMismatch() const
 {
 	return m_crcInfo->sawCRCMismatch();
@@ -1133,6 +1372,9 @@ void RecorderClass::handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool f
 			// Print Mismatch in case we are simulating replays from console.
 			printf("CRC Mismatch in Frame %d\n", mismatchFrame);
 
+			if (m_crcMismatchFrame == 0)
+				m_crcMismatchFrame = mismatchFrame;
+
 			// TheSuperHackers @tweak Pause the game on mismatch.
 			// But not when a window with focus is opened, because that can make resuming difficult.
 			if (TheWindowManager->winGetFocus() == nullptr)
@@ -1197,6 +1439,10 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 
 	m_mode = RECORDERMODETYPE_PLAYBACK;
 
+	clearPlaybackCheckpoints();
+	m_playbackFrameIndex.clear();
+	m_crcMismatchFrame = 0;
+
 	ReplayHeader header;
 	header.forPlayback = TRUE;
 	header.filename = filename;
@@ -1270,15 +1516,17 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 	DEBUG_LOG(("Player index is %d, replay CRC interval is %d", m_crcInfo->getLocalPlayer(), REPLAY_CRC_INTERVAL));
 
 	Int difficulty = 0;
-	m_file->read(&difficulty, sizeof(difficulty));
+	m_playbackFile.read(difficulty);
 
-	m_file->read(&m_originalGameMode, sizeof(m_originalGameMode));
+	m_playbackFile.read(m_originalGameMode);
 
 	Int rankPoints = 0;
-	m_file->read(&rankPoints, sizeof(rankPoints));
+	m_playbackFile.read(rankPoints);
 
 	Int maxFPS = 0;
-	m_file->read(&maxFPS, sizeof(maxFPS));
+	m_playbackFile.read(maxFPS);
+
+	m_playbackCommandsOffset = m_playbackFile.position();
 
 	DEBUG_LOG(("RecorderClass::playbackFile() - original game was mode %d", m_originalGameMode));
 
@@ -1309,63 +1557,11 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 
 	m_currentReplayFilename = filename;
 	m_playbackFrameCount = header.frameCount;
-	return TRUE;
-}
 
-/**
- * Read a unicode string from the current file position. The string is assumed to be 0-terminated.
- */
-UnicodeString RecorderClass::readUnicodeString() {
-	WideChar str[1024] = L"";
-	Int index = 0;
+	if (TheGlobalData->m_replayIndexSidecars)
+		getPlaybackFrameIndex();
 
-	Int c = m_file->readWideChar();
-	if (c == EOF) {
-		str[index] = 0;
-	}
-	str[index] = c;
-
-	while (index < 1024 && str[index] != 0) {
-		++index;
-		Int c = m_file->readWideChar();
-		if (c == EOF) {
-			str[index] = 0;
-			break;
-		}
-		str[index] = c;
-	}
-	str[1023] = L'\0';
-
-	UnicodeString retval(str);
-	return retval;
-}
-
-/**
- * Read an ascii string from the current file position. The string is assumed to be 0-terminated.
- */
-AsciiString RecorderClass::readAsciiString() {
-	char str[1024] = "";
-	Int index = 0;
-
-	Int c =	m_file->readChar();
-	if (c == EOF) {
-		str[index] = 0;
-	}
-	str[index] = c;
-
-	while (index < 1024 && str[index] != 0) {
-		++index;
-		Int c = m_file->readChar();
-		if (c == EOF) {
-			str[index] = 0;
-			break;
-		}
-		str[index] = c;
-	}
-	str[1023] = '\0';
-
-	AsciiString retval(str);
-	return retval;
+	return TRUE;
 }
 
 /**
@@ -1373,8 +1569,7 @@ AsciiString RecorderClass::readAsciiString() {
  * is stopped and the next frame is said to be -1.
  */
 void RecorderClass::readNextFrame() {
-	Int bytesRead = m_file->read(&m_nextFrame, sizeof(m_nextFrame));
-	if (bytesRead != sizeof(m_nextFrame)) {
+	if (!m_playbackFile.read(m_nextFrame)) {
 		DEBUG_LOG(("RecorderClass::readNextFrame - read failed on frame %d", TheGameLogic->getFrame()));
 		m_nextFrame = -1;
 		stopPlayback();
@@ -1386,8 +1581,7 @@ void RecorderClass::readNextFrame() {
  */
 void RecorderClass::appendNextCommand() {
 	GameMessage::Type type;
-	Int bytesRead = m_file->read(&type, sizeof(type));
-	if (bytesRead != sizeof(type)) {
+	if (!m_playbackFile.read(type)) {
 		DEBUG_LOG(("RecorderClass::appendNextCommand - read failed on frame %d", m_nextFrame/*TheGameLogic->getFrame()*/));
 		return;
 	}
@@ -1407,7 +1601,7 @@ void RecorderClass::appendNextCommand() {
 #endif // DEBUG_LOGGING
 
 	Int playerIndex = -1;
-	m_file->read(&playerIndex, sizeof(playerIndex));
+	m_playbackFile.read(playerIndex);
 	msg->friend_setPlayerIndex(playerIndex);
 
 	// don't debug log this if we're debugging sync errors, as it will cause diff problems between a game and it's replay...
@@ -1426,14 +1620,14 @@ void RecorderClass::appendNextCommand() {
 
 	UnsignedByte numTypes = 0;
 	Int totalArgs = 0;
-	m_file->read(&numTypes, sizeof(numTypes));
+	m_playbackFile.read(numTypes);
 
 	GameMessageParser *parser = newInstance(GameMessageParser)();
 	for (UnsignedByte i = 0; i < numTypes; ++i) {
 		UnsignedByte type = (UnsignedByte)ARGUMENTDATATYPE_UNKNOWN;
-		m_file->read(&type, sizeof(type));
+		m_playbackFile.read(type);
 		UnsignedByte numArgs = 0;
-		m_file->read(&numArgs, sizeof(numArgs));
+		m_playbackFile.read(numArgs);
 		parser->addArgType((GameMessageArgumentDataType)type, numArgs);
 		totalArgs += numArgs;
 	}
@@ -1482,7 +1676,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 	switch (type) {
 		case ARGUMENTDATATYPE_INTEGER: {
 			Int theint;
-			m_file->read(&theint, sizeof(theint));
+			m_playbackFile.read(theint);
 			msg->appendIntegerArgument(theint);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1494,7 +1688,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_REAL: {
 			Real thereal;
-			m_file->read(&thereal, sizeof(thereal));
+			m_playbackFile.read(thereal);
 			msg->appendRealArgument(thereal);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1506,7 +1700,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_BOOLEAN: {
 			Bool thebool;
-			m_file->read(&thebool, sizeof(thebool));
+			m_playbackFile.read(thebool);
 			msg->appendBooleanArgument(thebool);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1518,7 +1712,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_OBJECTID: {
 			ObjectID theid;
-			m_file->read(&theid, sizeof(theid));
+			m_playbackFile.read(theid);
 			msg->appendObjectIDArgument(theid);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1530,7 +1724,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_DRAWABLEID: {
 			DrawableID theid;
-			m_file->read(&theid, sizeof(theid));
+			m_playbackFile.read(theid);
 			msg->appendDrawableIDArgument(theid);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1542,7 +1736,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_TEAMID: {
 			UnsignedInt theid;
-			m_file->read(&theid, sizeof(theid));
+			m_playbackFile.read(theid);
 			msg->appendTeamIDArgument(theid);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1554,7 +1748,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_LOCATION: {
 			Coord3D loc;
-			m_file->read(&loc, sizeof(loc));
+			m_playbackFile.read(loc);
 			msg->appendLocationArgument(loc);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1567,7 +1761,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_PIXEL: {
 			ICoord2D pixel;
-			m_file->read(&pixel, sizeof(pixel));
+			m_playbackFile.read(pixel);
 			msg->appendPixelArgument(pixel);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1579,7 +1773,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_PIXELREGION: {
 			IRegion2D reg;
-			m_file->read(&reg, sizeof(reg));
+			m_playbackFile.read(reg);
 			msg->appendPixelRegionArgument(reg);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1591,7 +1785,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_TIMESTAMP: {  // Not to be confused with Terrance Stamp... Kneel before Zod!!!
 			UnsignedInt stamp;
-			m_file->read(&stamp, sizeof(stamp));
+			m_playbackFile.read(stamp);
 			msg->appendTimestampArgument(stamp);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
@@ -1603,7 +1797,7 @@ void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *
 		}
 		case ARGUMENTDATATYPE_WIDECHAR: {
 			WideChar theid;
-			m_file->read(&theid, sizeof(theid));
+			m_playbackFile.read(theid);
 			msg->appendWideCharArgument(theid);
 #ifdef DEBUG_LOGGING
 			if (m_doingAnalysis)
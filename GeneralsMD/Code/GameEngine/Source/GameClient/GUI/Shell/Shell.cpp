@@ -468,7 +468,8 @@ void Shell::showShell( Bool runInit )
 {
 	DEBUG_LOG(("Shell:showShell() - %s (%s)", TheGlobalData->m_initialFile.str(), (top())?top()->getFilename().str():"no top screen"));
 
-	if(!TheGlobalData->m_initialFile.isEmpty() || !TheGlobalData->m_simulateReplays.empty())
+	if(!TheGlobalData->m_initialFile.isEmpty() || !TheGlobalData->m_simulateReplays.empty() || TheGlobalData->m_pathfindBenchMap.isNotEmpty()
+		|| TheGlobalData->m_collisionBenchMap.isNotEmpty())
 	{
 		return;
 	}
@@ -530,7 +531,8 @@ void Shell::showShell( Bool runInit )
 void Shell::showShellMap(Bool useShellMap )
 {
 	// we don't want any of this to show if we're loading straight into a file
-	if (TheGlobalData->m_initialFile.isNotEmpty() || !TheGameLogic || !TheGlobalData->m_simulateReplays.empty())
+	if (TheGlobalData->m_initialFile.isNotEmpty() || !TheGameLogic || !TheGlobalData->m_simulateReplays.empty() || TheGlobalData->m_pathfindBenchMap.isNotEmpty()
+		|| TheGlobalData->m_collisionBenchMap.isNotEmpty())
 		return;
 	if(useShellMap && TheGlobalData->m_shellMapOn)
 	{
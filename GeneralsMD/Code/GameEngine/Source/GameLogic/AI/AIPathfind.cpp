@@ -29,8 +29,11 @@
 
 #include "GameLogic/AIPathfind.h"
 
+#include <functional>
+
 #include "Common/PerfTimer.h"
 #include "Common/Player.h"
+#include "Common/Recorder.h"
 #include "Common/CRCDebug.h"
 #include "Common/GlobalData.h"
 #include "Common/LatchRestore.h"
@@ -113,6 +116,13 @@ constexpr const UnsignedInt MAX_SAFE_PATH_CELL_COUNT = 2000;
 
 constexpr const UnsignedInt PATHFIND_CELLS_PER_FRAME = 5000; // Number of cells we will search pathfinding per frame.
 constexpr const UnsignedInt CELL_INFOS_TO_ALLOCATE = 30000;
+#if !RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+constexpr const UnsignedInt SHARED_CORRIDOR_FRAMES = LOGICFRAMES_PER_SECOND; // How long a hierarchical path is shared with other requests.
+#endif
+#if !RETAIL_COMPATIBLE_FLOW_FIELDS
+constexpr const UnsignedInt FLOW_FIELD_FRAMES = 2*LOGICFRAMES_PER_SECOND; // How long a flow field waits for the next request to its destination.
+constexpr const UnsignedShort FLOW_FIELD_UNREACHABLE = 0xffff;
+#endif
 
 //-----------------------------------------------------------------------------------
 PathNode::PathNode() :
@@ -1099,7 +1109,8 @@ Real Path::computeFlightDistToGoal( const Coord3D *pos, Coord3D& goalPos )
 }
 //-----------------------------------------------------------------------------------
 
-PathfindCellInfo *PathfindCellInfo::s_infoArray = nullptr;
+PathfindCellInfo *PathfindCellInfo::s_infoChunks[PathfindCellInfo::MAX_INFO_CHUNKS];
+Int PathfindCellInfo::s_infoChunkCount = 0;
 PathfindCellInfo *PathfindCellInfo::s_firstFree = nullptr;
 
 #if RETAIL_COMPATIBLE_PATHFINDING
@@ -1110,17 +1121,22 @@ Bool s_forceCleanCells = false;
 
 void PathfindCellInfo::forceCleanPathFindCellInfos()
 {
-	for (Int i = 0; i < CELL_INFOS_TO_ALLOCATE - 1; i++) {
-		s_infoArray[i].m_nextOpen = nullptr;
-		s_infoArray[i].m_prevOpen = nullptr;
-		s_infoArray[i].m_open = FALSE;
-		s_infoArray[i].m_closed = FALSE;
+	for (Int chunk = 0; chunk < s_infoChunkCount; chunk++) {
+		PathfindCellInfo *infos = s_infoChunks[chunk];
+		for (Int i = 0; i < CELL_INFOS_TO_ALLOCATE - 1; i++) {
+			infos[i].m_nextOpen = nullptr;
+			infos[i].m_prevOpen = nullptr;
+			infos[i].m_open = FALSE;
+			infos[i].m_closed = FALSE;
+			infos[i].m_onOpenListIndex = FALSE;
+		}
 	}
 }
 
 void Pathfinder::forceCleanCells()
 {
 	PathfindCellInfo::forceCleanPathFindCellInfos();
+	PathfindOpenListIndex::reset();
 	m_openList = nullptr;
 	m_closedList = nullptr;
 
@@ -1149,14 +1165,30 @@ void Pathfinder::forceCleanCells()
 void PathfindCellInfo::allocateCellInfos(void)
 {
 	releaseCellInfos();
-	s_infoArray = MSGNEW("PathfindCellInfo") PathfindCellInfo[CELL_INFOS_TO_ALLOCATE];	// pool[]ify
-	s_infoArray[CELL_INFOS_TO_ALLOCATE-1].m_pathParent = nullptr;
-	s_infoArray[CELL_INFOS_TO_ALLOCATE-1].m_isFree = true;
-	s_firstFree = s_infoArray;
+	allocateChunk();
+}
+
+/**
+ * Adds a block of CELL_INFOS_TO_ALLOCATE infos to the free list, in the order the first block always had.
+ */
+Bool PathfindCellInfo::allocateChunk(void)
+{
+	if (s_infoChunkCount >= MAX_INFO_CHUNKS) {
+		return false;
+	}
+	PathfindCellInfo *infos = MSGNEW("PathfindCellInfo") PathfindCellInfo[CELL_INFOS_TO_ALLOCATE];	// pool[]ify
+	infos[CELL_INFOS_TO_ALLOCATE-1].m_pathParent = s_firstFree;
+	infos[CELL_INFOS_TO_ALLOCATE-1].m_isFree = true;
+	s_firstFree = infos;
 	for (Int i=0; i<CELL_INFOS_TO_ALLOCATE-1; i++) {
-		s_infoArray[i].m_pathParent = &s_infoArray[i+1];
-		s_infoArray[i].m_isFree = true;
+		infos[i].m_pathParent = &infos[i+1];
+		infos[i].m_isFree = true;
 	}
+	s_infoChunks[s_infoChunkCount++] = infos;
+	if (s_infoChunkCount > 1) {
+		DEBUG_LOG(("Pathfind cell infos grown to %d", s_infoChunkCount*CELL_INFOS_TO_ALLOCATE));
+	}
+	return true;
 }
 
 /**
@@ -1164,7 +1196,7 @@ void PathfindCellInfo::allocateCellInfos(void)
  */
 void PathfindCellInfo::releaseCellInfos(void)
 {
-	if (s_infoArray==nullptr) {
+	if (s_infoChunkCount==0) {
 		return; // haven't allocated any yet.
 	}
 	Int count=0;
@@ -1173,9 +1205,12 @@ void PathfindCellInfo::releaseCellInfos(void)
 		DEBUG_ASSERTCRASH(s_firstFree->m_isFree, ("Should be freed."));
 		s_firstFree = s_firstFree->m_pathParent;
 	}
-	DEBUG_ASSERTCRASH(count==CELL_INFOS_TO_ALLOCATE, ("Error - Allocated cellinfos."));
-	delete[] s_infoArray;
-	s_infoArray = nullptr;
+	DEBUG_ASSERTCRASH(count==s_infoChunkCount*CELL_INFOS_TO_ALLOCATE, ("Error - Allocated cellinfos."));
+	for (Int chunk = 0; chunk < s_infoChunkCount; chunk++) {
+		delete[] s_infoChunks[chunk];
+		s_infoChunks[chunk] = nullptr;
+	}
+	s_infoChunkCount = 0;
 	s_firstFree = nullptr;
 }
 
@@ -1184,6 +1219,17 @@ void PathfindCellInfo::releaseCellInfos(void)
  */
 PathfindCellInfo *PathfindCellInfo::getACellInfo(PathfindCell *cell,const ICoord2D &pos)
 {
+	// TheSuperHackers @performance Grow the pool instead of failing the search once it runs dry.
+	// The retail compatible pathfinding keeps the single block, because retail clients fail the search there.
+#if RETAIL_COMPATIBLE_PATHFINDING
+	if (s_useFixedPathfinding)
+#endif
+	{
+		if (s_firstFree == nullptr) {
+			allocateChunk();
+		}
+	}
+
 	PathfindCellInfo *info = s_firstFree;
 	if (s_firstFree) {
 		DEBUG_ASSERTCRASH(s_firstFree->m_isFree, ("Should be freed."));
@@ -1199,6 +1245,8 @@ PathfindCellInfo *PathfindCellInfo::getACellInfo(PathfindCell *cell,const ICoord
 		info->m_totalCost = 0;
 		info->m_open = 0;
 		info->m_closed = 0;
+		info->m_onOpenListIndex = 0;
+		info->m_openListCost = 0;
 		info->m_obstacleID = INVALID_ID;
 		info->m_goalUnitID = INVALID_ID;
 		info->m_posUnitID = INVALID_ID;
@@ -1225,6 +1273,160 @@ void PathfindCellInfo::releaseACellInfo(PathfindCellInfo *theInfo)
 
 //-----------------------------------------------------------------------------------
 
+PathfindCellInfo *PathfindOpenListIndex::s_lastWithCost[PathfindOpenListIndex::COST_COUNT];
+UnsignedInt PathfindOpenListIndex::s_level0[PathfindOpenListIndex::LEVEL0_WORDS];
+UnsignedInt PathfindOpenListIndex::s_level1[PathfindOpenListIndex::LEVEL1_WORDS];
+UnsignedInt PathfindOpenListIndex::s_count = 0;
+Bool PathfindOpenListIndex::s_valid = true;
+
+static Int highestSetBit(UnsignedInt bits)
+{
+	Int bit = 0;
+	if (bits & 0xFFFF0000) { bits >>= 16; bit += 16; }
+	if (bits & 0xFF00) { bits >>= 8; bit += 8; }
+	if (bits & 0xF0) { bits >>= 4; bit += 4; }
+	if (bits & 0xC) { bits >>= 2; bit += 2; }
+	if (bits & 0x2) { bit += 1; }
+	return bit;
+}
+
+/**
+ * Empties the index. The cells still flagged as indexed must no longer be on the open list.
+ */
+void PathfindOpenListIndex::reset(void)
+{
+	memset(s_level0, 0, sizeof(s_level0));
+	memset(s_level1, 0, sizeof(s_level1));
+	s_count = 0;
+	s_valid = true;
+}
+
+/**
+ * Called when a cell is put on an empty list. The index is empty already, unless it went stale.
+ */
+void PathfindOpenListIndex::startList(void)
+{
+	if (!s_valid || s_count != 0)
+		reset();
+}
+
+/**
+ * Returns the highest cost on the list that is not above the given cost, or -1 if there is none.
+ */
+Int PathfindOpenListIndex::findCostAtOrBelow(Int cost)
+{
+	Int word = cost / WORD_BITS;
+	UnsignedInt bits = s_level0[word] & ((2u << (cost % WORD_BITS)) - 1);
+	if (bits)
+		return word * WORD_BITS + highestSetBit(bits);
+
+	if (word == 0)
+		return -1;
+
+	// find the highest non-zero word of level 0 below this one.
+	--word;
+	Int word1 = word / WORD_BITS;
+	bits = s_level1[word1] & ((2u << (word % WORD_BITS)) - 1);
+	while (bits == 0)
+	{
+		if (word1 == 0)
+			return -1;
+		bits = s_level1[--word1];
+	}
+	word = word1 * WORD_BITS + highestSetBit(bits);
+	return word * WORD_BITS + highestSetBit(s_level0[word]);
+}
+
+void PathfindOpenListIndex::clearCost(Int cost)
+{
+	Int word = cost / WORD_BITS;
+	s_level0[word] &= ~(1u << (cost % WORD_BITS));
+	if (s_level0[word] == 0)
+		s_level1[word / WORD_BITS] &= ~(1u << (word % WORD_BITS));
+}
+
+/**
+ * The insertion sort in putOnSortedOpenList() puts a cell after the last cell that does not cost more.
+ * The index knows that cell, unless the list was modified behind its back.
+ */
+Bool PathfindOpenListIndex::findInsertPosition(const PathfindCellInfo *info, const PathfindCellInfo *head, PathfindCellInfo *&insertAfter)
+{
+	if (!s_valid || info->m_open || info->m_onOpenListIndex)
+	{
+		s_valid = false;
+		return false;
+	}
+
+#if RETAIL_COMPATIBLE_PATHFINDING
+	// TheSuperHackers @info The retail compatible insertion sort stops after PATHFIND_CELLS_PER_FRAME cells,
+	// so a longer list is walked to get the same order.
+	if (s_count > PATHFIND_CELLS_PER_FRAME)
+	{
+		s_valid = false;
+		return false;
+	}
+#endif
+
+	Int cost = findCostAtOrBelow(info->m_totalCost);
+	if (cost < 0)
+	{
+		if (!head->m_onOpenListIndex)
+		{
+			s_valid = false;
+			return false;
+		}
+		insertAfter = nullptr;
+		return true;
+	}
+
+	PathfindCellInfo *last = s_lastWithCost[cost];
+	if (last->m_isFree || !last->m_open || !last->m_onOpenListIndex || last->m_openListCost != (UnsignedInt)cost)
+	{
+		s_valid = false;
+		return false;
+	}
+	insertAfter = last;
+	return true;
+}
+
+void PathfindOpenListIndex::insert(PathfindCellInfo *info)
+{
+	info->m_openListCost = info->m_totalCost;
+	info->m_onOpenListIndex = s_valid;
+	if (!s_valid)
+		return;
+
+	Int cost = info->m_totalCost;
+	Int word = cost / WORD_BITS;
+	s_lastWithCost[cost] = info;
+	s_level0[word] |= 1u << (cost % WORD_BITS);
+	s_level1[word / WORD_BITS] |= 1u << (word % WORD_BITS);
+	++s_count;
+}
+
+void PathfindOpenListIndex::remove(PathfindCellInfo *info)
+{
+	if (!info->m_onOpenListIndex)
+		return;
+
+	info->m_onOpenListIndex = FALSE;
+	if (!s_valid)
+		return;
+
+	--s_count;
+	Int cost = info->m_openListCost;
+	if (s_lastWithCost[cost] == info)
+	{
+		PathfindCellInfo *prev = info->m_prevOpen;
+		if (prev && prev->m_onOpenListIndex && prev->m_openListCost == (UnsignedInt)cost)
+			s_lastWithCost[cost] = prev;
+		else
+			clearCost(cost);
+	}
+}
+
+//-----------------------------------------------------------------------------------
+
 /**
  * Constructor
  */
@@ -1280,6 +1482,7 @@ Bool PathfindCell::startPathfind( PathfindCell *goalCell  )
 	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
 	m_info->m_nextOpen = nullptr;
 	m_info->m_prevOpen = nullptr;
+	m_info->m_onOpenListIndex = FALSE;
 	m_info->m_pathParent = nullptr;
 	m_info->m_costSoFar = 0;		// start node, no cost to get here
 	m_info->m_totalCost = 0;
@@ -1675,12 +1878,33 @@ PathfindCell *PathfindCell::putOnSortedOpenList( PathfindCell *list )
 {
 	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
 	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==FALSE, ("Serious error - Invalid flags. jba"));
+	PathfindCellInfo *insertAfter;
 	if (list == nullptr)
 	{
+		PathfindOpenListIndex::startList();
 		list = this;
 		m_info->m_prevOpen = nullptr;
 		m_info->m_nextOpen = nullptr;
 	}
+	else if (PathfindOpenListIndex::findInsertPosition(m_info, list->m_info, insertAfter))
+	{
+		// TheSuperHackers @performance Insert after the last cell that does not cost more, without walking the list.
+		if (insertAfter)
+		{
+			m_info->m_prevOpen = insertAfter;
+			m_info->m_nextOpen = insertAfter->m_nextOpen;
+			if (insertAfter->m_nextOpen)
+				insertAfter->m_nextOpen->m_prevOpen = this->m_info;
+			insertAfter->m_nextOpen = this->m_info;
+		}
+		else
+		{
+			m_info->m_prevOpen = nullptr;
+			m_info->m_nextOpen = list->m_info;
+			list->m_info->m_prevOpen = this->m_info;
+			list = this;
+		}
+	}
 	else
 	{
 		// insertion sort
@@ -1729,6 +1953,7 @@ PathfindCell *PathfindCell::putOnSortedOpenList( PathfindCell *list )
 	// mark newCell as being on open list
 	m_info->m_open = true;
 	m_info->m_closed = false;
+	PathfindOpenListIndex::insert(m_info);
 
 	return list;
 }
@@ -1738,6 +1963,7 @@ PathfindCell *PathfindCell::removeFromOpenList( PathfindCell *list )
 {
 	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
 	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==TRUE, ("Serious error - Invalid flags. jba"));
+	PathfindOpenListIndex::remove(m_info);
 	if (m_info->m_nextOpen)
 		m_info->m_nextOpen->m_prevOpen = m_info->m_prevOpen;
 
@@ -1784,8 +2010,10 @@ Int PathfindCell::releaseOpenList( PathfindCell *list )
 		curInfo->m_nextOpen = nullptr;
 		curInfo->m_prevOpen = nullptr;
 		curInfo->m_open = FALSE;
+		curInfo->m_onOpenListIndex = FALSE;
 		cur->releaseInfo();
 	}
+	PathfindOpenListIndex::reset();
 	return count;
 }
 
@@ -2216,17 +2444,26 @@ m_groundWaterZones(nullptr),
 m_groundRubbleZones(nullptr),
 m_crusherZones(nullptr),
 m_zonesAllocated(0),
-m_interactsWithBridge(FALSE)
+m_interactsWithBridge(FALSE),
+m_dirty(FALSE)
 {
 	m_cellOrigin.x = 0;
 	m_cellOrigin.y = 0;
 	m_firstZone = 0;
 	m_markedPassable = TRUE;
+#if !RETAIL_COMPATIBLE_PATHFIND_ZONES
+	m_equivalencies = nullptr;
+	m_numEquivalencies = 0;
+	m_equivalenciesAllocated = 0;
+#endif
 }
 
 ZoneBlock::~ZoneBlock()
 {
 	freeZones();
+#if !RETAIL_COMPATIBLE_PATHFIND_ZONES
+	delete [] m_equivalencies;
+#endif
 }
 
 void ZoneBlock::freeZones(void)
@@ -2404,10 +2641,47 @@ void ZoneBlock::allocateZones(void)
 	m_crusherZones = MSGNEW("PathfindZoneInfo") zoneStorageType[m_zonesAllocated];
 }
 
+#if !RETAIL_COMPATIBLE_PATHFIND_ZONES
+/* Remember that two zones are equivalent in one of the zone manager's tables.  Many cells along
+a zone border give the same equivalency, so it is only stored once. */
+void ZoneBlock::addEquivalency(Int table, zoneStorageType zone1, zoneStorageType zone2)
+{
+	if (zone1 > zone2) {
+		zoneStorageType zone = zone1;
+		zone1 = zone2;
+		zone2 = zone;
+	}
+	Int i;
+	for (i=0; i<m_numEquivalencies; i++) {
+		const ZoneEquivalency &equivalency = m_equivalencies[i];
+		if (equivalency.m_zone1 == zone1 && equivalency.m_zone2 == zone2 && equivalency.m_table == table) {
+			return;
+		}
+	}
+	if (m_numEquivalencies == m_equivalenciesAllocated) {
+		m_equivalenciesAllocated = m_equivalenciesAllocated ? m_equivalenciesAllocated*2 : 16;
+		ZoneEquivalency *equivalencies = MSGNEW("PathfindZoneInfo") ZoneEquivalency[m_equivalenciesAllocated];
+		for (i=0; i<m_numEquivalencies; i++) {
+			equivalencies[i] = m_equivalencies[i];
+		}
+		delete [] m_equivalencies;
+		m_equivalencies = equivalencies;
+	}
+	ZoneEquivalency &equivalency = m_equivalencies[m_numEquivalencies++];
+	equivalency.m_zone1 = zone1;
+	equivalency.m_zone2 = zone2;
+	equivalency.m_table = (UnsignedByte)table;
+}
+#endif
+
 
 //------------------------  PathfindZoneManager  -------------------------------
 PathfindZoneManager::PathfindZoneManager() : m_maxZone(0),
 m_nextFrameToCalculateZones(0),
+m_zoneRevision(0),
+m_numDirtyBlocks(0),
+m_allBlocksDirty(false),
+m_maxZoneAfterFullCalculation(0),
 m_groundCliffZones(nullptr),
 m_groundWaterZones(nullptr),
 m_groundRubbleZones(nullptr),
@@ -2508,6 +2782,55 @@ void PathfindZoneManager::reset(void)  ///< Called when the map is reset.
 {
 	freeZones();
 	freeBlocks();
+	m_numDirtyBlocks = 0;
+	m_allBlocksDirty = false;
+	m_maxZoneAfterFullCalculation = 0;
+}
+
+/* Get the cell bounds of a zone block.  Bounds are inclusive. */
+void PathfindZoneManager::getBlockBounds(Int xBlock, Int yBlock, const IRegion2D &globalBounds, IRegion2D &bounds) const
+{
+	bounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
+	bounds.lo.y = globalBounds.lo.y + yBlock*ZONE_BLOCK_SIZE;
+	bounds.hi.x = bounds.lo.x + ZONE_BLOCK_SIZE - 1;
+	bounds.hi.y = bounds.lo.y + ZONE_BLOCK_SIZE - 1;
+	if (bounds.hi.x > globalBounds.hi.x) {
+		bounds.hi.x = globalBounds.hi.x;
+	}
+	if (bounds.hi.y > globalBounds.hi.y) {
+		bounds.hi.y = globalBounds.hi.y;
+	}
+}
+
+/* Mark the blocks containing cells that changed type, so the next zone calculation can
+be limited to them. */
+void PathfindZoneManager::markBlocksDirty(const IRegion2D &cellBounds)
+{
+	Int loX = MAX(cellBounds.lo.x/ZONE_BLOCK_SIZE, 0);
+	Int loY = MAX(cellBounds.lo.y/ZONE_BLOCK_SIZE, 0);
+	Int hiX = MIN(cellBounds.hi.x/ZONE_BLOCK_SIZE, m_zoneBlockExtent.x-1);
+	Int hiY = MIN(cellBounds.hi.y/ZONE_BLOCK_SIZE, m_zoneBlockExtent.y-1);
+	Int blockX, blockY;
+	for (blockX = loX; blockX<=hiX; blockX++) {
+		for (blockY = loY; blockY<=hiY; blockY++) {
+			if (!m_zoneBlocks[blockX][blockY].isDirty()) {
+				m_zoneBlocks[blockX][blockY].setDirty(true);
+				m_numDirtyBlocks++;
+			}
+		}
+	}
+}
+
+void PathfindZoneManager::clearDirtyBlocks(void)
+{
+	Int blockX, blockY;
+	for (blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
+		for (blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
+			m_zoneBlocks[blockX][blockY].setDirty(false);
+		}
+	}
+	m_numDirtyBlocks = 0;
+	m_allBlocksDirty = false;
 }
 
 
@@ -2521,6 +2844,37 @@ void PathfindZoneManager::markZonesDirty( Bool insert )  ///< Called when the zo
     m_nextFrameToCalculateZones = MIN( m_nextFrameToCalculateZones, TheGameLogic->getFrame() + ZONE_UPDATE_FREQUENCY );
 }
 
+/**
+ * TheSuperHackers @bugfix The load calculates the zones of the whole map right away. A replay checkpoint
+ * recalculates them on the same frame and with the same revision as the recorded game.
+ */
+void PathfindZoneManager::xferCheckpoint( Xfer *xfer )
+{
+	xfer->xferUnsignedInt( &m_nextFrameToCalculateZones );
+	xfer->xferUnsignedInt( &m_zoneRevision );
+
+	// The dirty blocks decide which zones keep their numbers on the next calculation.
+	ICoord2D extent = m_zoneBlockExtent;
+	xfer->xferICoord2D( &extent );
+	if (extent.x != m_zoneBlockExtent.x || extent.y != m_zoneBlockExtent.y) {
+		DEBUG_CRASH(("Zone block extent %d x %d does not match the map", extent.x, extent.y));
+		throw XFER_INVALID_PARAMETERS;
+	}
+	xfer->xferBool( &m_allBlocksDirty );
+	Int numDirtyBlocks = 0;
+	for (Int blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
+		for (Int blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
+			Bool dirty = m_zoneBlocks[blockX][blockY].isDirty();
+			xfer->xferBool( &dirty );
+			m_zoneBlocks[blockX][blockY].setDirty(dirty);
+			if (dirty) {
+				numDirtyBlocks++;
+			}
+		}
+	}
+	m_numDirtyBlocks = numDirtyBlocks;
+}
+
 /**
  * Calculate zones.  A zone is an area of the same terrain - clear, water or cliff.
  * The utility of zones is that if current location and destination are in the same zone,
@@ -2549,8 +2903,15 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 #endif
 #endif
 
+	m_zoneRevision++;
+#if !RETAIL_COMPATIBLE_PATHFIND_ZONES
+	// TheSuperHackers @performance Recalculate only the blocks with changed cells, if there are few of them.
+	if (calculateDirtyZones(map, layers, globalBounds)) {
+		return;
+	}
+#endif
 	m_maxZone = 1;	// we start using zone 0 as a flag.
-	const Int maxZones=24000;
+	const Int maxZones=MAX_ZONES;
 	zoneStorageType zoneEquivalency[maxZones];
 	Int i, j;
 	for (i=0; i<maxZones; i++) {
@@ -2691,6 +3052,7 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 		}
 	}
 
+#if RETAIL_COMPATIBLE_PATHFIND_ZONES
 	i = 0;
   while ( i < m_zonesAllocated )
 	{
@@ -2788,6 +3150,19 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 
     ++j;
 	}
+#else
+	for (xBlock=0; xBlock<xCount; xBlock++)
+	{
+		for (yBlock=0; yBlock<yCount; yBlock++)
+		{
+			IRegion2D bounds;
+			getBlockBounds(xBlock, yBlock, globalBounds, bounds);
+			calculateBlockEquivalencies(map, layers, bounds, globalBounds, m_zoneBlocks[xBlock][yBlock]);
+		}
+	}
+	resolveBlockEquivalencies();
+  REGISTER UnsignedInt maxZone = m_maxZone;
+#endif
 
   //FLATTEN HIERARCHICAL ZONES
   {
@@ -2857,9 +3232,284 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 		}
 	}
 #endif
+	clearDirtyBlocks();
+	m_maxZoneAfterFullCalculation = m_maxZone;
 	m_nextFrameToCalculateZones = 0xffffffff;
 }
 
+#if !RETAIL_COMPATIBLE_PATHFIND_ZONES
+/**
+ * Recalculate the zones of the dirty blocks only.  The cells of a block are zoned on their own,
+ * so the other blocks keep their zones, and only the equivalencies along the borders of the dirty
+ * blocks are determined again.  Returns false if the whole map needs to be calculated instead.
+ */
+Bool PathfindZoneManager::calculateDirtyZones( PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds )
+{
+	if (m_allBlocksDirty || m_numDirtyBlocks == 0 || m_maxZoneAfterFullCalculation == 0) {
+		return false;
+	}
+	if (m_numDirtyBlocks*4 > m_zoneBlockExtent.x*m_zoneBlockExtent.y) {
+		return false;
+	}
+	// Blocks that get more zones are numbered after all others.  Renumber the whole map before the
+	// tables get too large.
+	if (m_maxZone + m_numDirtyBlocks*ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE >= MAX_ZONES ||
+			m_maxZone > 2*m_maxZoneAfterFullCalculation + INITIAL_ZONES) {
+		return false;
+	}
+
+	Int xBlock, yBlock;
+	IRegion2D bounds;
+	for (xBlock=0; xBlock<m_zoneBlockExtent.x; xBlock++) {
+		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
+			if (m_zoneBlocks[xBlock][yBlock].isDirty()) {
+				getBlockBounds(xBlock, yBlock, globalBounds, bounds);
+				calculateBlockCellZones(map, bounds, m_zoneBlocks[xBlock][yBlock]);
+			}
+		}
+	}
+
+	Int i;
+	for (i=0; i<=LAYER_LAST; i++) {
+		if (!layers[i].isUnused() && !layers[i].isDestroyed()) {
+			ICoord2D ndx;
+			layers[i].getStartCellIndex(&ndx);
+			setBridge(ndx.x, ndx.y, true);
+			layers[i].getEndCellIndex(&ndx);
+			setBridge(ndx.x, ndx.y, true);
+		}
+	}
+
+	allocateZones();
+
+	for (xBlock=0; xBlock<m_zoneBlockExtent.x; xBlock++) {
+		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
+			if (m_zoneBlocks[xBlock][yBlock].isDirty()) {
+				getBlockBounds(xBlock, yBlock, globalBounds, bounds);
+				m_zoneBlocks[xBlock][yBlock].blockCalculateZones(map, layers, bounds);
+			}
+		}
+	}
+
+	// The blocks right of and below a dirty block compare their cells with the cells of the dirty block.
+	for (xBlock=0; xBlock<m_zoneBlockExtent.x; xBlock++) {
+		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
+			if (m_zoneBlocks[xBlock][yBlock].isDirty() ||
+					(xBlock>0 && m_zoneBlocks[xBlock-1][yBlock].isDirty()) ||
+					(yBlock>0 && m_zoneBlocks[xBlock][yBlock-1].isDirty())) {
+				getBlockBounds(xBlock, yBlock, globalBounds, bounds);
+				calculateBlockEquivalencies(map, layers, bounds, globalBounds, m_zoneBlocks[xBlock][yBlock]);
+			}
+		}
+	}
+	resolveBlockEquivalencies();
+
+	flattenZones(m_groundCliffZones, m_hierarchicalZones, m_maxZone);
+	flattenZones(m_groundWaterZones, m_hierarchicalZones, m_maxZone);
+	flattenZones(m_groundRubbleZones, m_hierarchicalZones, m_maxZone);
+	flattenZones(m_terrainZones, m_hierarchicalZones, m_maxZone);
+	flattenZones(m_crusherZones, m_hierarchicalZones, m_maxZone);
+
+	clearDirtyBlocks();
+	m_nextFrameToCalculateZones = 0xffffffff;
+	return true;
+}
+
+/**
+ * Zone the cells of one block, like the first pass of calculateZones does for all blocks.
+ * The block reuses its zone numbers if it has no more zones than before.
+ */
+void PathfindZoneManager::calculateBlockCellZones( PathfindCell **map, const IRegion2D &bounds, ZoneBlock &block )
+{
+	const Int maxZones = ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE+1;
+	zoneStorageType zoneEquivalency[maxZones];
+	Int numZones = 1;	// we start using zone 0 as a flag.
+	Int i, j;
+	for (i=0; i<maxZones; i++) {
+		zoneEquivalency[i] = i;
+	}
+
+	block.setInteractsWithBridge(false);
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			PathfindCell *cell = &map[i][j];
+			cell->setZone(0);
+
+			if (i>bounds.lo.x) {
+				if (map[i][j].getType() == map[i-1][j].getType()) {
+					applyZone(map[i][j], map[i-1][j], zoneEquivalency, numZones);
+				}
+			}
+			if (j>bounds.lo.y) {
+				if (map[i][j].getType() == map[i][j-1].getType()) {
+					applyZone(map[i][j], map[i][j-1], zoneEquivalency, numZones);
+				}
+			}
+			if (cell->getZone()==0) {
+				cell->setZone(numZones);
+				numZones++;
+			}
+			if (cell->getConnectLayer() > LAYER_GROUND) {
+				block.setInteractsWithBridge(true);
+			}
+		}
+	}
+
+	// Collapse the zones into a 0,1,2... sequence.
+	Int collapsedZones[maxZones];
+	Int numCollapsedZones = 0;
+	for (i=1; i<numZones; i++) {
+		Int zone = zoneEquivalency[i];
+		if (zone == i) {
+			collapsedZones[i] = numCollapsedZones;
+			numCollapsedZones++;
+		}	else {
+			collapsedZones[i] = collapsedZones[zone];
+		}
+	}
+
+	Int firstZone = block.getFirstZone();
+	if (numCollapsedZones > block.getNumZones()) {
+		firstZone = m_maxZone;
+		m_maxZone += numCollapsedZones;
+	}
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			map[i][j].setZone(firstZone + collapsedZones[map[i][j].getZone()]);
+		}
+	}
+}
+
+/**
+ * Determine the zone equivalencies between the cells of a block and their left and top
+ * neighbors, like the equivalency pass of calculateZones does for all cells.
+ */
+void PathfindZoneManager::calculateBlockEquivalencies( PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds,
+	const IRegion2D &globalBounds, ZoneBlock &block )
+{
+	block.clearEquivalencies();
+
+	Int i, j;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			const PathfindCell &r_thisCell = map[i][j];
+
+			if ( (r_thisCell.getConnectLayer() > LAYER_GROUND) &&
+				(r_thisCell.getType() == PathfindCell::CELL_CLEAR) ) {
+				PathfindLayer *layer = layers + r_thisCell.getConnectLayer();
+				block.addEquivalency(ZONE_TABLE_HIERARCHICAL, r_thisCell.getZone(), layer->getZone());
+			}
+
+			if (i > globalBounds.lo.x && r_thisCell.getZone() != map[i-1][j].getZone()) {
+				const PathfindCell &r_leftCell = map[i-1][j];
+				if (r_thisCell.getType() == r_leftCell.getType()) {
+					block.addEquivalency(ZONE_TABLE_HIERARCHICAL, r_thisCell.getZone(), r_leftCell.getZone());
+				}	else {
+					Bool notTerrainOrCrusher = TRUE;
+					if (terrain(r_thisCell, r_leftCell)) {
+						block.addEquivalency(ZONE_TABLE_TERRAIN, r_thisCell.getZone(), r_leftCell.getZone());
+						notTerrainOrCrusher = FALSE;
+					}
+					if (crusherGround(r_thisCell, r_leftCell)) {
+						block.addEquivalency(ZONE_TABLE_CRUSHER, r_thisCell.getZone(), r_leftCell.getZone());
+						notTerrainOrCrusher = FALSE;
+					}
+					if (notTerrainOrCrusher) {
+						if (waterGround(r_thisCell, r_leftCell)) {
+							block.addEquivalency(ZONE_TABLE_GROUND_WATER, r_thisCell.getZone(), r_leftCell.getZone());
+						}	else if (groundRubble(r_thisCell, r_leftCell)) {
+							block.addEquivalency(ZONE_TABLE_GROUND_RUBBLE, r_thisCell.getZone(), r_leftCell.getZone());
+						}	else if (groundCliff(r_thisCell, r_leftCell)) {
+							block.addEquivalency(ZONE_TABLE_GROUND_CLIFF, r_thisCell.getZone(), r_leftCell.getZone());
+						}
+					}
+				}
+			}
+
+			if (j > globalBounds.lo.y && r_thisCell.getZone() != map[i][j-1].getZone()) {
+				const PathfindCell &r_topCell = map[i][j-1];
+				if (r_thisCell.getType() == r_topCell.getType()) {
+					block.addEquivalency(ZONE_TABLE_HIERARCHICAL, r_thisCell.getZone(), r_topCell.getZone());
+				}	else {
+					if (terrain(r_thisCell, r_topCell)) {
+						block.addEquivalency(ZONE_TABLE_TERRAIN, r_thisCell.getZone(), r_topCell.getZone());
+					}
+					if (crusherGround(r_thisCell, r_topCell)) {
+						block.addEquivalency(ZONE_TABLE_CRUSHER, r_thisCell.getZone(), r_topCell.getZone());
+					}
+					if (waterGround(r_thisCell, r_topCell)) {
+						block.addEquivalency(ZONE_TABLE_GROUND_WATER, r_thisCell.getZone(), r_topCell.getZone());
+					}	else if (groundRubble(r_thisCell, r_topCell)) {
+						block.addEquivalency(ZONE_TABLE_GROUND_RUBBLE, r_thisCell.getZone(), r_topCell.getZone());
+					}	else if (groundCliff(r_thisCell, r_topCell)) {
+						block.addEquivalency(ZONE_TABLE_GROUND_CLIFF, r_thisCell.getZone(), r_topCell.getZone());
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Find the root of a zone in an equivalency table where every zone points to a lower zone or itself.
+ */
+static Int findZoneRoot(zoneStorageType *zoneEquivalency, Int zone)
+{
+	while (zoneEquivalency[zone] != zone) {
+		zoneEquivalency[zone] = zoneEquivalency[zoneEquivalency[zone]];
+		zone = zoneEquivalency[zone];
+	}
+	return zone;
+}
+
+/**
+ * Fill the zone tables from the equivalencies of all blocks.  Like resolveZones, every zone ends
+ * up mapped to the lowest zone it is equivalent to.
+ */
+void PathfindZoneManager::resolveBlockEquivalencies(void)
+{
+	zoneStorageType *tables[ZONE_TABLE_COUNT];
+	tables[ZONE_TABLE_HIERARCHICAL] = m_hierarchicalZones;
+	tables[ZONE_TABLE_TERRAIN] = m_terrainZones;
+	tables[ZONE_TABLE_CRUSHER] = m_crusherZones;
+	tables[ZONE_TABLE_GROUND_WATER] = m_groundWaterZones;
+	tables[ZONE_TABLE_GROUND_RUBBLE] = m_groundRubbleZones;
+	tables[ZONE_TABLE_GROUND_CLIFF] = m_groundCliffZones;
+
+	Int i;
+	for (i=0; i<m_zonesAllocated; i++) {
+		m_groundCliffZones[i] = m_groundWaterZones[i] = m_groundRubbleZones[i] = m_terrainZones[i] = m_crusherZones[i] = m_hierarchicalZones[i] = i;
+	}
+
+	Int blockX, blockY;
+	for (blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
+		for (blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
+			const ZoneBlock &block = m_zoneBlocks[blockX][blockY];
+			for (i=0; i<block.getNumEquivalencies(); i++) {
+				const ZoneBlock::ZoneEquivalency &equivalency = block.getEquivalency(i);
+				zoneStorageType *table = tables[equivalency.m_table];
+				Int zone1 = findZoneRoot(table, equivalency.m_zone1);
+				Int zone2 = findZoneRoot(table, equivalency.m_zone2);
+				if (zone1 < zone2) {
+					table[zone2] = zone1;
+				}	else if (zone2 < zone1) {
+					table[zone1] = zone2;
+				}
+			}
+		}
+	}
+
+	// Every zone points to a lower zone, so one pass in increasing order maps all zones to their root.
+	Int table;
+	for (table=0; table<ZONE_TABLE_COUNT; table++) {
+		zoneStorageType *zoneEquivalency = tables[table];
+		for (i=0; i<m_maxZone; i++) {
+			zoneEquivalency[i] = zoneEquivalency[zoneEquivalency[i]];
+		}
+	}
+}
+#endif
+
 /**
  * Update zones where a structure has been added or removed.
  * This can be done by just updating the equivalency arrays, without rezoning the map..
@@ -2876,6 +3526,8 @@ void PathfindZoneManager::updateZonesForModify(PathfindCell **map, PathfindLayer
 	QueryPerformanceCounter((LARGE_INTEGER *)&startTime64);
 #endif
 #endif
+	m_zoneRevision++;
+	markBlocksDirty(structureBounds);
 	IRegion2D bounds = structureBounds;
 	bounds.hi.x++;
 	bounds.hi.y++;
@@ -3027,6 +3679,39 @@ void PathfindZoneManager::setAllPassable( )
 	}
 }
 
+//
+// Get the passable blocks.
+//
+Int PathfindZoneManager::getPassableBlocks(ICoord2D *blocks, Int maxBlocks) const
+{	Int blockX;
+	Int blockY;
+	Int numBlocks = 0;
+	for (blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
+		for (blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
+			if (m_zoneBlocks[blockX][blockY].isPassable()) {
+				if (numBlocks >= maxBlocks) {
+					return -1;
+				}
+				blocks[numBlocks].x = blockX;
+				blocks[numBlocks].y = blockY;
+				numBlocks++;
+			}
+		}
+	}
+	return numBlocks;
+}
+
+//
+// Set the passable flags of the given blocks.
+//
+void PathfindZoneManager::setPassableBlocks(const ICoord2D *blocks, Int numBlocks)
+{
+	Int i;
+	for (i=0; i<numBlocks; i++) {
+		m_zoneBlocks[blocks[i].x][blocks[i].y].setPassable(true);
+	}
+}
+
 //
 // Set the passable flag for the block at this location.
 //
@@ -3873,6 +4558,7 @@ void Pathfinder::reset( void )
 	m_logicalExtent.lo.x=m_logicalExtent.lo.y=m_logicalExtent.hi.x=m_logicalExtent.hi.y=0;
 	m_openList = nullptr;
 	m_closedList = nullptr;
+	PathfindOpenListIndex::reset();
 
 	m_ignoreObstacleID = INVALID_ID;
 	m_isTunneling = false;
@@ -3894,9 +4580,27 @@ void Pathfinder::reset( void )
 
 	for (m_queuePRHead=0; m_queuePRHead<PATHFIND_QUEUE_LEN; m_queuePRHead++) {
 		m_queuedPathfindRequests[m_queuePRHead] = INVALID_ID;
+		m_queuedPathfindFrames[m_queuePRHead] = 0;
+		m_queuedPathfindFromPlayer[m_queuePRHead] = false;
 	}
 	m_queuePRHead = 0;
 	m_queuePRTail = 0;
+	m_queuedPlayerRequests = 0;
+	memset(&m_queueStats, 0, sizeof(m_queueStats));
+#if !RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+	m_numSharedCorridors = 0;
+	m_nextSharedCorridor = 0;
+#endif
+#if !RETAIL_COMPATIBLE_FLOW_FIELDS
+	for (i=0; i<MAX_FLOW_FIELDS; i++) {
+		m_flowFields[i].m_requests = 0;
+		m_flowFields[i].m_isIntegrated = false;
+		m_flowFields[i].m_extent.lo.x = m_flowFields[i].m_extent.lo.y = 0;
+		m_flowFields[i].m_extent.hi.x = m_flowFields[i].m_extent.hi.y = 0;
+		std::vector<UnsignedShort>().swap(m_flowFields[i].m_costs);
+	}
+	m_nextFlowField = 0;
+#endif
 
 	m_numWallPieces = 0;
 	for (i=0; i<MAX_WALL_PIECES; ++i)
@@ -4328,6 +5032,8 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, Bool insert )
 	if (cellBounds.hi.y > m_extent.hi.y) {
 		cellBounds.hi.y = m_extent.hi.y;
 	}
+	// Cells around the footprint can change between clear and impassable below.
+	m_zoneManager.markBlocksDirty(cellBounds);
 
 	if (!insert) {
 		for( j=cellBounds.lo.y; j<=cellBounds.hi.y; j++ )
@@ -4589,6 +5295,7 @@ void Pathfinder::classifyMap(void)
 	if (!m_layers[LAYER_WALL].isUnused()) {
 		m_layers[LAYER_WALL].classifyWallCells(m_wallPieces, m_numWallPieces);
 	}
+	m_zoneManager.markAllBlocksDirty();
 	m_zoneManager.calculateZones(m_map, m_layers, m_extent);
 }
 
@@ -5557,13 +6264,59 @@ Bool Pathfinder::queueForPath(ObjectID id)
 	if (nextSlot >= PATHFIND_QUEUE_LEN) {
 		nextSlot = 0;
 	}
-	if (nextSlot==m_queuePRHead) {
-		DEBUG_CRASH(("Ran out of pathfind queue slots."));
-		return false;
+	if (nextSlot==m_queuePRHead) {
+		DEBUG_CRASH(("Ran out of pathfind queue slots."));
+		return false;
+	}
+	Bool fromPlayer = false;
+	Object *obj = TheGameLogic->findObjectByID(id);
+	if (obj && obj->getAIUpdateInterface()) {
+		fromPlayer = obj->getAIUpdateInterface()->getLastCommandSource() == CMD_FROM_PLAYER;
+	}
+	m_queuedPathfindRequests[m_queuePRTail] = id;
+	m_queuedPathfindFrames[m_queuePRTail] = TheGameLogic->getFrame();
+	m_queuedPathfindFromPlayer[m_queuePRTail] = fromPlayer;
+	if (fromPlayer) {
+		m_queuedPlayerRequests++;
+	}
+	m_queuePRTail = nextSlot;
+
+	UnsignedInt depth = (m_queuePRTail - m_queuePRHead + PATHFIND_QUEUE_LEN) % PATHFIND_QUEUE_LEN;
+	if (m_queueStats.m_maxQueueDepth < depth) {
+		m_queueStats.m_maxQueueDepth = depth;
+	}
+	return true;
+}
+
+/**
+ * Moves the first queued request of a player command to the head of the queue,
+ * the requests in front of it move back by one.
+ */
+void Pathfinder::moveFirstPlayerRequestToHead(void)
+{
+	Int slot = m_queuePRHead;
+	while (slot != m_queuePRTail && !m_queuedPathfindFromPlayer[slot]) {
+		slot++;
+		if (slot >= PATHFIND_QUEUE_LEN) {
+			slot = 0;
+		}
+	}
+	if (slot == m_queuePRTail || slot == m_queuePRHead) {
+		return;
 	}
-	m_queuedPathfindRequests[m_queuePRTail] = id;
-	m_queuePRTail = nextSlot;
-	return true;
+
+	ObjectID id = m_queuedPathfindRequests[slot];
+	UnsignedInt frame = m_queuedPathfindFrames[slot];
+	while (slot != m_queuePRHead) {
+		Int prevSlot = slot > 0 ? slot-1 : PATHFIND_QUEUE_LEN-1;
+		m_queuedPathfindRequests[slot] = m_queuedPathfindRequests[prevSlot];
+		m_queuedPathfindFrames[slot] = m_queuedPathfindFrames[prevSlot];
+		m_queuedPathfindFromPlayer[slot] = m_queuedPathfindFromPlayer[prevSlot];
+		slot = prevSlot;
+	}
+	m_queuedPathfindRequests[slot] = id;
+	m_queuedPathfindFrames[slot] = frame;
+	m_queuedPathfindFromPlayer[slot] = true;
 }
 
 #if defined(RTS_DEBUG)
@@ -5793,14 +6546,52 @@ void Pathfinder::processPathfindQueue(void)
 	bounds.hi.y--;
 	m_logicalExtent = bounds;
 
+	// TheSuperHackers @performance The queue stops after PATHFIND_CELLS_PER_FRAME cells, which is deterministic.
+	// With -pathfindTimeBudget, it stops after that many microseconds instead, so that a large group move
+	// does not spike a frame. Time is not deterministic, so the time budget is only used in games that are
+	// neither multiplayer, recorded nor played back.
+	const Bool useTimeBudget = TheGlobalData->m_pathfindTimeBudgetMicros > 0 &&
+		!TheRecorder->isMultiplayer() && !TheRecorder->isPlaybackMode() && !TheRecorder->isRecording();
+	LARGE_INTEGER budgetStart, budgetFrequency;
+	if (useTimeBudget) {
+		QueryPerformanceFrequency(&budgetFrequency);
+		QueryPerformanceCounter(&budgetStart);
+	}
+
 	m_cumulativeCellsAllocated = 0;	// Number of pathfind cells examined.
 #ifdef DEBUG_QPF
 	Int pathsFound = 0;
 #endif
-	while (m_cumulativeCellsAllocated < PATHFIND_CELLS_PER_FRAME &&
-		m_queuePRTail!=m_queuePRHead) {
+	Int requestsProcessed = 0;
+	while (m_queuePRTail!=m_queuePRHead) {
+		if (useTimeBudget) {
+			LARGE_INTEGER now;
+			QueryPerformanceCounter(&now);
+			Int elapsedMicros = (Int)((now.QuadPart - budgetStart.QuadPart) * 1000000 / budgetFrequency.QuadPart);
+			if (requestsProcessed > 0 && elapsedMicros >= TheGlobalData->m_pathfindTimeBudgetMicros) {
+				break;
+			}
+		} else if (m_cumulativeCellsAllocated >= PATHFIND_CELLS_PER_FRAME) {
+			break;
+		}
+
+#if !RETAIL_COMPATIBLE_PATHFIND_QUEUE
+		// TheSuperHackers @performance Player commands get their paths before the AI retargets its units.
+		if (m_queuedPlayerRequests > 0) {
+			moveFirstPlayerRequestToHead();
+		}
+#endif
+
+		if (m_queuedPathfindFromPlayer[m_queuePRHead]) {
+			m_queuedPlayerRequests--;
+			m_queueStats.m_playerRequests++;
+		}
+		UnsignedInt waitFrames = TheGameLogic->getFrame() - m_queuedPathfindFrames[m_queuePRHead];
+		Int cellsBefore = m_cumulativeCellsAllocated;
+
 		Object *obj = TheGameLogic->findObjectByID(m_queuedPathfindRequests[m_queuePRHead]);
 		m_queuedPathfindRequests[m_queuePRHead] = INVALID_ID;
+		m_queuedPathfindFromPlayer[m_queuePRHead] = false;
 		if (obj) {
 			AIUpdateInterface *ai = obj->getAIUpdateInterface();
 			if (ai) {
@@ -5814,6 +6605,21 @@ void Pathfinder::processPathfindQueue(void)
 		if (m_queuePRHead >= PATHFIND_QUEUE_LEN) {
 			m_queuePRHead = 0;
 		}
+
+		UnsignedInt cells = m_cumulativeCellsAllocated - cellsBefore;
+		requestsProcessed++;
+		m_queueStats.m_requests++;
+		m_queueStats.m_totalWaitFrames += waitFrames;
+		m_queueStats.m_totalCells += cells;
+		if (m_queueStats.m_maxWaitFrames < waitFrames) {
+			m_queueStats.m_maxWaitFrames = waitFrames;
+		}
+		if (m_queueStats.m_maxCells < cells) {
+			m_queueStats.m_maxCells = cells;
+		}
+	}
+	if (m_queuePRTail!=m_queuePRHead) {
+		m_queueStats.m_backlogFrames++;
 	}
 	if (pathsFound>0) {
 #ifdef DEBUG_QPF
@@ -6225,10 +7031,38 @@ Path *Pathfinder::findPath( Object *obj, const LocomotorSet& locomotorSet, const
 		isHuman = false; // computer gets to cheat.
 	}
 
+#if !RETAIL_COMPATIBLE_FLOW_FIELDS
+	// TheSuperHackers @performance The units of a large group moving to the same area walk down one shared
+	// cost field instead of each searching its own path. Units the field does not lead to their goal search as usual.
+	FlowField *flowField = getFlowField(obj, locomotorSet, from, rawTo);
+	if (flowField) {
+		Path *pat = followFlowField(*flowField, obj, locomotorSet.getValidSurfaces(), from, rawTo);
+		if (pat) {
+			m_queueStats.m_flowFieldPaths++;
+			return pat;
+		}
+	}
+#endif
+
 	m_zoneManager.clearPassableFlags();
+#if !RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+	// TheSuperHackers @performance Units ordered to the same area share the hierarchical path of the first unit
+	// and only path locally to join its corridor. A unit that cannot reach the goal inside the corridor computes its own.
+	if (useSharedCorridor(isHuman, locomotorSet.getValidSurfaces(), from, rawTo)) {
+		Path *pat = internalFindPath(obj, locomotorSet, from, rawTo);
+		if (pat!=nullptr) {
+			m_queueStats.m_sharedCorridorPaths++;
+			return pat;
+		}
+		m_zoneManager.clearPassableFlags();
+	}
+#endif
 	Path *hPat = findHierarchicalPath(isHuman, locomotorSet, from, rawTo, false);
 	if (hPat) {
 		deleteInstance(hPat);
+#if !RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+		addSharedCorridor(isHuman, locomotorSet.getValidSurfaces(), from, rawTo);
+#endif
 	}	else {
 		m_zoneManager.setAllPassable();
 	}
@@ -6240,6 +7074,492 @@ Path *Pathfinder::findPath( Object *obj, const LocomotorSet& locomotorSet, const
 
 	return nullptr;
 }
+
+#if !RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+/**
+ * Get the key a hierarchical path from one ground location to another is shared by.
+ * Returns false if the path cannot be shared.
+ */
+Bool Pathfinder::getSharedCorridorKey(Bool isHuman, LocomotorSurfaceTypeMask surfaces, const Coord3D *from, const Coord3D *to,
+	SharedCorridor &key, ICoord2D &startBlock)
+{
+	if (m_isMapReady == false) {
+		return false;
+	}
+
+	Coord3D clipFrom = *from;
+	Coord3D clipTo = *to;
+	clip(&clipFrom, &clipTo);
+
+	// Paths across bridges are rare enough to not bother.
+	if (TheTerrainLogic->getLayerForDestination(&clipFrom) != LAYER_GROUND ||
+			TheTerrainLogic->getLayerForDestination(&clipTo) != LAYER_GROUND) {
+		return false;
+	}
+
+	ICoord2D startNdx, goalNdx;
+	worldToCell(&clipFrom, &startNdx);
+	worldToCell(&clipTo, &goalNdx);
+	PathfindCell *startCell = getCell(LAYER_GROUND, startNdx.x, startNdx.y);
+	PathfindCell *goalCell = getCell(LAYER_GROUND, goalNdx.x, goalNdx.y);
+	if (!startCell || !goalCell) {
+		return false;
+	}
+
+	zoneStorageType zone = m_zoneManager.getEffectiveZone(surfaces, false, goalCell->getZone());
+	if (zone != m_zoneManager.getEffectiveZone(surfaces, false, startCell->getZone())) {
+		return false;
+	}
+
+	key.m_frame = TheGameLogic->getFrame();
+	key.m_zoneRevision = m_zoneManager.getZoneRevision();
+	key.m_surfaces = surfaces;
+	key.m_isHuman = isHuman;
+	key.m_zone = zone;
+	key.m_goalBlock.x = goalNdx.x/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	key.m_goalBlock.y = goalNdx.y/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	startBlock.x = startNdx.x/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	startBlock.y = startNdx.y/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	return true;
+}
+
+/**
+ * Mark the corridor of a recent hierarchical path to the same goal block passable, if the start
+ * is next to it.  Like buildHierarchicalPath, the blocks around the start are marked too, so the
+ * unit can path locally to join the corridor.
+ */
+Bool Pathfinder::useSharedCorridor(Bool isHuman, LocomotorSurfaceTypeMask surfaces, const Coord3D *from, const Coord3D *to)
+{
+	if (m_numSharedCorridors == 0) {
+		return false;
+	}
+
+	SharedCorridor key;
+	ICoord2D startBlock;
+	if (!getSharedCorridorKey(isHuman, surfaces, from, to, key, startBlock)) {
+		return false;
+	}
+
+	Int i;
+	for (i=0; i<m_numSharedCorridors; i++) {
+		const SharedCorridor &corridor = m_sharedCorridors[i];
+		if (key.m_frame - corridor.m_frame > SHARED_CORRIDOR_FRAMES ||
+				corridor.m_zoneRevision != key.m_zoneRevision ||
+				corridor.m_surfaces != key.m_surfaces ||
+				corridor.m_isHuman != key.m_isHuman ||
+				corridor.m_zone != key.m_zone ||
+				corridor.m_goalBlock.x != key.m_goalBlock.x ||
+				corridor.m_goalBlock.y != key.m_goalBlock.y) {
+			continue;
+		}
+
+		Int j;
+		for (j=0; j<corridor.m_numBlocks; j++) {
+			if (abs(corridor.m_blocks[j].x - startBlock.x) <= 1 && abs(corridor.m_blocks[j].y - startBlock.y) <= 1) {
+				break;
+			}
+		}
+		if (j == corridor.m_numBlocks) {
+			continue;
+		}
+
+		m_zoneManager.setPassableBlocks(corridor.m_blocks, corridor.m_numBlocks);
+
+		ICoord2D extent;
+		m_zoneManager.getExtent(extent);
+		Int x, y;
+		for (x=MAX(startBlock.x-1, 0); x<=MIN(startBlock.x+1, extent.x-1); x++) {
+			for (y=MAX(startBlock.y-1, 0); y<=MIN(startBlock.y+1, extent.y-1); y++) {
+				m_zoneManager.setPassable(x*PathfindZoneManager::ZONE_BLOCK_SIZE, y*PathfindZoneManager::ZONE_BLOCK_SIZE, true);
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Remember the blocks the last hierarchical path marked passable, so that later requests
+ * to the same goal block can share them.
+ */
+void Pathfinder::addSharedCorridor(Bool isHuman, LocomotorSurfaceTypeMask surfaces, const Coord3D *from, const Coord3D *to)
+{
+	SharedCorridor key;
+	ICoord2D startBlock;
+	if (!getSharedCorridorKey(isHuman, surfaces, from, to, key, startBlock)) {
+		return;
+	}
+
+	// Replace an older corridor to the same goal block, otherwise the oldest corridor.
+	Int i;
+	for (i=0; i<m_numSharedCorridors; i++) {
+		const SharedCorridor &corridor = m_sharedCorridors[i];
+		if (corridor.m_surfaces == key.m_surfaces &&
+				corridor.m_isHuman == key.m_isHuman &&
+				corridor.m_goalBlock.x == key.m_goalBlock.x &&
+				corridor.m_goalBlock.y == key.m_goalBlock.y) {
+			break;
+		}
+	}
+	if (i == m_numSharedCorridors) {
+		if (m_numSharedCorridors < MAX_SHARED_CORRIDORS) {
+			m_numSharedCorridors++;
+		}	else {
+			i = m_nextSharedCorridor;
+			m_nextSharedCorridor = (m_nextSharedCorridor+1) % MAX_SHARED_CORRIDORS;
+		}
+	}
+
+	SharedCorridor &corridor = m_sharedCorridors[i];
+	corridor.m_numBlocks = m_zoneManager.getPassableBlocks(corridor.m_blocks, MAX_CORRIDOR_BLOCKS);
+	if (corridor.m_numBlocks < 0) {
+		// Too long to remember. No start is next to an empty corridor.
+		corridor.m_numBlocks = 0;
+	}
+	corridor.m_frame = key.m_frame;
+	corridor.m_zoneRevision = key.m_zoneRevision;
+	corridor.m_surfaces = key.m_surfaces;
+	corridor.m_isHuman = key.m_isHuman;
+	corridor.m_zone = key.m_zone;
+	corridor.m_goalBlock = key.m_goalBlock;
+}
+#endif
+
+#if !RETAIL_COMPATIBLE_FLOW_FIELDS
+/**
+ * Get the flow field a unit moving to the given location shares with the other units of its group.
+ * The requests to an area are counted, and the field is only integrated once FlowFieldMinGroupSize
+ * units asked for a path there, so small groups keep searching their own paths.
+ * Returns null if the unit searches its own path.
+ */
+Pathfinder::FlowField *Pathfinder::getFlowField(const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to)
+{
+	const Int minGroupSize = TheAI->getAiData()->m_flowFieldMinGroupSize;
+	if (minGroupSize <= 0 || m_isMapReady == false || obj == nullptr || locomotorSet.isDownhillOnly()) {
+		return nullptr;
+	}
+
+	// The field would not know about the cells that changed since the zones were calculated.
+	if (m_zoneManager.hasDirtyBlocks()) {
+		return nullptr;
+	}
+
+	// The field only covers the ground of the logical map.
+	if (TheTerrainLogic->getLayerForDestination(from) != LAYER_GROUND ||
+			TheTerrainLogic->getLayerForDestination(to) != LAYER_GROUND) {
+		return nullptr;
+	}
+	ICoord2D startNdx, goalNdx;
+	worldToCell(from, &startNdx);
+	worldToCell(to, &goalNdx);
+	if (checkCellOutsideExtents(startNdx) || checkCellOutsideExtents(goalNdx)) {
+		return nullptr;
+	}
+	if (startNdx.x == goalNdx.x && startNdx.y == goalNdx.y) {
+		return nullptr;
+	}
+
+	Int radius;
+	Bool centerInCell;
+	getRadiusAndCenter(obj, radius, centerInCell);
+	const Bool isCrusher = obj->getCrusherLevel() > 0;
+	const LocomotorSurfaceTypeMask surfaces = locomotorSet.getValidSurfaces();
+	ICoord2D goalBlock;
+	goalBlock.x = goalNdx.x/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	goalBlock.y = goalNdx.y/PathfindZoneManager::ZONE_BLOCK_SIZE;
+	const UnsignedInt frame = TheGameLogic->getFrame();
+
+	FlowField *field = nullptr;
+	Int i;
+	for (i=0; i<MAX_FLOW_FIELDS; i++) {
+		FlowField &candidate = m_flowFields[i];
+		if (candidate.m_requests > 0 &&
+				candidate.m_surfaces == surfaces &&
+				candidate.m_isCrusher == isCrusher &&
+				candidate.m_radius == radius &&
+				candidate.m_goalBlock.x == goalBlock.x &&
+				candidate.m_goalBlock.y == goalBlock.y) {
+			field = &candidate;
+			break;
+		}
+	}
+
+	if (field && frame - field->m_frame > FLOW_FIELD_FRAMES) {
+		// The group that used it has arrived, this is a new group.
+		field->m_requests = 0;
+	}
+	if (field == nullptr) {
+		// Take a free slot, otherwise the oldest one.
+		for (i=0; i<MAX_FLOW_FIELDS; i++) {
+			if (m_flowFields[i].m_requests == 0 || frame - m_flowFields[i].m_frame > FLOW_FIELD_FRAMES) {
+				field = &m_flowFields[i];
+				break;
+			}
+		}
+		if (field == nullptr) {
+			field = &m_flowFields[m_nextFlowField];
+			m_nextFlowField = (m_nextFlowField+1) % MAX_FLOW_FIELDS;
+		}
+		field->m_requests = 0;
+	}
+	if (field->m_requests == 0) {
+		field->m_surfaces = surfaces;
+		field->m_isCrusher = isCrusher;
+		field->m_radius = radius;
+		field->m_goalBlock = goalBlock;
+		field->m_goalCell = goalNdx;
+		field->m_isIntegrated = false;
+	}
+
+	field->m_frame = frame;
+	field->m_requests++;
+	if (field->m_requests < minGroupSize) {
+		return nullptr;
+	}
+
+	// Scripts can move the active boundary, which changes the logical extent.
+	const Bool isSameExtent = field->m_extent.lo.x == m_logicalExtent.lo.x && field->m_extent.lo.y == m_logicalExtent.lo.y &&
+		field->m_extent.hi.x == m_logicalExtent.hi.x && field->m_extent.hi.y == m_logicalExtent.hi.y;
+	if (!field->m_isIntegrated || field->m_zoneRevision != m_zoneManager.getZoneRevision() || !isSameExtent) {
+		if (checkCellOutsideExtents(field->m_goalCell)) {
+			// The goal of the field is outside of the new extent.
+			field->m_requests = 0;
+			return nullptr;
+		}
+		integrateFlowField(*field);
+	}
+	return field;
+}
+
+/**
+ * Compute the cost to the goal cell of every ground cell in the logical map that the units of the
+ * field can stand on, with the step costs of internalFindPath.  Like the search, diagonal steps need
+ * one open side.  Units and their goals are not considered, the locomotion avoids them as usual.
+ */
+void Pathfinder::integrateFlowField(FlowField &field)
+{
+	field.m_extent = m_logicalExtent;
+	const Int width = m_logicalExtent.hi.x - m_logicalExtent.lo.x + 1;
+	const Int height = m_logicalExtent.hi.y - m_logicalExtent.lo.y + 1;
+	const Int numCells = width*height;
+
+	// Cells the whole footprint of the unit fits on, eroded by rows and then by columns.
+	std::vector<UnsignedByte> valid(numCells);
+	std::vector<UnsignedByte> rowValid(numCells);
+	Int x, y, i;
+	for (y=0; y<height; y++) {
+		for (x=0; x<width; x++) {
+			PathfindCell *cell = getCell(LAYER_GROUND, x + m_logicalExtent.lo.x, y + m_logicalExtent.lo.y);
+			valid[y*width + x] = cell && validMovementPosition(field.m_isCrusher, field.m_surfaces, cell);
+		}
+	}
+	if (field.m_radius > 0) {
+		for (y=0; y<height; y++) {
+			for (x=0; x<width; x++) {
+				UnsignedByte fits = 1;
+				for (i=x-field.m_radius; fits && i<=x+field.m_radius; i++) {
+					fits = i>=0 && i<width && valid[y*width + i];
+				}
+				rowValid[y*width + x] = fits;
+			}
+		}
+		for (y=0; y<height; y++) {
+			for (x=0; x<width; x++) {
+				UnsignedByte fits = 1;
+				for (i=y-field.m_radius; fits && i<=y+field.m_radius; i++) {
+					fits = i>=0 && i<height && rowValid[i*width + x];
+				}
+				valid[y*width + x] = fits;
+			}
+		}
+	}
+
+	field.m_costs.assign(numCells, FLOW_FIELD_UNREACHABLE);
+
+	// Dijkstra from the goal cell.  Cells with equal cost are settled in index order.
+	typedef std::pair<UnsignedInt, Int> CostAndIndex;
+	std::vector<CostAndIndex> open;
+	const Int goalIndex = (field.m_goalCell.y - m_logicalExtent.lo.y)*width + field.m_goalCell.x - m_logicalExtent.lo.x;
+	field.m_costs[goalIndex] = 0;
+	open.push_back(CostAndIndex(0, goalIndex));
+
+	static const ICoord2D delta[] =
+	{
+		{ 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 },
+		{ 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 }
+	};
+	const Int numNeighbors = 8;
+	const Int firstDiagonal = 4;
+	const Int adjacent[5] = {0, 1, 2, 3, 0};
+
+	Int cellCount = 0;
+	while (!open.empty()) {
+		std::pop_heap(open.begin(), open.end(), std::greater<CostAndIndex>());
+		const CostAndIndex current = open.back();
+		open.pop_back();
+		if (current.first > field.m_costs[current.second]) {
+			continue;
+		}
+		cellCount++;
+
+		const Int cellX = current.second % width;
+		const Int cellY = current.second / width;
+		PathfindCell *cell = getCell(LAYER_GROUND, cellX + m_logicalExtent.lo.x, cellY + m_logicalExtent.lo.y);
+		// Units step from the neighbor into this cell.
+		const UnsignedInt enterCost = cell && cell->getPinched() ? COST_ORTHOGONAL : 0;
+
+		Bool neighborFlags[8] = { 0 };
+		for (i=0; i<numNeighbors; i++) {
+			const Int newX = cellX + delta[i].x;
+			const Int newY = cellY + delta[i].y;
+			if (newX < 0 || newX >= width || newY < 0 || newY >= height) {
+				continue;
+			}
+			const Int newIndex = newY*width + newX;
+			if (!valid[newIndex]) {
+				continue;
+			}
+			if (i>=firstDiagonal) {
+				// make sure one of the adjacent sides is open.
+				if (!neighborFlags[adjacent[i-4]] && !neighborFlags[adjacent[i-3]]) {
+					continue;
+				}
+			}	else {
+				neighborFlags[i] = true;
+			}
+
+			const UnsignedInt newCost = current.first + (i<firstDiagonal ? COST_ORTHOGONAL : COST_DIAGONAL) + enterCost;
+			if (newCost >= FLOW_FIELD_UNREACHABLE) {
+				// Too far for the costs to hold, the units search their own paths from there.
+				continue;
+			}
+			if (newCost < field.m_costs[newIndex]) {
+				field.m_costs[newIndex] = (UnsignedShort)newCost;
+				open.push_back(CostAndIndex(newCost, newIndex));
+				std::push_heap(open.begin(), open.end(), std::greater<CostAndIndex>());
+			}
+		}
+	}
+
+	// Count the integration against the cells the pathfind queue may examine this frame.
+	m_cumulativeCellsAllocated += cellCount;
+	field.m_zoneRevision = m_zoneManager.getZoneRevision();
+	field.m_isIntegrated = true;
+}
+
+/**
+ * Build a path from the start down the cost field to its goal, and from there to the unit's own
+ * goal in the same zone block.  Returns null if the field does not lead the unit to its goal, so
+ * the unit searches its own path.
+ */
+Path *Pathfinder::followFlowField(const FlowField &field, const Object *obj, LocomotorSurfaceTypeMask surfaces, const Coord3D *from, const Coord3D *to)
+{
+	const IRegion2D &extent = field.m_extent;
+	const Int width = extent.hi.x - extent.lo.x + 1;
+	const Int height = extent.hi.y - extent.lo.y + 1;
+
+	ICoord2D cellNdx, goalNdx;
+	worldToCell(from, &cellNdx);
+	worldToCell(to, &goalNdx);
+	Int cellX = cellNdx.x - extent.lo.x;
+	Int cellY = cellNdx.y - extent.lo.y;
+	const Int goalX = goalNdx.x - extent.lo.x;
+	const Int goalY = goalNdx.y - extent.lo.y;
+
+	if (cellX < 0 || cellX >= width || cellY < 0 || cellY >= height || (size_t)(cellY*width + cellX) >= field.m_costs.size()) {
+		return nullptr;
+	}
+	UnsignedShort cost = field.m_costs[cellY*width + cellX];
+	if (cost == FLOW_FIELD_UNREACHABLE) {
+		return nullptr;
+	}
+
+	Int radius;
+	Bool centerInCell;
+	getRadiusAndCenter(obj, radius, centerInCell);
+
+	static const ICoord2D delta[] =
+	{
+		{ 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 },
+		{ 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 }
+	};
+	const Int numNeighbors = 8;
+	const Int firstDiagonal = 4;
+	const Int adjacent[5] = {0, 1, 2, 3, 0};
+
+	Path *path = newInstance(Path);
+	path->appendNode(from, LAYER_GROUND);
+	Bool prevIsCliff = getCell(LAYER_GROUND, cellNdx.x, cellNdx.y)->getType() == PathfindCell::CELL_CLIFF;
+	Coord3D pos = *from;
+
+	// The costs strictly decrease, so this ends at the goal of the field.
+	while (cost != 0 && (cellX != goalX || cellY != goalY)) {
+		Int bestX = cellX;
+		Int bestY = cellY;
+		UnsignedShort bestCost = cost;
+		Bool neighborFlags[8] = { 0 };
+		Int i;
+		for (i=0; i<numNeighbors; i++) {
+			const Int newX = cellX + delta[i].x;
+			const Int newY = cellY + delta[i].y;
+			if (newX < 0 || newX >= width || newY < 0 || newY >= height) {
+				continue;
+			}
+			const UnsignedShort newCost = field.m_costs[newY*width + newX];
+			if (newCost == FLOW_FIELD_UNREACHABLE) {
+				continue;
+			}
+			if (i>=firstDiagonal) {
+				if (!neighborFlags[adjacent[i-4]] && !neighborFlags[adjacent[i-3]]) {
+					continue;
+				}
+			}	else {
+				neighborFlags[i] = true;
+			}
+			if (newCost < bestCost) {
+				bestCost = newCost;
+				bestX = newX;
+				bestY = newY;
+			}
+		}
+		if (bestCost == cost) {
+			// Stuck in a dead end of the eroded field.
+			deleteInstance(path);
+			return nullptr;
+		}
+
+		cellX = bestX;
+		cellY = bestY;
+		cost = bestCost;
+		adjustCoordToCell(cellX + extent.lo.x, cellY + extent.lo.y, centerInCell, pos, LAYER_GROUND);
+		path->appendNode(&pos, LAYER_GROUND);
+
+		// Like prependCells, don't optimize across the edges of cliffs.
+		const Bool isCliff = getCell(LAYER_GROUND, cellX + extent.lo.x, cellY + extent.lo.y)->getType() == PathfindCell::CELL_CLIFF;
+		if (isCliff != prevIsCliff) {
+			path->getLastNode()->setCanOptimize(false);
+			if (path->getLastNode()->getPrevious()) {
+				path->getLastNode()->getPrevious()->setCanOptimize(false);
+			}
+		}
+		prevIsCliff = isCliff;
+	}
+
+	if (cellX != goalX || cellY != goalY) {
+		// Walk straight from the goal of the field to the unit's own goal.
+		Coord3D goalPos;
+		adjustCoordToCell(goalNdx.x, goalNdx.y, centerInCell, goalPos, LAYER_GROUND);
+		if (!isLinePassable(obj, surfaces, LAYER_GROUND, pos, goalPos, false, false)) {
+			deleteInstance(path);
+			return nullptr;
+		}
+		path->appendNode(&goalPos, LAYER_GROUND);
+	}
+
+	path->optimize(obj, surfaces, false);
+	return path;
+}
+#endif
 /**
  * Find a short, valid path between given locations.
  * Uses A* algorithm.
@@ -9715,6 +11035,7 @@ void Pathfinder::changeBridgeState( PathfindLayerEnum layer, Bool repaired)
 	if (m_layers[layer].isUnused()) return;
 	if (m_layers[layer].setDestroyed(!repaired)) {
 		m_zoneManager.markZonesDirty( repaired );
+		m_zoneManager.markAllBlocksDirty();
 	}
 }
 
@@ -11211,3 +12532,62 @@ void Pathfinder::loadPostProcess( void )
 {
 
 }
+
+//-----------------------------------------------------------------------------
+/**
+	TheSuperHackers @bugfix The save game does not contain the pathfinder, which rebuilds its map from
+	the objects on load. A replay checkpoint must continue exactly like the recorded game, so it keeps
+	the pending requests and the shared paths separately. Must be loaded after the save game.
+*/
+void Pathfinder::xferCheckpoint( Xfer *xfer )
+{
+	// version
+	XferVersion currentVersion = 1;
+	XferVersion version = currentVersion;
+	xfer->xferVersion( &version, currentVersion );
+
+	xfer->xferBool( &m_isTunneling );
+	xfer->xferObjectID( &m_ignoreObstacleID );
+	xfer->xferInt( &m_cumulativeCellsAllocated );
+
+	xfer->xferUser( m_queuedPathfindRequests, sizeof(m_queuedPathfindRequests) );
+	xfer->xferUser( m_queuedPathfindFrames, sizeof(m_queuedPathfindFrames) );
+	xfer->xferUser( m_queuedPathfindFromPlayer, sizeof(m_queuedPathfindFromPlayer) );
+	xfer->xferInt( &m_queuedPlayerRequests );
+	xfer->xferInt( &m_queuePRHead );
+	xfer->xferInt( &m_queuePRTail );
+
+	m_zoneManager.xferCheckpoint( xfer );
+
+#if !RETAIL_COMPATIBLE_PATHFIND_CORRIDORS
+	xfer->xferUser( m_sharedCorridors, sizeof(m_sharedCorridors) );
+	xfer->xferInt( &m_numSharedCorridors );
+	xfer->xferInt( &m_nextSharedCorridor );
+#endif
+
+#if !RETAIL_COMPATIBLE_FLOW_FIELDS
+	for (Int i=0; i<MAX_FLOW_FIELDS; i++) {
+		FlowField &field = m_flowFields[i];
+		xfer->xferUnsignedInt( &field.m_frame );
+		xfer->xferUnsignedInt( &field.m_zoneRevision );
+		xfer->xferUser( &field.m_surfaces, sizeof(field.m_surfaces) );
+		xfer->xferBool( &field.m_isCrusher );
+		xfer->xferInt( &field.m_radius );
+		xfer->xferICoord2D( &field.m_goalBlock );
+		xfer->xferICoord2D( &field.m_goalCell );
+		xfer->xferInt( &field.m_requests );
+		xfer->xferBool( &field.m_isIntegrated );
+		xfer->xferIRegion2D( &field.m_extent );
+
+		UnsignedInt numCosts = (UnsignedInt)field.m_costs.size();
+		xfer->xferUnsignedInt( &numCosts );
+		if (xfer->getXferMode() == XFER_LOAD) {
+			field.m_costs.resize(numCosts);
+		}
+		if (numCosts > 0) {
+			xfer->xferUser( &field.m_costs[0], numCosts*sizeof(UnsignedShort) );
+		}
+	}
+	xfer->xferInt( &m_nextFlowField );
+#endif
+}
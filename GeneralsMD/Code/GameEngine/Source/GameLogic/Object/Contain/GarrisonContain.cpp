@@ -194,7 +194,8 @@ void GarrisonContain::putObjectAtGarrisonPoint( Object *obj,
 	//
 	static const ThingTemplate *muzzle = TheThingFactory->findTemplate( "GarrisonGun" );
 	DEBUG_ASSERTCRASH( muzzle, ("Warning, Object 'GarrisonGun' not found and is need for Garrison gun effects") );
-	if( muzzle && isEnclosingContainerFor( obj ) )// If we are showing the contained, we need no gun barrel drawable added
+	// TheSuperHackers @performance The gun barrel is only for show, so headless mode does not create it.
+	if( muzzle && isEnclosingContainerFor( obj ) && !TheGlobalData->isLogicOnly() )// If we are showing the contained, we need no gun barrel drawable added
 	{
 		Drawable *draw = TheThingFactory->newDrawable( muzzle );
 		if( draw )
@@ -977,7 +977,8 @@ protected:
 			if (tmp)
 			{
 				ParticleSystem *sys = TheParticleSystemManager->createParticleSystem(tmp);
-				sys->attachToObject(obj);
+				if (sys)
+					sys->attachToObject(obj);
 			}
 		}
 
@@ -2312,7 +2312,8 @@ void JetAIUpdate::buildLockonDrawableIfNecessary()
 		return;
 
 	const JetAIUpdateModuleData* d = getJetAIUpdateModuleData();
-	if (d->m_lockonCursor.isNotEmpty() && m_lockonDrawable == nullptr)
+	// TheSuperHackers @performance The lockon cursor is only for show, so headless mode does not create it.
+	if (d->m_lockonCursor.isNotEmpty() && m_lockonDrawable == nullptr && !TheGlobalData->isLogicOnly())
 	{
 		const ThingTemplate* tt = TheThingFactory->findTemplate(d->m_lockonCursor);
 		if (tt)
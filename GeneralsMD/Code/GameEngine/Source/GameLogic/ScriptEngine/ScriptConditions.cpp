@@ -205,7 +205,7 @@ void ScriptConditions::objectTypesFromParam(Parameter *pTypeParm, ObjectTypes *o
 		return;
 	}
 
-	ObjectTypes *types = TheScriptEngine->getObjectTypes(str);
+	ObjectTypes *types = TheScriptEngine->getObjectTypes(pTypeParm);
 	if (!types) {
 		(*outObjectTypes).addObjectType(str);
 	} else {
@@ -213,6 +213,54 @@ void ScriptConditions::objectTypesFromParam(Parameter *pTypeParm, ObjectTypes *o
 	}
 }
 
+//-------------------------------------------------------------------------------------------------
+/** The result of these conditions only changes when an object joins or leaves a team, dies or is
+	* destroyed, or a team is created, activated or deleted, see ScriptEngine::notifyOfObjectRosterChange.
+	* The player or team must not depend on the script that evaluates the condition: a side is fixed
+	* once playerFromParam cached its mask (never for the enemy player), and a team must be a singleton,
+	* so that THIS_TEAM or the calling team cannot pick another instance. */
+//-------------------------------------------------------------------------------------------------
+Bool ScriptConditions::isObjectRosterCondition(Condition *pCondition)
+{
+	switch (pCondition->getConditionType()) {
+		case Condition::PLAYER_ALL_DESTROYED:
+		case Condition::PLAYER_ALL_BUILDFACILITIES_DESTROYED:
+		case Condition::PLAYER_HAS_N_OR_FEWER_BUILDINGS:
+		case Condition::PLAYER_HAS_N_OR_FEWER_FACTION_BUILDINGS:
+			return pCondition->getParameter(0)->getInt() != 0;
+		case Condition::TEAM_DESTROYED:
+		case Condition::TEAM_HAS_UNITS:
+		{
+			const Parameter *pTeamParm = pCondition->getParameter(0);
+			const TeamPrototype *pProto = pTeamParm->getBoundTeamPrototype();
+			return pProto && pProto->getIsSingleton() && pTeamParm->getString() != TEAM_THE_PLAYER;
+		}
+		default:
+			return false;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ScriptConditions::isObjectRosterResultValid(Condition *pCondition)
+{
+	if (pCondition->getCustomData() == 0) {
+		return false;
+	}
+	if ((UnsignedInt)pCondition->getCustomFrame() != TheScriptEngine->getObjectRosterStamp()) {
+		return false;
+	}
+	return isObjectRosterCondition(pCondition);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ScriptConditions::cacheObjectRosterResult(Condition *pCondition, Bool result)
+{
+	if (isObjectRosterCondition(pCondition)) {
+		pCondition->setCustomData(result ? 1 : -1);
+		pCondition->setCustomFrame((Int)TheScriptEngine->getObjectRosterStamp());
+	}
+	return result;
+}
 
 //-------------------------------------------------------------------------------------------------
 /** evaluateAllDestroyed */
@@ -243,7 +291,7 @@ Bool ScriptConditions::evaluateAllBuildFacilitiesDestroyed(Parameter *pSideParm
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateIsDestroyed(Parameter *pTeamParm)
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	// The team is the team based on the name, and the calling team (if any) and the team that
 	// is being considered for the condition.  jba. :)
 	if (theTeam) {
@@ -393,11 +441,11 @@ Bool ScriptConditions::evaluateHasUnits(Parameter *pTeamParm)
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamInsideAreaPartially(Parameter *pTeamParm, Parameter *pTriggerAreaParm, Parameter *pTypeParm)
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	// The team is the team based on the name, and the calling team (if any) and the team that
 	// is being considered for the condition.  jba. :)
 	AsciiString triggerName = pTriggerAreaParm->getString();
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerAreaParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerAreaParm);
 
 	if (pTrig == nullptr) return false;
 	if (theTeam) {
@@ -419,7 +467,7 @@ Bool ScriptConditions::evaluateNamedInsideArea(Parameter *pUnitParm, Parameter *
 	}
 
 	AsciiString triggerName = pTriggerAreaParm->getString();
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerAreaParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerAreaParm);
 	if (pTrig == nullptr) return false;
 	if (theObj) {
 		Coord3D pCoord = *theObj->getPosition();
@@ -436,7 +484,7 @@ Bool ScriptConditions::evaluateNamedInsideArea(Parameter *pUnitParm, Parameter *
 Bool ScriptConditions::evaluatePlayerHasUnitTypeInArea(Condition *pCondition, Parameter *pPlayerParm, Parameter *pComparisonParm, Parameter *pCountParm, Parameter *pTypeParm, Parameter *pTriggerParm )
 {
 	AsciiString triggerName = pTriggerParm->getString();
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 	if (pTrig == nullptr) return false;
 
 	Player* pPlayer = playerFromParam(pPlayerParm);
@@ -529,7 +577,7 @@ Bool ScriptConditions::evaluatePlayerHasUnitTypeInArea(Condition *pCondition, Pa
 Bool ScriptConditions::evaluatePlayerHasUnitKindInArea(Condition *pCondition, Parameter *pPlayerParm, Parameter *pComparisonParm, Parameter *pCountParm, Parameter *pKindParm, Parameter *pTriggerParm )
 {
 	AsciiString triggerName = pTriggerParm->getString();
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 	if (pTrig == nullptr) return false;
 
 	KindOfType kind = (KindOfType)pKindParm->getInt();
@@ -609,7 +657,7 @@ Bool ScriptConditions::evaluatePlayerHasUnitKindInArea(Condition *pCondition, Pa
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamStateIs(Parameter *pTeamParm, Parameter *pStateParm )
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	// The team is the team based on the name, and the calling team (if any) and the team that
 	// is being considered for the condition.  jba. :)
 	AsciiString stateName = pStateParm->getString();
@@ -625,7 +673,7 @@ Bool ScriptConditions::evaluateTeamStateIs(Parameter *pTeamParm, Parameter *pSta
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamStateIsNot(Parameter *pTeamParm, Parameter *pStateParm )
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	// The team is the team based on the name, and the calling team (if any) and the team that
 	// is being considered for the condition.  jba. :)
 	AsciiString stateName = pStateParm->getString();
@@ -649,11 +697,11 @@ Bool ScriptConditions::evaluateNamedOutsideArea(Parameter *pUnitParm, Parameter
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamInsideAreaEntirely(Parameter *pTeamParm, Parameter *pTriggerParm, Parameter *pTypeParm)
 {// This is actually TeamInside(...)
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	// The team is the team based on the name, and the calling team (if any) and the team that
 	// is being considered for the condition.  jba. :)
 	AsciiString triggerName = pTriggerParm->getString();
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 
 	if (pTrig == nullptr)
 		return false;
@@ -730,7 +778,7 @@ Bool ScriptConditions::evaluateNamedAttackedByType(Parameter *pUnitParm, Paramet
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamAttackedByType(Parameter *pTeamParm, Parameter *pTypeParm)
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team *theTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (!theTeam) {
 		return FALSE;
 	}
@@ -832,7 +880,7 @@ Bool ScriptConditions::evaluateNamedAttackedByPlayer(Parameter *pUnitParm, Param
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamAttackedByPlayer(Parameter *pTeamParm, Parameter *pPlayerParm)
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team *theTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (!theTeam) {
 		return false;
 	}
@@ -885,7 +933,10 @@ Bool ScriptConditions::evaluateBuiltByPlayer(Condition *pCondition, Parameter* p
 		return false;
 	}
 
-	const ThingTemplate* pTemplate = TheThingFactory->findTemplate(pTypeParm->getString());
+	const ThingTemplate* pTemplate = pTypeParm->getBoundThingTemplate();
+	if (!pTemplate) {
+		pTemplate = TheThingFactory->findTemplate(pTypeParm->getString());
+	}
 	if (!pTemplate) {
 		return false;
 	}
@@ -927,7 +978,7 @@ Bool ScriptConditions::evaluateNamedCreated(Parameter* pUnitParm)
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamCreated(Parameter* pTeamParm)
 {
-	Team *pTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team *pTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (pTeam) {
 		return pTeam->isCreated();
 	}
@@ -1183,7 +1234,7 @@ Bool ScriptConditions::evaluateNamedDiscovered(Parameter *pItemParm, Parameter*
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamDiscovered(Parameter *pTeamParm, Parameter *pPlayerParm)
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	if (!theTeam) {
 		return false;
 	}
@@ -1260,7 +1311,7 @@ Bool ScriptConditions::evaluateTeamOwnedByPlayer(Parameter *pTeamParm, Parameter
 		return false;
 	}
 
-	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (!pTeam) {
 		return false;
 	}
@@ -1347,7 +1398,7 @@ Bool ScriptConditions::evaluateNamedReachedWaypointsEnd(Parameter *pUnitParm, Pa
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamReachedWaypointsEnd(Parameter *pTeamParm, Parameter* pWaypointPathParm)
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	if (!theTeam) {
 		return false;
 	}
@@ -1642,7 +1693,7 @@ Bool ScriptConditions::evaluateNamedEnteredArea(Parameter *pUnitParm, Parameter
 		return false;
 	}
 
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 
 	if (!pTrig) {
 		return false;
@@ -1661,7 +1712,7 @@ Bool ScriptConditions::evaluateNamedExitedArea(Parameter *pUnitParm, Parameter *
 		return false;
 	}
 
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 
 	if (!pTrig) {
 		return false;
@@ -1675,12 +1726,12 @@ Bool ScriptConditions::evaluateNamedExitedArea(Parameter *pUnitParm, Parameter *
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamEnteredAreaEntirely(Parameter *pTeamParm, Parameter *pTriggerParm, Parameter *pTypeParm)
 {
-	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (!pTeam) {
 		return false;
 	}
 
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 
 	if (pTrig) {
 		return pTeam->didAllEnter(pTrig, (UnsignedInt)pTypeParm->getInt());
@@ -1694,12 +1745,12 @@ Bool ScriptConditions::evaluateTeamEnteredAreaEntirely(Parameter *pTeamParm, Par
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamEnteredAreaPartially(Parameter *pTeamParm, Parameter *pTriggerParm, Parameter *pTypeParm)
 {
-	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (!pTeam) {
 		return false;
 	}
 
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 
 	if (pTrig) {
 		return pTeam->didPartialEnter(pTrig, (UnsignedInt)pTypeParm->getInt());
@@ -1713,12 +1764,12 @@ Bool ScriptConditions::evaluateTeamEnteredAreaPartially(Parameter *pTeamParm, Pa
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamExitedAreaEntirely(Parameter *pTeamParm, Parameter *pTriggerParm, Parameter *pTypeParm)
 {
-	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (!pTeam) {
 		return false;
 	}
 
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 
 	if (!pTrig) {
 		return false;
@@ -1732,12 +1783,12 @@ Bool ScriptConditions::evaluateTeamExitedAreaEntirely(Parameter *pTeamParm, Para
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamExitedAreaPartially(Parameter *pTeamParm, Parameter *pTriggerParm, Parameter *pTypeParm)
 {
-	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (!pTeam) {
 		return false;
 	}
 
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 
 	if (!pTrig) {
 		return false;
@@ -2013,7 +2064,7 @@ Bool ScriptConditions::evaluateUnitHasEmptied(Parameter *pUnitParm)
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamIsContained(Parameter *pTeamParm, Bool allContained)
 {
-	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm->getString());
+	Team* pTeam = TheScriptEngine->getTeamNamed(pTeamParm);
 	if (!pTeam) {
 		return false;
 	}
@@ -2069,7 +2120,7 @@ Bool ScriptConditions::evaluateUnitHasObjectStatus(Parameter *pUnitParm, Paramet
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateTeamHasObjectStatus(Parameter *pTeamParm, Parameter *pObjectStatus, Bool entireTeam)
 {
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	if (!theTeam) {
 		return false;
 	}
@@ -2113,7 +2164,7 @@ Bool ScriptConditions::evaluateSkirmishValueInArea(Condition *pCondition, Parame
 	}
 
 	AsciiString triggerName = pTriggerParm->getString();
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 
 	if (!pTrig) {
 		return false;
@@ -2209,7 +2260,7 @@ Bool ScriptConditions::evaluateSkirmishSuppliesWithinDistancePerimeter(Parameter
 		return false;
 	}
 
-	PolygonTrigger *trigger = TheScriptEngine->getQualifiedTriggerAreaByName(pLocationParm->getString());
+	PolygonTrigger *trigger = TheScriptEngine->getQualifiedTriggerArea(pLocationParm);
 	if (!trigger) {
 		return false;
 	}
@@ -2260,7 +2311,7 @@ Bool ScriptConditions::evaluateSkirmishPlayerTechBuildingWithinDistancePerimeter
 	if (pCondition->getCustomData()==1) return true;
 	if (pCondition->getCustomData()==-1) return false;
 
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pLocationParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pLocationParm);
 	if (!pTrig) {
 		return false;
 	}
@@ -2289,7 +2340,7 @@ Bool ScriptConditions::evaluateSkirmishPlayerTechBuildingWithinDistancePerimeter
 Bool ScriptConditions::evaluateSkirmishCommandButtonIsReady( Parameter * /* pSkirmishPlayerParm */, Parameter *pTeamParm, Parameter *pCommandButtonParm, Bool allReady )
 {
 	// In this one case, the pSkirmishPlayerParm isn't used.
-	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm->getString() );
+	Team *theTeam = TheScriptEngine->getTeamNamed( pTeamParm );
 	if (!theTeam) {
 		return false;
 	}
@@ -2484,7 +2535,7 @@ Bool ScriptConditions::evaluateSkirmishPlayerHasComparisonCapturedUnits(Paramete
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateSkirmishNamedAreaExists(Parameter *, Parameter *pTriggerParm)
 {
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 	return (pTrig != nullptr);
 }
 
@@ -2492,7 +2543,7 @@ Bool ScriptConditions::evaluateSkirmishNamedAreaExists(Parameter *, Parameter *p
 Bool ScriptConditions::evaluateSkirmishPlayerHasUnitsInArea(Condition *pCondition, Parameter *pSkirmishPlayerParm, Parameter *pTriggerParm )
 {
 	AsciiString triggerName = pTriggerParm->getString();
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 	if (pTrig == nullptr) return false;
 
 	Player* pPlayer = playerFromParam(pSkirmishPlayerParm);
@@ -2632,7 +2683,7 @@ Bool ScriptConditions::evaluateSkirmishPlayerIsOutsideArea(Condition *pCondition
 		return FALSE;
 	}
 
-	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerAreaByName(pTriggerParm->getString());
+	PolygonTrigger *pTrig = TheScriptEngine->getQualifiedTriggerArea(pTriggerParm);
 	if (!pTrig) {
 		return FALSE;
 	}
@@ -2723,20 +2774,36 @@ Bool ScriptConditions::evaluatePlayerLostObjectType(Parameter *pPlayerParm, Para
 //-------------------------------------------------------------------------------------------------
 Bool ScriptConditions::evaluateCondition( Condition *pCondition )
 {
+	// TheSuperHackers @performance Conditions that only look at which objects a player or team has
+	// keep their result until the object roster changes, instead of walking the team members every frame.
+	if (isObjectRosterResultValid(pCondition)) {
+		Bool result = (pCondition->getCustomData() == 1);
+#if defined(RTS_DEBUG)
+		if (TheGlobalData->m_auditScriptConditions) {
+			pCondition->setCustomData(0);
+			Bool evaluated = evaluateCondition(pCondition);
+			DEBUG_ASSERTCRASH(evaluated == result, ("Script condition '%s' changed without an object roster change",
+				pCondition->getUiText().str()));
+			return evaluated;
+		}
+#endif
+		return result;
+	}
+
 	switch (pCondition->getConditionType()) {
 		default:
 			DEBUG_CRASH(("Unknown ScriptCondition type %d", pCondition->getConditionType()));
 			return false;
 		case Condition::PLAYER_ALL_DESTROYED:
-			return evaluateAllDestroyed(pCondition->getParameter(0));
+			return cacheObjectRosterResult(pCondition, evaluateAllDestroyed(pCondition->getParameter(0)));
 		case Condition::PLAYER_ALL_BUILDFACILITIES_DESTROYED:
-			return evaluateAllBuildFacilitiesDestroyed(pCondition->getParameter(0));
+			return cacheObjectRosterResult(pCondition, evaluateAllBuildFacilitiesDestroyed(pCondition->getParameter(0)));
 		case Condition::TEAM_INSIDE_AREA_PARTIALLY:
 			return evaluateTeamInsideAreaPartially(pCondition->getParameter(0), pCondition->getParameter(1), pCondition->getParameter(2));
 		case Condition::NAMED_INSIDE_AREA:
 			return evaluateNamedInsideArea(pCondition->getParameter(0), pCondition->getParameter(1));
 		case Condition::TEAM_DESTROYED:
-			return evaluateIsDestroyed(pCondition->getParameter(0));
+			return cacheObjectRosterResult(pCondition, evaluateIsDestroyed(pCondition->getParameter(0)));
 		case Condition::NAMED_DESTROYED:
 			return evaluateNamedUnitDestroyed(pCondition->getParameter(0));
 		case Condition::NAMED_DYING:
@@ -2746,7 +2813,7 @@ Bool ScriptConditions::evaluateCondition( Condition *pCondition )
 		case Condition::NAMED_NOT_DESTROYED:
 			return evaluateNamedUnitExists(pCondition->getParameter(0));
 		case Condition::TEAM_HAS_UNITS:
-			return evaluateHasUnits(pCondition->getParameter(0));
+			return cacheObjectRosterResult(pCondition, evaluateHasUnits(pCondition->getParameter(0)));
 		case Condition::CAMERA_MOVEMENT_FINISHED:
 			return TheTacticalView->isCameraMovementFinished();
 		case Condition::TEAM_STATE_IS:
@@ -2807,9 +2874,9 @@ Bool ScriptConditions::evaluateCondition( Condition *pCondition )
 		case Condition::TEAM_OWNED_BY_PLAYER:
 			return evaluateTeamOwnedByPlayer(pCondition->getParameter(0), pCondition->getParameter(1));
 		case Condition::PLAYER_HAS_N_OR_FEWER_BUILDINGS:
-			return evaluatePlayerHasNOrFewerBuildings(pCondition->getParameter(1), pCondition->getParameter(0));
+			return cacheObjectRosterResult(pCondition, evaluatePlayerHasNOrFewerBuildings(pCondition->getParameter(1), pCondition->getParameter(0)));
 		case Condition::PLAYER_HAS_N_OR_FEWER_FACTION_BUILDINGS:
-			return evaluatePlayerHasNOrFewerFactionBuildings(pCondition->getParameter(1), pCondition->getParameter(0));
+			return cacheObjectRosterResult(pCondition, evaluatePlayerHasNOrFewerFactionBuildings(pCondition->getParameter(1), pCondition->getParameter(0)));
 		case Condition::PLAYER_HAS_POWER:
 			return evaluatePlayerHasPower(pCondition->getParameter(0));
 		case Condition::PLAYER_HAS_NO_POWER:
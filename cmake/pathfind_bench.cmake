@@ -0,0 +1,68 @@
+# Script for the pathfind_bench target, run with cmake -P.
+#
+# Benchmarks the pathfinder headless on every map of MAPS and writes the results of each map to
+# RESULT_DIR/<map>.csv. If BASELINE_DIR is set, the game compares the results with the file of the same
+# name in it and the script fails when a query finds other paths or regressed.
+#
+# GAME_EXE        Game executable. The game data must be next to it.
+# MAPS            List of maps, for example "Maps/Tournament Desert/Tournament Desert.map".
+# RESULT_DIR      Folder for the CSV files of the results.
+# BASELINE_DIR    Optional folder with the CSV files of an earlier run.
+# QUERIES         Optional number of queries of every type and locomotor type.
+# SEED            Optional seed of the query positions. Only results with the same seed and queries are comparable.
+# TOLERANCE       Optional regression in percent that the comparison tolerates.
+# EXTRA_ARGS      Optional additional command line arguments of the game.
+
+foreach(var GAME_EXE MAPS RESULT_DIR)
+    if(NOT ${var})
+        message(FATAL_ERROR "pathfind_bench: ${var} is not set.")
+    endif()
+endforeach()
+
+file(MAKE_DIRECTORY "${RESULT_DIR}")
+get_filename_component(game_dir "${GAME_EXE}" DIRECTORY)
+set(failed_maps "")
+
+foreach(map IN LISTS MAPS)
+    get_filename_component(map_name "${map}" NAME_WE)
+    set(result_file "${RESULT_DIR}/${map_name}.csv")
+
+    set(bench_args -headless -pathfindBench "${map}" -pathfindBenchResults "${result_file}")
+    if(QUERIES)
+        list(APPEND bench_args -pathfindBenchQueries "${QUERIES}")
+    endif()
+    if(SEED)
+        list(APPEND bench_args -pathfindBenchSeed "${SEED}")
+    endif()
+    if(BASELINE_DIR)
+        list(APPEND bench_args -pathfindBenchBaseline "${BASELINE_DIR}/${map_name}.csv")
+    endif()
+    if(TOLERANCE)
+        list(APPEND bench_args -replayBenchTolerance "${TOLERANCE}")
+    endif()
+    if(EXTRA_ARGS)
+        separate_arguments(extra_args NATIVE_COMMAND "${EXTRA_ARGS}")
+        list(APPEND bench_args ${extra_args})
+    endif()
+
+    # The game is a gui application, so its console output must be captured.
+    string(REPLACE ";" " " bench_args_text "${bench_args}")
+    message(STATUS "Run ${GAME_EXE} ${bench_args_text}")
+    execute_process(
+        COMMAND "${GAME_EXE}" ${bench_args}
+        WORKING_DIRECTORY "${game_dir}"
+        OUTPUT_VARIABLE bench_output
+        ERROR_VARIABLE bench_output
+        RESULT_VARIABLE bench_result
+    )
+    message("${bench_output}")
+
+    if(NOT bench_result EQUAL 0)
+        list(APPEND failed_maps "${map_name}")
+    endif()
+endforeach()
+
+if(failed_maps)
+    message(FATAL_ERROR "pathfind_bench: Failed on ${failed_maps}.")
+endif()
+message(STATUS "pathfind_bench: Results written to ${RESULT_DIR}")
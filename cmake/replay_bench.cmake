@@ -0,0 +1,65 @@
+# Script for the replay_bench target, run with cmake -P.
+#
+# Copies the replays and maps of a GeneralsReplays folder into the user data folder of the game, simulates the
+# replays headless and writes the results to RESULT_FILE. If BASELINE_FILE is set, the game compares the results
+# with it and the script fails on a regression.
+#
+# GAME_EXE        Game executable. The game data must be next to it.
+# REPLAY_DIR      Folder with the subfolders Replays and Maps.
+# USER_DATA_DIR   User data folder of the game.
+# RESULT_FILE     CSV file for the results.
+# BASELINE_FILE   Optional CSV file of an earlier run.
+# TOLERANCE       Optional regression in percent that the comparison tolerates.
+# JOBS            Optional number of worker processes. The timings are only comparable with the same number.
+# EXTRA_ARGS      Optional additional command line arguments of the game, for example -headlessClientEffects.
+
+foreach(var GAME_EXE REPLAY_DIR USER_DATA_DIR RESULT_FILE)
+    if(NOT ${var})
+        message(FATAL_ERROR "replay_bench: ${var} is not set.")
+    endif()
+endforeach()
+
+if(NOT EXISTS "${REPLAY_DIR}/Replays")
+    message(FATAL_ERROR "replay_bench: No replays in ${REPLAY_DIR}. Run \"git submodule update --init GeneralsReplays\" or set RTS_REPLAY_BENCH_DIR.")
+endif()
+
+# The game only finds replays and maps in the user data folder.
+set(bench_subfolder "ReplayBench")
+file(REMOVE_RECURSE "${USER_DATA_DIR}/Replays/${bench_subfolder}")
+file(COPY "${REPLAY_DIR}/Replays/" DESTINATION "${USER_DATA_DIR}/Replays/${bench_subfolder}")
+if(EXISTS "${REPLAY_DIR}/Maps")
+    file(COPY "${REPLAY_DIR}/Maps/" DESTINATION "${USER_DATA_DIR}/Maps")
+endif()
+
+set(bench_args -headless -replay "${bench_subfolder}/*.rep" -replayBench "${RESULT_FILE}")
+if(BASELINE_FILE)
+    list(APPEND bench_args -replayBenchBaseline "${BASELINE_FILE}")
+endif()
+if(TOLERANCE)
+    list(APPEND bench_args -replayBenchTolerance "${TOLERANCE}")
+endif()
+if(JOBS)
+    list(APPEND bench_args -jobs "${JOBS}")
+endif()
+if(EXTRA_ARGS)
+    separate_arguments(extra_args NATIVE_COMMAND "${EXTRA_ARGS}")
+    list(APPEND bench_args ${extra_args})
+endif()
+
+# The game is a gui application, so its console output must be captured.
+get_filename_component(game_dir "${GAME_EXE}" DIRECTORY)
+string(REPLACE ";" " " bench_args_text "${bench_args}")
+message(STATUS "Run ${GAME_EXE} ${bench_args_text}")
+execute_process(
+    COMMAND "${GAME_EXE}" ${bench_args}
+    WORKING_DIRECTORY "${game_dir}"
+    OUTPUT_VARIABLE bench_output
+    ERROR_VARIABLE bench_output
+    RESULT_VARIABLE bench_result
+)
+message("${bench_output}")
+
+if(NOT bench_result EQUAL 0)
+    message(FATAL_ERROR "replay_bench: Failed with exit code ${bench_result}.")
+endif()
+message(STATUS "replay_bench: Results written to ${RESULT_FILE}")